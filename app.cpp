@@ -1,6 +1,12 @@
 #include <signal.h>
+#include <poll.h>
+#include <unistd.h>
 #include <curses.h>
 
+#include <cstdint>
+#include <ctime>
+#include <sstream>
+
 #include "deps.hpp"
 #include "app.hpp"
 #include "uri.hpp"
@@ -14,6 +20,9 @@
 //
 // ========================================================================
 
+// --- protected static constants -----------------------------------------
+const string App::DOWNLOADS_URI = "w3m://downloads";
+
 // --- public constructors ------------------------------------------------
 App::App(void)
 {
@@ -41,6 +50,13 @@ App::App(void)
     m_baseCommandDispatcher["EXEC_SHELL"] = &App::exec_shell;
     m_baseCommandDispatcher["COMMAND"] = &App::command;
     m_baseCommandDispatcher["SOURCE_COMMANDS"] = &App::source_commands;
+    m_baseCommandDispatcher["ABORT"] = &App::abort_fetch;
+    m_baseCommandDispatcher["NAV_TIMING"] = &App::nav_timing;
+    m_baseCommandDispatcher["DOWNLOAD"] = &App::download;
+    m_baseCommandDispatcher["DOWNLOAD_LIST"] = &App::download_list;
+    m_baseCommandDispatcher["DOWNLOAD_PAUSE"] = &App::pause_downloads;
+    m_baseCommandDispatcher["DOWNLOAD_RESUME"] = &App::resume_downloads;
+    m_baseCommandDispatcher["DOWNLOAD_CANCEL"] = &App::cancel_downloads;
 
     for (const auto& kv : m_baseCommandDispatcher)
     {
@@ -118,6 +134,11 @@ auto App::run(const Config& config)
 
     // init debuggers
     m_debuggerMain = Debugger(config.debuggerMain);
+    m_cache = HttpCache(config.cache);
+    m_documentCache = DocumentCache(config.documentCache);
+    m_prefetcher = Prefetcher(config.prefetch);
+    m_scheduler = FetchScheduler(config.scheduler);
+    m_metrics = NavigationMetrics(config.metrics);
     Document::set_debugger_filename(config.debuggerMain.filename);
     Document::set_debugger_limit(config.debuggerMain.limitDefault);
 
@@ -149,6 +170,21 @@ auto App::run(const Config& config)
         m_uriHandlerMap.emplace(scheme, m_uriHandlers.begin());
     }// end for
 
+    // persistent handlers take precedence
+    for (const auto& kv : m_config.uriCoprocesses)
+    {
+        const auto&     scheme          = kv.first;
+        const auto&     shellCommand    = kv.second;
+
+        m_uriHandlers.emplace_front(
+            shellCommand,
+            "W3M_URL",
+            HttpFetcher::env_map(),
+            HttpFetcher::Mode::coprocess
+        );
+        m_uriHandlerMap[scheme] = m_uriHandlers.begin();
+    }// end for
+
     // init colors
     init_pair(
         Viewer::COLOR_PAIR_STANDARD,
@@ -194,6 +230,29 @@ auto App::run(const Config& config)
     // goto init url
     {
         goto_url(m_config.initUrl);
+
+        // wait for the first page (or the first part of it), so the tab has
+        // something to display
+        while (find_navigation(curr_tab()) and (not m_currTab->curr_page()))
+        {
+            if (CTRL('c') == wait_for_key())
+            {
+                abort_fetch({ "ABORT" });
+            }
+        }// end while
+
+        if (not m_currTab->curr_page())
+        {
+            curs_set(0);
+            waddnstr(stdscr, "ERROR: could not load initial url", COLS);
+            wrefresh(stdscr);
+
+            sleep(3);
+            curs_set(1);
+
+            return EXIT_FAILURE;
+        }
+
         m_currPage = m_currTab->curr_page();
     }
 
@@ -203,7 +262,7 @@ auto App::run(const Config& config)
         size_t                      w3mIndex        = 0;
 
         // read index
-        while ((key = wgetch(stdscr)))
+        while ((key = wait_for_key()))
         {
             bool        increm      = false;
 
@@ -354,6 +413,17 @@ auto App::run(const Config& config)
             case 'T':
                 new_tab({ "NEW_TAB" });
                 break;
+            // open link in background tab
+            case 't':
+                {
+                    const string&   url     = curr_page().viewer().curr_url();
+
+                    if (not url.empty())
+                    {
+                        new_tab({ "NEW_TAB", url });
+                    }
+                }
+                break;
             case CTRL('q'):
                 delete_tab({ "DELETE_TAB" });
                 break;
@@ -460,6 +530,22 @@ auto App::run(const Config& config)
                     }
                 }
                 break;
+            // save link under cursor in the background
+            case 'a':
+                download({ "DOWNLOAD" });
+                break;
+            // show downloads
+            case 'A':
+                download_list({ "DOWNLOAD_LIST" });
+                break;
+            // show prefetch hit rate
+            case CTRL('p'):
+                disp_prefetch_stats();
+                break;
+            // show where the time went in the last navigation
+            case CTRL('t'):
+                nav_timing({ "NAV_TIMING" });
+                break;
             // show current line number
             case CTRL('g'):
                 {
@@ -506,6 +592,9 @@ auto App::run(const Config& config)
             case CTRL('z'):
                 suspend({});
                 break;
+            case CTRL('c'):
+                abort_fetch({ "ABORT" });
+                break;
             case 'q':
                 {
                     switch (curr_page().viewer().prompt_char(
@@ -644,9 +733,9 @@ void App::redraw(bool retouch)
     wrefresh(stdscr);
 }// end App::redraw
 
-// Updates app's state to go to a given url, given a container containing the
-// data fetched from or associated with the given url. Does not fetch the data
-// itself; that is the responsibility of the calling function.
+// Updates app's state to go to a given url. Fragment urls are resolved
+// immediately; anything else is fetched in the background on behalf of the
+// current tab (see App::start_navigation).
 //
 // param targetUrl: url (in string form) to go to
 // param requestMethod: http method to use (GET/POST/PUT/DELETE/etc)
@@ -678,199 +767,1375 @@ void    App::goto_url(
     }
     else if (not targetUrl.empty())
     {
-        static const string                         defContentType
-            = "text/plain";
-        static const HttpFetcher::data_container    nullData
-            = {};
+        start_navigation(curr_tab(), targetUrl, requestMethod, input);
+    }
+}// end goto_url
+
+// Begins fetching a url in the background for a given tab. Any fetch
+// already running for that tab is aborted. The key loop drives the fetch
+// forward (see App::update_navigations); once it completes, the resulting
+// page is pushed onto the tab.
+//
+// param tab: tab to load the page into
+// param targetUrl: url to fetch, possibly relative to the tab's current page
+// param requestMethod: http method to use (GET/POST/PUT/DELETE/etc)
+// param input: request body
+// param priority: scheduling class of the navigation's requests
+void    App::start_navigation(
+    Tab& tab,
+    const Uri& targetUrl,
+    const string& requestMethod,
+    const HttpFetcher::data_container& input,
+    FetchScheduler::Priority priority
+)
+{
+    Navigation      nav     = {};
+
+    cancel_navigations(tab);
+
+    nav.tab = &tab;
+    nav.started = NavigationMetrics::clock_type::now();
+    nav.priority = priority;
+    nav.requestMethod = requestMethod;
+    nav.fetchEnv["W3M_REQUEST_METHOD"] = requestMethod;
+
+    if (tab.curr_page())
+    {
+        nav.prevUri = tab.curr_page()->uri();
+    }
 
-        HttpFetcher::Status                 status              = {};
-        HttpFetcher::header_type            headers             = {};
-        std::vector<char>                   data                = {};
-        std::map<string,string>             fetchEnv            = {};
-        Uri                                 target              = targetUrl;
-        const HttpFetcher::data_container   *inData             = &input;
-        Uri                                 prevUri             = {};
-        Uri                                 fullUri;
-        const string                        *contentType        = nullptr;
-        s_ptr<Document>                     doc                 = nullptr;
-        unordered_set<string>               visitedUris         = {};
+    if ((not start_hop(nav, targetUrl, input)) or nav.document)
+    {
+        finish_navigation(nav);
+        return;
+    }
 
-        fetchEnv["W3M_REQUEST_METHOD"] = requestMethod;
+    m_navigations.push_back(std::move(nav));
+    m_lastProgressBytes = SIZE_MAX;
 
-        if (curr_tab().curr_page())
+    // keep showing the current page while the new one loads
+    if (&tab == &curr_tab())
+    {
+        if (tab.curr_page())
         {
-            prevUri = curr_page().uri();
+            redraw(true);
         }
+        disp_progress(m_navigations.back());
+    }
+}// end App::start_navigation
 
-        do
-        {
-            HttpFetcher     *fetcher        = nullptr;
+// Starts fetching the next hop of a navigation (the initial request, or the
+// target of a redirect).
+//
+// param nav: navigation to advance
+// param target: url to fetch, relative to the previous hop
+// param input: request body
+// return: true if a fetch was submitted (or the response was found in the
+//  cache); false if the url was already visited or no handler is configured
+//  for its scheme
+auto    App::start_hop(
+    Navigation& nav,
+    const Uri& target,
+    const HttpFetcher::data_container& input
+) -> bool
+{
+    HttpFetcher     *fetcher        = nullptr;
+    const Uri       fullUri         = Uri::from_relative(nav.prevUri, target);
 
-            status = {};
-            headers.clear();
+    m_debuggerMain.printf(
+        3,
+        "%s: directed to \"%s\"",
+        m_debuggerMain.format_curr_time().c_str(),
+        fullUri.str().c_str()
+    );
 
-            fullUri = Uri::from_relative(prevUri, target);
+    if (nav.visitedUris.count(fullUri.str()))
+    {
+        return false;
+    }
 
-            m_debuggerMain.printf(
-                3,
-                "%s: directed to \"%s\"",
-                m_debuggerMain.format_curr_time().c_str(),
-                fullUri.str().c_str()
-            );
+    if (not (fetcher = get_uri_handler(fullUri.scheme)))
+    {
+        return false;
+    }
 
-            if (visitedUris.count(fullUri.str()))
-            {
-                break;
-            }
+    nav.visitedUris.insert(fullUri.str());
+    nav.fullUri = fullUri;
+    nav.hopStarted = NavigationMetrics::clock_type::now();
+    nav.source = "network";
+    nav.cacheable = input.empty()
+        and ("GET" == nav.fetchEnv["W3M_REQUEST_METHOD"]);
+    nav.cached = nullptr;
+    nav.parse = nullptr;
+    nav.fetchEnv.erase("W3M_IF_NONE_MATCH");
+    nav.fetchEnv.erase("W3M_IF_MODIFIED_SINCE");
+
+    // already laid out in memory; nothing to fetch
+    if (
+        nav.cacheable
+        and (nav.document = m_documentCache.find(fullUri, COLS, time(nullptr)))
+    )
+    {
+        m_debuggerMain.printf(
+            3,
+            "%s: showing \"%s\" from memory",
+            m_debuggerMain.format_curr_time().c_str(),
+            fullUri.str().c_str()
+        );
+        nav.job = nullptr;
+        nav.source = "memory";
+        return true;
+    }
 
-            if (not (fetcher = get_uri_handler(fullUri.scheme)))
-            {
-                break;
-            }
+    // already being fetched speculatively
+    if (
+        nav.cacheable and m_prefetcher.enabled()
+        and (nav.job = m_prefetcher.take(fullUri))
+    )
+    {
+        m_debuggerMain.printf(
+            3,
+            "%s: using prefetch of \"%s\"",
+            m_debuggerMain.format_curr_time().c_str(),
+            fullUri.str().c_str()
+        );
+        m_scheduler.promote(nav.job, nav.priority);
+        nav.source = "prefetch";
+        return true;
+    }
 
-            visitedUris.insert(fullUri.str());
+    if (nav.cacheable and m_cache.enabled())
+    {
+        u_ptr<HttpCache::Entry>     entry(new HttpCache::Entry());
 
-            try
-            {
-                data = fetcher->fetch_url(
-                    status, headers, fullUri, *inData, fetchEnv
-                );
-            }
-            catch (const StringException& e)
-            {
-                m_debuggerMain.printf(
-                    1,
-                    "%s: could not fetch %s; %s",
-                    m_debuggerMain.format_curr_time().c_str(),
-                    fullUri.str().c_str(),
-                    ((string)(e)).c_str()
-                );
-                throw e;
-            }
-            catch (const std::exception& e)
+        if (m_cache.lookup(fullUri, *entry))
+        {
+            if (HttpCache::is_fresh(*entry, time(nullptr)))
             {
                 m_debuggerMain.printf(
-                    1,
-                    "%s: could not fetch %s",
+                    3,
+                    "%s: serving \"%s\" from cache",
                     m_debuggerMain.format_curr_time().c_str(),
                     fullUri.str().c_str()
                 );
-                throw e;
+                nav.job = FetchScheduler::adopt(
+                    HttpFetcher::Transfer::completed(
+                        fullUri,
+                        entry->status,
+                        entry->headers,
+                        entry->body
+                    )
+                );
+                nav.source = "cache";
+                return true;
             }
 
-            fetchEnv["W3M_REQUEST_METHOD"] = "GET";
-            inData = &nullData;
-            prevUri = fullUri;
+            // stale; fetch only if changed
+            for (const auto& kv : HttpCache::revalidation_env(*entry))
+            {
+                nav.fetchEnv[kv.first] = kv.second;
+            }// end for kv
+            nav.cached = std::move(entry);
+        }
+    }
 
-            m_debuggerMain.printf(
-                3,
-                "%s: received status %d",
-                m_debuggerMain.format_curr_time().c_str(),
-                status.code
-            );
+    nav.job = m_scheduler.submit(
+        nav.priority,
+        *fetcher,
+        fullUri,
+        input,
+        nav.fetchEnv
+    );
 
-            if (headers.count("location")
-                and (not headers.at("location").empty())
-            )
-            {
-                target = headers.at("location").at(0);
-            }
-        } while (
-            (status.code >= 300)
-            and (status.code < 400)
-            and headers.count("location")
-        );// end do while
+    return true;
+}// end App::start_hop
 
-        if (
-            headers.count("content-type")
-            and (not headers.at("content-type").empty())
-        )
-        {
-            contentType = &headers.at("content-type").front();
-        }
+// Builds a document from a completed navigation's response and pushes it
+// onto the navigation's tab (or, if part of it was already rendered,
+// replaces the provisional page's document). Content types that can't be
+// displayed are passed to the mailcap handlers instead.
+//
+// param nav: navigation whose final response has been read
+void    App::finish_navigation(Navigation& nav)
+{
+    using namespace std;
 
-        // create document, if applicable
-        if (not contentType)
+    static const HttpFetcher::header_type       nullHeaders     = {};
+
+    Tab&                                tab             = *nav.tab;
+    const bool                          isCurrTab       = (&tab == &curr_tab());
+    HttpFetcher::Transfer               *transfer       = nav.job ?
+                                                    nav.job->transfer.get() :
+                                                    nullptr;
+    const HttpFetcher::header_type&     headers         = transfer ?
+                                                        transfer->headers() :
+                                                        nullHeaders;
+    ByteBuffer                          data            = {};
+    const Uri&                          fullUri         = nav.fullUri;
+    const string                        contentType(headers.content_type());
+    s_ptr<Document>                     doc             = nullptr;
+    NavigationMetrics::clock_type::duration
+                                        paintTime       = {};
+
+    if (transfer)
+    {
+        m_debuggerMain.printf(
+            3,
+            "%s: received status %d",
+            m_debuggerMain.format_curr_time().c_str(),
+            transfer->status().code
+        );
+        // the body is shared from here on, by the document and any handler
+        data = transfer->release_body();
+    }
+
+    // create document, if applicable
+    if (nav.document)
+    {
+        doc = nav.document;
+    }
+    else if (contentType.empty())
+    {
+        m_debuggerMain.printf(
+            1,
+            "%s: ERROR: content-type not provided",
+            m_debuggerMain.format_curr_time().c_str()
+        );
+        if (isCurrTab and tab.curr_page())
         {
-            m_debuggerMain.printf(
-                1,
-                "%s: ERROR: content-type not provided",
-                m_debuggerMain.format_curr_time().c_str()
-            );
-            curr_page().viewer().refresh(true);
-            curr_page().viewer().disp_status(
+            tab.curr_page()->viewer().refresh(true);
+            tab.curr_page()->viewer().disp_status(
                 "ERROR: could not identify content type"
             );
-            goto finally;
         }
-        else
+        goto finally;
+    }
+    else
+    {
+        try
         {
-            try
-            {
-                if (*contentType == "text/plain")
-                {
-                    doc.reset(new DocumentText(
-                        m_config.document,
-                        string(data.cbegin(), data.cend()),
-                        COLS
-                    ));
-                }
-                else if (*contentType == "text/html")
-                {
-                    doc.reset(new DocumentHtml(
-                        m_config.document,
-                        string(data.cbegin(), data.cend()),
-                        COLS
-                    ));
-                }
-            }
-            catch (const StringException& e)
+            // most of it parsed already, as it arrived
+            if (transfer and nav.parse and nav.parse->parser)
             {
-                m_debuggerMain.printf(
-                    1,
-                    "%s: could not parse document for \"%s\": %s",
-                    m_debuggerMain.format_curr_time().c_str(),
-                    fullUri.str().c_str(),
-                    ((string)(e)).c_str()
+                PageParse&      parse       = *nav.parse;
+                const auto      start       = std::chrono::steady_clock::now();
+
+                parse.parser->feed(
+                    data.begin() + parse.bytes,
+                    data.size() - parse.bytes
                 );
-                throw e;
+                parse.parser->finish();
+                parse.time += std::chrono::steady_clock::now() - start;
+
+                doc = s_ptr<Document>(new DocumentHtml(
+                    m_config.document,
+                    data,
+                    std::move(parse.dom),
+                    parse.time,
+                    COLS
+                ));
             }
-            catch (const std::exception& e)
+            else
             {
-                m_debuggerMain.printf(
-                    1,
-                    "%s: could not parse document for \"%s\"",
-                    m_debuggerMain.format_curr_time().c_str(),
-                    fullUri.str().c_str()
-                );
-                throw e;
+                doc = make_document(contentType, data);
             }
         }
+        catch (const StringException& e)
+        {
+            m_debuggerMain.printf(
+                1,
+                "%s: could not parse document for \"%s\": %s",
+                m_debuggerMain.format_curr_time().c_str(),
+                fullUri.str().c_str(),
+                ((string)(e)).c_str()
+            );
+            throw e;
+        }
+        catch (const std::exception& e)
+        {
+            m_debuggerMain.printf(
+                1,
+                "%s: could not parse document for \"%s\"",
+                m_debuggerMain.format_curr_time().c_str(),
+                fullUri.str().c_str()
+            );
+            throw e;
+        }
+    }
+
+    // keep complete pages for reuse
+    if (
+        doc and (doc != nav.document) and nav.cacheable and transfer
+        and (HttpFetcher::Transfer::State::done == transfer->state())
+        and (200 == transfer->status().code)
+    )
+    {
+        m_documentCache.insert(fullUri, COLS, doc, data.size(), headers);
+    }
+
+    if (doc and nav.page)
+    {
+        nav.page->set_document(doc);
+    }
+    else if (doc)
+    {
+        tab.push_document(doc, fullUri);
+    }
+    else if (nav.feed)
+    {
+        finish_feed(nav);
+    }
+    else
+    {
+        handle_data(contentType, data);
+    }
+finally:
+    if (isCurrTab and tab.curr_page())
+    {
+        const auto      paintStart  = NavigationMetrics::clock_type::now();
+
+        m_currPage = tab.curr_page();
+        m_debuggerMain.printf(
+            3,
+            "%s: redrawing document for \"%s\"",
+            m_debuggerMain.format_curr_time().c_str(),
+            fullUri.str().c_str()
+        );
+        redraw(true);
+        paintTime = NavigationMetrics::clock_type::now() - paintStart;
+        m_debuggerMain.printf(
+            3,
+            "%s: finished redrawing document for \"%s\"",
+            m_debuggerMain.format_curr_time().c_str(),
+            fullUri.str().c_str()
+        );
+    }
+
+    // a document from memory wasn't built by this navigation
+    record_metrics(
+        nav,
+        (doc != nav.document) ? doc.get() : nullptr,
+        data.size(),
+        paintTime
+    );
+}// end App::finish_navigation
+
+// Records where the time went in a navigation that has finished (see
+// NavigationMetrics).
+//
+// param nav: the navigation
+// param doc: the document it built, if any
+// param bytes: size of the response body
+// param paintTime: time taken to draw the page on screen, if it was drawn
+void    App::record_metrics(
+    const Navigation& nav,
+    const Document *doc,
+    size_t bytes,
+    NavigationMetrics::clock_type::duration paintTime
+)
+{
+    typedef NavigationMetrics       Metrics;
+
+    const auto              now         = Metrics::clock_type::now();
+    const auto              *transfer   = nav.job ? nav.job->transfer.get()
+                                            : nullptr;
+    Metrics::Record         rec         = {};
+
+    rec.time = time(nullptr);
+    rec.url = nav.fullUri.str();
+    rec.source = nav.source;
+    rec.redirects = nav.redirects;
+    rec.bytes = bytes;
+    rec.redirectMs = Metrics::elapsed_ms(nav.started, nav.hopStarted);
+
+    if (transfer)
+    {
+        const auto&     timing      = transfer->timing();
+
+        rec.status = transfer->status().code;
+        rec.wireBytes = transfer->bytes_received();
+        rec.queueMs = Metrics::elapsed_ms(nav.hopStarted, timing.started);
+        rec.spawnMs = Metrics::elapsed_ms(timing.started, timing.spawned);
+        rec.ttfbMs = Metrics::elapsed_ms(timing.spawned, timing.firstByte);
+        rec.transferMs = Metrics::elapsed_ms(
+            timing.firstByte,
+            timing.finished
+        );
+    }
+
+    if (doc)
+    {
+        rec.nodes = doc->stats().nodes;
+        rec.lines = doc->buffer().size();
+        rec.parseMs = Metrics::to_ms(doc->stats().parseTime);
+        rec.layoutMs = Metrics::to_ms(doc->stats().layoutTime);
+    }
+
+    rec.paintMs = Metrics::to_ms(paintTime);
+    rec.totalMs = Metrics::elapsed_ms(nav.started, now);
+
+    m_debuggerMain.printf(
+        3,
+        "%s: timing for \"%s\": %s",
+        m_debuggerMain.format_curr_time().c_str(),
+        rec.url.c_str(),
+        Metrics::format(rec).c_str()
+    );
+
+    if (not m_metrics.add(rec))
+    {
+        m_debuggerMain.printf(
+            1,
+            "%s: ERROR: could not write metrics to \"%s\"",
+            m_debuggerMain.format_curr_time().c_str(),
+            m_metrics.config().filename.c_str()
+        );
+    }
+}// end App::record_metrics
+
+// Lays out whatever part of a navigation's body has arrived so far and
+// shows it in the navigation's provisional page, creating the page on the
+// first call. The next render happens once the body has doubled in size,
+// so the total cost of re-rendering stays proportional to the page size.
+// An html body being parsed as it arrives (see App::update_parse) isn't
+// parsed again: the tree built so far is laid out, once elements have been
+// closed since the last render.
+//
+// param nav: navigation whose body is still arriving
+void    App::render_partial(Navigation& nav)
+{
+    const auto&         headers         = nav.job->transfer->headers();
+    const auto&         body            = nav.job->transfer->body();
+    PageParse           *parse          = (nav.parse and nav.parse->parser)
+                                            ? nav.parse.get() : nullptr;
+    s_ptr<Document>     doc             = nullptr;
+
+    // nothing new to show until another element is complete
+    if (parse and (parse->closed == parse->rendered))
+    {
+        return;
+    }
+
+    nav.renderSize = std::max(nav.renderSize, body.size()) * 2;
+
+    if (headers.content_type().empty())
+    {
+        nav.renderSize = SIZE_MAX;
+        return;
+    }
+
+    if (parse)
+    {
+        // the tree is still being added to; lay out a copy of it
+        parse->rendered = parse->closed;
+        doc = s_ptr<Document>(new DocumentHtml(
+            m_config.document,
+            ByteBuffer(body),
+            parse->dom,
+            parse->time,
+            COLS
+        ));
+    }
+    else
+    {
+        // a truncated document may not parse; just wait for more data
+        try
+        {
+            doc = make_document(
+                string(headers.content_type()),
+                ByteBuffer(body)
+            );
+        }
+        catch (const StringException& e)
+        {
+            m_debuggerMain.printf(
+                2,
+                "%s: could not parse partial document for \"%s\" (%lu bytes): %s",
+                m_debuggerMain.format_curr_time().c_str(),
+                nav.fullUri.str().c_str(),
+                body.size(),
+                ((string)(e)).c_str()
+            );
+            return;
+        }
+        catch (const std::exception& e)
+        {
+            m_debuggerMain.printf(
+                2,
+                "%s: could not parse partial document for \"%s\" (%lu bytes)",
+                m_debuggerMain.format_curr_time().c_str(),
+                nav.fullUri.str().c_str(),
+                body.size()
+            );
+            return;
+        }
+    }
+
+    if (not doc)
+    {
+        // not displayable; handled by mailcap once complete
+        nav.renderSize = SIZE_MAX;
+        return;
+    }
+    else if (doc->buffer().empty())
+    {
+        return;
+    }
+
+    if (nav.page)
+    {
+        nav.page->set_document(doc);
+    }
+    else
+    {
+        nav.page = nav.tab->push_document(doc, nav.fullUri);
+    }
+
+    if ((nav.tab == &curr_tab()) and (nav.tab->curr_page() == nav.page))
+    {
+        m_currPage = nav.page;
+        redraw(true);
+        m_lastProgressBytes = SIZE_MAX;
+    }
+}// end App::render_partial
+
+// Feeds the part of a navigation's body that has arrived since the last
+// call to the parser building its page, starting one once the headers
+// show that the body is html (see App::PageParse). A body that doesn't
+// parse is left for finish_navigation to report.
+//
+// param nav: navigation whose body is arriving
+void    App::update_parse(Navigation& nav)
+{
+    const auto&     transfer    = *nav.job->transfer;
+    const auto&     body        = transfer.body();
+
+    if ((not nav.parse) and ("text/html" == transfer.headers().content_type()))
+    {
+        PageParse&      parse       = *(nav.parse = u_ptr<PageParse>(
+                                        new PageParse()
+                                    ));
+
+        parse.parser.reset(new HtmlPushParser(
+            *parse.dom.reset_root("window"),
+            HtmlParserBasic::DEFAULT_MAX_DEPTH,
+            [&parse](const DomTree::node&) { ++parse.closed; }
+        ));
+    }
+
+    if (
+        (not nav.parse) or (not nav.parse->parser)
+        or (nav.parse->bytes == body.size())
+    )
+    {
+        return;
+    }
+
+    {
+        PageParse&      parse       = *nav.parse;
+        const auto      start       = std::chrono::steady_clock::now();
+
+        try
+        {
+            parse.parser->feed(
+                body.data() + parse.bytes,
+                body.size() - parse.bytes
+            );
+        }
+        catch (const std::exception& e)
+        {
+            m_debuggerMain.printf(
+                2,
+                "%s: could not parse partial document for \"%s\" (%lu bytes)",
+                m_debuggerMain.format_curr_time().c_str(),
+                nav.fullUri.str().c_str(),
+                body.size()
+            );
+            parse.parser = nullptr;
+            return;
+        }
+        parse.time += std::chrono::steady_clock::now() - start;
+        parse.bytes = body.size();
+    }
+}// end App::update_parse
+
+// param contentType: mime type of the data
+// param data: document source; shared with the document, not copied
+// return: document laid out to the screen width, or nullptr if the content
+//  type can't be displayed
+auto    App::make_document(
+    const string& contentType,
+    const ByteBuffer& data
+) -> s_ptr<Document>
+{
+    if (contentType == "text/plain")
+    {
+        return s_ptr<Document>(new DocumentText(
+            m_config.document,
+            data,
+            COLS
+        ));
+    }
+    else if (contentType == "text/html")
+    {
+        return s_ptr<Document>(new DocumentHtml(
+            m_config.document,
+            data,
+            COLS
+        ));
+    }
+
+    return nullptr;
+}// end App::make_document
+
+// An abandoned feed (i.e. an aborted navigation) closes its handler's
+// stdin, so that the handler sees the end of its input.
+App::HandlerFeed::~HandlerFeed(void)
+{
+    if (handler and handler->stdin_piped() and (not handler->stdin().eof()))
+    {
+        handler->stdin().close();
+    }
+}// end App::HandlerFeed::~HandlerFeed
+
+// param contentType: mime type
+// return: true if make_document can lay out content of the given type
+auto    App::can_display(const string& contentType) const
+    -> bool
+{
+    return (contentType == "text/plain") or (contentType == "text/html");
+}// end App::can_display
+
+// Starts streaming the body of a navigation to its mailcap handler, if its
+// content can't be displayed but can be handled. Handlers that read their
+// stdin are started at once; others get a temp file, written as the body
+// arrives. Streamed bodies aren't cached.
+//
+// param nav: navigation whose response headers have arrived
+// return: true if the body is now streamed through nav.feed
+auto    App::start_feed(Navigation& nav)
+    -> bool
+{
+    const auto&             headers     = nav.job->transfer->headers();
+    u_ptr<HandlerFeed>      feed(new HandlerFeed());
+
+    if (
+        nav.document
+        or (nav.cached and (304 == nav.job->transfer->status().code))
+        or headers.content_type().empty()
+        or can_display(string(headers.content_type()))
+    )
+    {
+        return false;
+    }
+
+    feed->mimeType = headers.content_type();
+    if (not (feed->entry = find_mailcap_entry(feed->mimeType)))
+    {
+        return false;
+    }
+
+    if (feed->entry->file_piped())
+    {
+        feed->fileBase = next_temp_base();
+        feed->handler.reset(new Command::Subprocess(
+            spawn_handler(*feed->entry, feed->fileBase, feed->mimeType)
+        ));
+    }
+    else
+    {
+        feed->tempFile = open_temp_file(*feed->entry, feed->fileBase);
+        if (not feed->tempFile.is_open())
+        {
+            return false;
+        }
+
+        // the transfer writes the body to the file itself
+        nav.job->transfer->set_sink(feed->tempFile.fd());
+    }
+
+    m_debuggerMain.printf(
+        3,
+        "%s: streaming \"%s\" (%s) to its handler",
+        m_debuggerMain.format_curr_time().c_str(),
+        nav.fullUri.str().c_str(),
+        feed->mimeType.c_str()
+    );
+
+    nav.cacheable = false;
+    nav.feed = std::move(feed);
+
+    return true;
+}// end App::start_feed
+
+// Moves whatever has arrived of a streamed body on to its handler or temp
+// file. The transfer isn't read while the handler has input left to take.
+// A handler that exits early cancels the transfer.
+//
+// param nav: navigation with a feed
+// param block: wait until the transfer is done, rather than returning as
+//  soon as nothing more can be done without waiting
+// return: true once the whole body has been handed over
+auto    App::update_feed(Navigation& nav, bool block)
+    -> bool
+{
+    HandlerFeed&                feed        = *nav.feed;
+    HttpFetcher::Transfer&      transfer    = *nav.job->transfer;
+
+    while (true)
+    {
+        std::vector<struct pollfd>  fds     = {};
+
+        // take in what has arrived, once the last of it has been taken; a
+        // temp file is written by the transfer itself (see start_feed)
+        if (feed.pendingPos == feed.pending.size())
+        {
+            transfer.update();
+            feed.pending = transfer.release_body();
+            feed.pendingPos = 0;
+        }
+
+        while (feed.handler and (feed.pendingPos < feed.pending.size()))
+        {
+            const ssize_t   nWritten    = feed.handler->write_stdin(
+                                            feed.pending.data()
+                                                + feed.pendingPos,
+                                            feed.pending.size()
+                                                - feed.pendingPos
+                                        );
+
+            if (nWritten < 0)
+            {
+                // the handler wants no more
+                transfer.cancel();
+                feed.pendingPos = feed.pending.size();
+            }
+            else if (0 == nWritten)
+            {
+                break;
+            }
+            else
+            {
+                feed.pendingPos += nWritten;
+            }
+        }// end while
+
+        if (transfer.finished() and (feed.pendingPos == feed.pending.size()))
+        {
+            return true;
+        }
+        else if (not block)
+        {
+            return false;
+        }
+
+        get_feed_pollfds(nav, fds);
+        poll(fds.data(), fds.size(), -1);
+    }// end while
+}// end App::update_feed
+
+// Adds the descriptors a feed is waiting on: the handler's stdin while it
+// has input left to take, the transfer's otherwise.
+//
+// param nav: navigation with a feed
+// param fds: container to add to
+void    App::get_feed_pollfds(
+    const Navigation& nav,
+    std::vector<struct pollfd>& fds
+) const
+{
+    const HandlerFeed&              feed        = *nav.feed;
+    const HttpFetcher::Transfer&    transfer    = *nav.job->transfer;
+
+    if (feed.pendingPos < feed.pending.size())
+    {
+        fds.push_back({ feed.handler->stdin().fd(), POLLOUT, 0 });
+        return;
+    }
+
+    fds.push_back({ transfer.fd(), POLLIN, 0 });
+    if (transfer.write_fd() >= 0)
+    {
+        fds.push_back({ transfer.write_fd(), POLLOUT, 0 });
+    }
+}// end App::get_feed_pollfds
+
+// Completes a feed once its body has been handed over: closes the
+// handler's stdin, or starts the handler on the finished temp file.
+//
+// param nav: navigation with a feed
+void    App::finish_feed(Navigation& nav)
+{
+    HandlerFeed&        feed        = *nav.feed;
+
+    if (not feed.handler)
+    {
+        start_handler_on(
+            *feed.entry,
+            std::move(feed.tempFile),
+            feed.fileBase,
+            feed.mimeType
+        );
+        return;
+    }
+
+    feed.handler->stdin().close();
+    adopt_handler(*feed.entry, std::move(feed.handler));
+}// end App::finish_feed
+
+// Reads any pending output from running navigations without blocking.
+// Redirects are followed as their responses complete; finished navigations
+// are turned into pages (see App::finish_navigation) and discarded.
+// Navigations still waiting on the scheduler are promoted to the
+// foreground class once their tab is shown.
+void    App::update_navigations(void)
+{
+    auto        iter        = m_navigations.begin();
+
+    while (iter != m_navigations.end())
+    {
+        Navigation&     nav         = *iter;
+        bool            redirect;
+
+        // a provisional page closed by the user abandons its navigation
+        if (nav.page and (not nav.tab->has_page(nav.page)))
+        {
+            iter = m_navigations.erase(iter);
+            continue;
+        }
+
+        if (not nav.job->error.empty())
+        {
+            m_debuggerMain.printf(
+                1,
+                "%s: could not fetch %s; %s",
+                m_debuggerMain.format_curr_time().c_str(),
+                nav.fullUri.str().c_str(),
+                nav.job->error.c_str()
+            );
+            if ((nav.tab == &curr_tab()) and nav.tab->curr_page())
+            {
+                nav.tab->curr_page()->viewer().disp_status(
+                    "ERROR: could not fetch " + nav.fullUri.str()
+                );
+            }
+            iter = m_navigations.erase(iter);
+            continue;
+        }
+
+        if (not nav.job->started())
+        {
+            if (nav.tab == &curr_tab())
+            {
+                nav.priority = FetchScheduler::Priority::navigation;
+                m_scheduler.promote(nav.job, nav.priority);
+                disp_progress(nav);
+            }
+            ++iter;
+            continue;
+        }
+
+        // a feed reads its transfer at the pace of its handler
+        if (not nav.feed)
+        {
+            nav.job->transfer->update();
+        }
+
+        {
+            const auto&     status      = nav.job->transfer->status();
+            const auto&     headers     = nav.job->transfer->headers();
+
+            redirect = (status.code >= 300)
+                and (status.code < 400)
+                and (not headers.location().empty());
+        }
+
+        // content for a mailcap handler goes to it as it arrives; one that
+        // takes over the terminal is fed until the transfer is done
+        if (
+            nav.feed or (
+                nav.job->transfer->headers_ready()
+                and (not redirect)
+                and start_feed(nav)
+            )
+        )
+        {
+            const bool      foreground  = nav.feed->handler
+                                        and nav.feed->entry->needs_terminal();
+
+            if (not update_feed(nav, foreground))
+            {
+                if (nav.tab == &curr_tab())
+                {
+                    disp_progress(nav);
+                }
+                ++iter;
+                continue;
+            }
+        }
+        else if (not nav.job->transfer->finished())
+        {
+            if (nav.job->transfer->headers_ready() and (not redirect))
+            {
+                update_parse(nav);
+                if (nav.job->transfer->body().size() >= nav.renderSize)
+                {
+                    render_partial(nav);
+                }
+            }
+            if (nav.tab == &curr_tab())
+            {
+                disp_progress(nav);
+            }
+            ++iter;
+            continue;
+        }
+
+        // substitute a revalidated cache entry, or cache the response
+        if (nav.cached and (304 == nav.job->transfer->status().code))
+        {
+            m_debuggerMain.printf(
+                3,
+                "%s: cached \"%s\" not modified",
+                m_debuggerMain.format_curr_time().c_str(),
+                nav.fullUri.str().c_str()
+            );
+            m_cache.refresh(
+                nav.fullUri,
+                *nav.cached,
+                nav.job->transfer->headers()
+            );
+            nav.job->transfer = HttpFetcher::Transfer::completed(
+                nav.fullUri,
+                nav.cached->status,
+                nav.cached->headers,
+                nav.cached->body
+            );
+            nav.cached = nullptr;
+            nav.parse = nullptr;
+            nav.source = "revalidated";
+            redirect = false;
+        }
+        else if (
+            nav.cacheable and (
+                HttpFetcher::Transfer::State::done
+                == nav.job->transfer->state()
+            )
+        )
+        {
+            m_cache.store(
+                nav.fullUri,
+                nav.job->transfer->status(),
+                nav.job->transfer->headers(),
+                nav.job->transfer->body()
+            );
+        }
+
+        // follow redirect, if applicable
+        if (redirect)
+        {
+            const Uri       target      = string(
+                                            nav.job->transfer->headers()
+                                                .location()
+                                        );
+
+            nav.fetchEnv["W3M_REQUEST_METHOD"] = "GET";
+            nav.prevUri = nav.fullUri;
+            ++nav.redirects;
+
+            if (start_hop(nav, target, {}) and (not nav.document))
+            {
+                ++iter;
+                continue;
+            }
+        }
+
+        finish_navigation(nav);
+        iter = m_navigations.erase(iter);
+    }// end while
+}// end App::update_navigations
+
+// Aborts any navigation running on behalf of a given tab, killing its
+// handler process.
+//
+// param tab: tab whose navigation to abort
+void    App::cancel_navigations(const Tab& tab)
+{
+    m_navigations.remove_if([&tab](const Navigation& nav)
+    {
+        return nav.tab == &tab;
+    });
+}// end App::cancel_navigations
+
+// param tab: tab to search for
+// return: pointer to the navigation running for the tab, or nullptr if none
+auto    App::find_navigation(const Tab& tab)
+    -> Navigation*
+{
+    for (auto& nav : m_navigations)
+    {
+        if (nav.tab == &tab)
+        {
+            return &nav;
+        }
+    }// end for nav
+
+    return nullptr;
+}// end App::find_navigation
+
+// Shows the progress of a navigation (url, status code and bytes received)
+// in the status line, or that it is still waiting for the scheduler.
+//
+// param nav: navigation to report
+void    App::disp_progress(const Navigation& nav)
+{
+    std::stringstream   fmt;
+    const auto&         transfer    = nav.job->transfer;
+    const size_t        nBytes      = nav.job->bytes_received();
+
+    if (nBytes == m_lastProgressBytes)
+    {
+        return;
+    }
+
+    m_lastProgressBytes = nBytes;
+
+    if (not transfer)
+    {
+        fmt << "[queued] " << nav.fullUri.str() << " [^C: abort]";
+    }
+    else
+    {
+        fmt << "[fetching] " << nav.fullUri.str();
+        if (transfer->headers_ready())
+        {
+            fmt << " (" << transfer->status().code << ")";
+        }
+        fmt << ": " << nBytes << " bytes [^C: abort]";
+    }
+
+    if (nav.tab->curr_page())
+    {
+        nav.tab->curr_page()->viewer().disp_status(fmt.str());
+    }
+    else
+    {
+        mvwaddnstr(
+            stdscr, LINES - 1, 0,
+            utils::pad_str(fmt.str(), COLS, utils::Justify::LEFT, ' ', true)
+                .c_str(),
+            COLS
+        );
+        wrefresh(stdscr);
+    }
+}// end App::disp_progress
+
+// Waits for a keypress, as wgetch(stdscr) would. While navigations are
+// running, waits on their handlers' output as well, and drives them
+// forward as data arrives.
+//
+// return: key read, or -1 if none was read before the input timeout
+auto    App::wait_for_key(void)
+    -> int
+{
+    const int                   delay       = wgetdelay(stdscr);
+    std::vector<struct pollfd>  fds         = {};
+    int                         timeout     = delay;
+    int                         key;
+
+    reap_handlers();
+    update_prefetches();
+    m_scheduler.update();
+
+    if (
+        m_navigations.empty()
+        and (not m_prefetcher.running())
+        and (not m_downloads.running())
+    )
+    {
+        return wgetch(stdscr);
+    }
+
+    fds.push_back({ STDIN_FILENO, POLLIN, 0 });
+    for (const auto& nav : m_navigations)
+    {
+        const auto&     transfer    = nav.job->transfer;
+
+        // i.e. served from cache, or failed; nothing to wait for
+        if (nav.job->finished())
+        {
+            timeout = 0;
+        }
+
+        // still queued
+        if (not transfer)
+        {
+            continue;
+        }
+
+        if (nav.feed)
+        {
+            get_feed_pollfds(nav, fds);
+            continue;
+        }
+
+        fds.push_back({ transfer->fd(), POLLIN, 0 });
+        if (transfer->write_fd() >= 0)
+        {
+            fds.push_back({ transfer->write_fd(), POLLOUT, 0 });
+        }
+    }// end for nav
+    m_prefetcher.get_pollfds(fds);
+    m_downloads.get_pollfds(fds);
+
+    // keep the download list ticking over
+    if (m_downloads.running() and showing_downloads())
+    {
+        timeout = (timeout < 0) ? 1000 : std::min(timeout, 1000);
+    }
+
+    poll(fds.data(), fds.size(), timeout);
+
+    // downloads and prefetches only get what's left after navigations
+    update_navigations();
+    update_downloads();
+    m_prefetcher.update(time(nullptr));
+
+    // hand the slots of finished transfers to queued jobs
+    m_scheduler.update();
+
+    nodelay(stdscr, TRUE);
+    key = wgetch(stdscr);
+    wtimeout(stdscr, delay);
+
+    return key;
+}// end App::wait_for_key
+
+// Starts prefetching the link under the cursor (and, if configured, the
+// first links on screen) once the view has rested for long enough. Nothing
+// is prefetched while a navigation is running.
+void    App::update_prefetches(void)
+{
+    using namespace std::chrono;
+
+    const auto          now         = steady_clock::now();
+    const auto&         cfg         = m_prefetcher.config();
+    Tab::Page           *page       = nullptr;
+    string              key         = "";
+
+    if (
+        (not m_prefetcher.enabled())
+        or (not m_navigations.empty())
+        or m_tabs.empty()
+        or (not (page = curr_tab().curr_page()))
+    )
+    {
+        return;
+    }
+
+    // view state: page, scroll position and link under cursor
+    key = std::to_string(reinterpret_cast<uintptr_t>(page)) + ":"
+        + std::to_string(page->viewer().curr_buf_line()) + ":"
+        + page->viewer().curr_url();
+
+    if (key != m_dwellKey)
+    {
+        m_dwellKey = key;
+        m_dwellSince = now;
+        m_dwellHandled = false;
+        return;
+    }
+
+    if (m_dwellHandled or (now - m_dwellSince < milliseconds(cfg.dwellMs)))
+    {
+        return;
+    }
+
+    m_dwellHandled = true;
+
+    if (not page->viewer().curr_url().empty())
+    {
+        prefetch(page->viewer().curr_url());
+    }
+
+    for (const auto& url : page->viewer().visible_urls(cfg.visibleLinks))
+    {
+        prefetch(url);
+    }// end for url
+}// end App::update_prefetches
+
+// Starts a background fetch of a link on the current page, unless it is
+// already available (or the prefetch limits have been reached).
+//
+// param link: url of the link, possibly relative to the current page
+void    App::prefetch(const string& link)
+{
+    const Uri&          base        = curr_page().uri();
+    const Uri           url         = Uri::from_relative(base, link);
+    const time_t        now         = time(nullptr);
+    HttpFetcher         *fetcher    = nullptr;
+    HttpCache::Entry    entry       = {};
+
+    if (
+        Uri(link).is_fragment()
+        or (HttpCache::key(url) == HttpCache::key(base))
+        or (not m_prefetcher.accepts(url))
+        or (not (fetcher = get_uri_handler(url.scheme)))
+        or m_documentCache.find(url, COLS, now)
+        or (m_cache.lookup(url, entry) and HttpCache::is_fresh(entry, now))
+    )
+    {
+        return;
+    }
+
+    m_debuggerMain.printf(
+        3,
+        "%s: prefetching \"%s\"",
+        m_debuggerMain.format_curr_time().c_str(),
+        url.str().c_str()
+    );
+
+    m_prefetcher.add(
+        url,
+        m_scheduler.submit(
+            FetchScheduler::Priority::prefetch,
+            *fetcher,
+            url,
+            {},
+            { { "W3M_REQUEST_METHOD", "GET" } }
+        )
+    );
+}// end App::prefetch
+
+// Shows the prefetch counters in the status line.
+void    App::disp_prefetch_stats(void)
+{
+    const auto&         stats       = m_prefetcher.stats();
+    const size_t        visits      = stats.hits + stats.misses;
+    std::stringstream   fmt;
+
+    fmt << "prefetch: " << stats.started << " started, "
+        << stats.hits << "/" << visits << " visits hit";
+    if (visits)
+    {
+        fmt << " (" << (100 * stats.hits / visits) << "%)";
+    }
+    fmt << ", " << stats.wasted << " unused, "
+        << stats.aborted << " aborted, "
+        << stats.bytes << " bytes used";
+
+    curr_page().viewer().disp_status(fmt.str());
+}// end App::disp_prefetch_stats
+
+// Drives running downloads forward, reporting any that have finished in
+// the status line. The download list, if shown, is brought up to date
+// once a second, or as soon as a download finishes.
+void    App::update_downloads(void)
+{
+    using namespace std::chrono;
+
+    const auto      finished    = m_downloads.update(m_scheduler);
+
+    for (const size_t id : finished)
+    {
+        const auto      *dl     = m_downloads.find(id);
 
-        if (doc)
-        {
-            curr_tab().push_document(doc, fullUri);
-        }
-        else
-        {
-            handle_data(*contentType, data);
-        }
-finally:
         m_debuggerMain.printf(
-            3,
-            "%s: redrawing document for \"%s\"",
+            2,
+            "%s: download of \"%s\" to \"%s\" %s%s%s",
             m_debuggerMain.format_curr_time().c_str(),
-            fullUri.str().c_str()
+            dl->url.str().c_str(),
+            dl->path.c_str(),
+            DownloadManager::state_name(dl->state),
+            dl->error.empty() ? "" : ": ",
+            dl->error.c_str()
         );
-        redraw(true);
-        m_debuggerMain.printf(
-            3,
-            "%s: finished redrawing document for \"%s\"",
-            m_debuggerMain.format_curr_time().c_str(),
-            fullUri.str().c_str()
+    }// end for id
+
+    if (
+        showing_downloads()
+        and (
+            (not finished.empty())
+            or (
+                m_downloads.running()
+                and (steady_clock::now() - m_downloadsShown >= seconds(1))
+            )
+        )
+    )
+    {
+        disp_downloads();
+    }
+
+    if (
+        (not finished.empty())
+        and m_navigations.empty()
+        and curr_tab().curr_page()
+    )
+    {
+        const auto      *dl     = m_downloads.find(finished.back());
+
+        curr_page().viewer().disp_status(
+            "[download " + std::to_string(dl->id) + "] "
+                + DownloadManager::state_name(dl->state) + ": " + dl->path
+                + (dl->error.empty() ? "" : " (" + dl->error + ")")
         );
     }
-}// end goto_url
+}// end App::update_downloads
+
+// return: true if the current page is the download list
+auto    App::showing_downloads(void)
+    -> bool
+{
+    return (not m_tabs.empty())
+        and curr_tab().curr_page()
+        and (curr_tab().curr_page()->uri().str() == DOWNLOADS_URI);
+}// end App::showing_downloads
+
+// Shows the download list in the current tab: in place, if it is already
+// shown there, or as a new page.
+void    App::disp_downloads(void)
+{
+    const auto          now         = DownloadManager::clock_type::now();
+    const ByteBuffer    list        = m_downloads.format_list(now);
+    s_ptr<Document>     doc         = make_document("text/plain", list);
+
+    m_downloadsShown = now;
+
+    if (showing_downloads())
+    {
+        curr_tab().curr_page()->set_document(doc);
+    }
+    else
+    {
+        curr_tab().push_document(doc, DOWNLOADS_URI);
+    }
+
+    m_currPage = curr_tab().curr_page();
+    redraw(true);
+}// end App::disp_downloads
+
+// param args: command, followed by download ids (as listed)
+// return: the given ids, or those of all downloads if none are given
+auto    App::download_ids(const command_args_container& args) const
+    -> std::vector<size_t>
+{
+    std::vector<size_t>     ids     = {};
+
+    for (auto iter = args.cbegin() + 1; iter != args.cend(); ++iter)
+    {
+        ids.push_back(strtoul(iter->c_str(), nullptr, 10));
+    }// end for iter
+
+    if (ids.empty())
+    {
+        for (const auto& dl : m_downloads.downloads())
+        {
+            ids.push_back(dl.id);
+        }// end for dl
+    }
+
+    return ids;
+}// end App::download_ids
 
 // Displays data given a certain mime-type. Behavior dependent on mailcap
 // handlers.
@@ -880,70 +2145,208 @@ finally:
 // param data: container containing byte-level data to display
 void    App::handle_data(
     const string& mimeType,
-    const std::vector<char>& data
+    const ByteBuffer& data
 )
 {
     using namespace std;
 
-    static size_t           counter         = 0;
-    char                    fbase[0x100]    = {};
-    string                  fname           = {};
-    const Mailcap::Entry    *entry          = nullptr;
-    ofstream                tempFile;
-    Command                 cmd;
+    const Mailcap::Entry        *entry      = find_mailcap_entry(mimeType);
+    string                      fbase       = {};
+    TempFile                    tempFile;
+    u_ptr<Command::Subprocess>  sproc       = nullptr;
 
-    for (const auto& mailcap : m_mailcaps)
-    {
-        if ((entry = mailcap.get_entry(mimeType)))
-        {
-            break;
-        }
-    }// end for
-    
     if (not entry)
     {
         return;
     }
 
-    // TODO: handle path separators, maximum filename length
-    sprintf(fbase, "%s/w3mtmp-%016zx", m_config.tempdir.c_str(), counter);
-    fname = entry->parse_filename(fbase);
-
-    // write data to tempfile
+    // write data to tempfile, and start the handler on it
     if (not entry->file_piped())
     {
-        tempFile.open(fname.c_str());
-        if (tempFile.fail())
+        tempFile = open_temp_file(*entry, fbase);
+        if (
+            (not tempFile.is_open())
+            or (not tempFile.write(data.data(), data.size()))
+        )
         {
             return;
         }
-        ++counter;
-        tempFile.write(data.data(), data.size());
-        tempFile.close();
+        start_handler_on(*entry, std::move(tempFile), fbase, mimeType);
+        return;
     }
 
-    cmd = entry->create_command(fbase, mimeType);
+    // otherwise, pipe data to the handler
+    fbase = next_temp_base();
+    sproc.reset(new Command::Subprocess(
+        spawn_handler(*entry, fbase, mimeType)
+    ));
+    sproc->stdin().write(data.data(), data.size());
+    sproc->stdin().close();
+
+    adopt_handler(*entry, std::move(sproc));
+}// end handle_data
+
+// param mimeType: mime type to look up
+// return: the first matching entry of the loaded mailcaps, or nullptr
+auto    App::find_mailcap_entry(const string& mimeType) const
+    -> const Mailcap::Entry*
+{
+    const Mailcap::Entry    *entry          = nullptr;
+
+    for (const auto& mailcap : m_mailcaps)
+    {
+        if ((entry = mailcap.get_entry(mimeType)))
+        {
+            break;
+        }
+    }// end for
+
+    return entry;
+}// end App::find_mailcap_entry
+
+// return: a fresh base name for a handler's temp file, in the temp dir
+auto    App::next_temp_base(void) const
+    -> string
+{
+    static size_t           counter         = 0;
+    char                    fbase[0x100]    = {};
+
+    // TODO: handle path separators, maximum filename length
+    snprintf(
+        fbase,
+        sizeof(fbase),
+        "%s/w3mtmp-%016zx",
+        m_config.tempdir.c_str(),
+        counter++
+    );
+
+    return fbase;
+}// end App::next_temp_base
+
+// Starts a mailcap handler, handing it the terminal if it needs it.
+//
+// param entry: mailcap entry to run
+// param fileBase: temp file base name, as from next_temp_base
+// param mimeType: mime type of the data handled
+auto    App::spawn_handler(
+    const Mailcap::Entry& entry,
+    const string& fileBase,
+    const string& mimeType
+) -> Command::Subprocess
+{
+    Command         cmd     = entry.create_command(fileBase, mimeType);
 
-    if (entry->needs_terminal())
+    if (entry.needs_terminal())
     {
         endwin();
     }
 
-    auto sproc = cmd.spawn();
+    return cmd.spawn();
+}// end App::spawn_handler
 
-    // pipe file contents to process, if necessary
-    if (entry->file_piped())
+// Creates the temp file a mailcap handler reads its input from: in memory
+// if so configured (and the entry doesn't ask for a particular file name,
+// which a memfd can't have), on disk otherwise.
+//
+// param entry: mailcap entry of the handler
+// param fileBase: set to the base name to start the handler with
+// return: the file; check is_open for success
+auto    App::open_temp_file(const Mailcap::Entry& entry, string& fileBase)
+    -> TempFile
+{
+    fileBase = next_temp_base();
+
+    if (
+        m_config.tempInMemory
+        and (entry.parse_filename(fileBase) == fileBase)
+    )
     {
-        sproc.stdin().write(data.data(), data.size());
-        sproc.stdin().close();
+        TempFile        file        = TempFile::in_memory("w3mtmp");
+
+        if (file.is_open())
+        {
+            fileBase = file.path();
+            return file;
+        }
     }
 
-    if (entry->needs_terminal())
+    return TempFile(entry.parse_filename(fileBase));
+}// end App::open_temp_file
+
+// Starts a mailcap handler on a complete temp file. An in-memory file is
+// sealed and passed on to the handler, so that it is released when the
+// handler exits; one on disk is removed once the handler has exited.
+//
+// param entry: mailcap entry to run
+// param file: file for the handler to read, as from open_temp_file
+// param fileBase: base name, as from open_temp_file
+// param mimeType: mime type of the data handled
+void    App::start_handler_on(
+    const Mailcap::Entry& entry,
+    TempFile file,
+    const string& fileBase,
+    const string& mimeType
+)
+{
+    u_ptr<Command::Subprocess>  sproc   = nullptr;
+
+    file.finish();
+    file.set_inheritable(true);
+    sproc.reset(new Command::Subprocess(
+        spawn_handler(entry, fileBase, mimeType)
+    ));
+    file.close();
+
+    adopt_handler(entry, std::move(sproc), std::move(file));
+}// end App::start_handler_on
+
+// Takes charge of a handler that has been given all of its input: waits
+// for one that has the terminal, and keeps any other (with its temp file)
+// until it exits.
+//
+// param entry: mailcap entry of the handler
+// param process: the handler
+// param file: temp file the handler reads, if any
+void    App::adopt_handler(
+    const Mailcap::Entry& entry,
+    u_ptr<Command::Subprocess> process,
+    TempFile file
+)
+{
+    if (entry.needs_terminal())
     {
-        sproc.wait();
+        process->wait();
         doupdate();
+        return;
     }
-}// end handle_data
+
+    m_handlers.push_back({ std::move(process), std::move(file) });
+}// end App::adopt_handler
+
+// Lets go of background handlers that have exited. A temp file on disk is
+// kept until the App exits, as the handler may only have passed its path
+// on to another program (i.e. xdg-open, or a viewer that was already
+// running), which may not have opened it yet; an in-memory file is let go
+// of with its handler.
+void    App::reap_handlers(void)
+{
+    m_handlers.remove_if([this](HandlerProcess& handler)
+    {
+        if (not handler.process->try_wait())
+        {
+            return false;
+        }
+
+        if (
+            (not handler.file.is_memory())
+            and (not handler.file.path().empty())
+        )
+        {
+            m_handlerFiles.push_back(std::move(handler.file));
+        }
+        return true;
+    });
+}// end App::reap_handlers
 
 // Parses the contents of a named mailcap file into a given mailcap object.
 //
@@ -1039,6 +2442,28 @@ void    App::set_form_input(Document::FormInput& input, Viewer& viewer)
     }
 }// end set_form_input
 
+// Gives a page its own copy of its document before one of its form inputs
+// is edited, if the document is shared (i.e. with the document cache, or
+// another page showing the same url). Editing a shared document would
+// change what the other pages show, and re-laying it out would leave
+// their viewers pointing into the old buffer.
+//
+// param page: page showing the input
+// param input: FormInput about to be edited
+// return: the same input, in the page's own document
+auto    App::own_form_input(Tab::Page& page, Document::FormInput& input)
+    -> Document::FormInput&
+{
+    const size_t    index   = &input - &*page.document().form_inputs();
+
+    if (page.shares_document())
+    {
+        page.set_document(page.document().clone(COLS));
+    }
+
+    return page.document().form_inputs()[index];
+}// end own_form_input
+
 // Updates view/app state accordingly given changes to a given FormInput's
 // value.
 //
@@ -1059,7 +2484,10 @@ void    App::handle_form_input(
         case Document::FormInput::Type::text:
         case Document::FormInput::Type::search:
             {
-                set_form_input(input, tab.curr_page()->viewer());
+                set_form_input(
+                    own_form_input(*tab.curr_page(), input),
+                    tab.curr_page()->viewer()
+                );
                 tab.curr_page()->document().redraw(COLS);
                 tab.curr_page()->viewer().redraw();
                 tab.curr_page()->viewer().refresh();
@@ -1093,7 +2521,12 @@ void    App::handle_form_input(
         // TODO: handle radio buttons correctly
         case Document::FormInput::Type::radio:
             {
-                input.set_is_active(not input.is_active());
+                Document::FormInput&    owned   = own_form_input(
+                                                    *tab.curr_page(),
+                                                    input
+                                                );
+
+                owned.set_is_active(not owned.is_active());
                 tab.curr_page()->document().redraw(COLS);
                 tab.curr_page()->viewer().redraw();
                 tab.curr_page()->viewer().refresh();
@@ -1218,16 +2651,36 @@ void App::reload(const command_args_container& args)
     // TODO: implement
 }// end reload
 
+// Opens a copy of the current page in a new tab, next to the current one.
+// Given a url (relative to the current page), the new tab is left in the
+// background instead, and the url is loaded into it at background
+// priority; many links can be opened this way and fetched side by side.
 void App::new_tab(const command_args_container& args)
 {
     Tab::Config     cfg         = { m_config.viewer };
     auto&           currPage    = curr_page();
     auto            pos         = m_currTab;
+    tabs_iterator   tab;
 
     ++pos;
-    m_currTab = m_tabs.emplace(pos, cfg);
+    tab = m_tabs.emplace(pos, cfg);
+    tab->push_page(currPage);
+
+    if (args.size() > 1)
+    {
+        start_navigation(
+            *tab,
+            args.at(1),
+            "GET",
+            {},
+            FetchScheduler::Priority::backgroundTab
+        );
+        redraw(true);
+        return;
+    }
+
+    m_currTab = tab;
     m_currTab->set_start_line(m_tabs.size() > 1 ? 2 : 0);
-    m_currTab->push_page(currPage);
     redraw(true);
 }// end new_tab
 
@@ -1340,6 +2793,8 @@ void App::delete_tab(const command_args_container& args)
 
     const auto      oldIter     = m_currTab;
 
+    cancel_navigations(*oldIter);
+
     if (m_currTab == m_tabs.begin())
     {
         ++m_currTab;
@@ -1602,9 +3057,11 @@ void App::exec_shell(const command_args_container& args)
 
     endwin();
     {
-        auto    sproc   = cmd.spawn();
+        auto                sproc   = cmd.spawn();
+        string              input   = "";
+        std::vector<char>   output  = {};
 
-        // write to stdin, if applicable
+        // get stdin contents, if applicable
         switch (writeInput)
         {
             case WriteInput::NONE:
@@ -1612,18 +3069,20 @@ void App::exec_shell(const command_args_container& args)
                 break;
             case WriteInput::SOURCE:
                 // TODO: implement
-                sproc.stdin().close();
                 break;
             case WriteInput::BUFFER:
-                {
-                    string  input   = curr_page().document().buffer_string();
-
-                    sproc.stdin().write(input.data(), input.length());
-                    sproc.stdin().close();
-                }
+                input = curr_page().document().buffer_string();
                 break;
         }// end switch
 
+        // write input while reading output, so a filter that writes before
+        // consuming all of its input can't deadlock us
+        sproc.communicate(
+            input.data(),
+            input.length(),
+            shouldRead ? &output : nullptr
+        );
+
         // read output as new document
         if (shouldRead)
         {
@@ -1631,7 +3090,7 @@ void App::exec_shell(const command_args_container& args)
 
             doc.reset(new DocumentText(
                 m_config.document,
-                sproc.stdout(),
+                ByteBuffer(std::move(output)),
                 COLS
             ));
             m_currPage = m_currTab->push_document(doc, {});
@@ -1740,3 +3199,210 @@ void App::prompt_url(const command_args_container& args)
     }
 }// end App::prompt_url
 
+void App::abort_fetch(const command_args_container& args)
+{
+    Navigation      *nav        = find_navigation(curr_tab());
+
+    if (not nav)
+    {
+        return;
+    }
+
+    // keep whatever part of a progressively rendered page has arrived
+    if (nav->page and nav->tab->has_page(nav->page))
+    {
+        nav->job->transfer->cancel();
+
+        try
+        {
+            finish_navigation(*nav);
+        }
+        catch (const StringException& e)
+        {
+            // truncated document didn't parse; keep the last partial render
+        }
+        catch (const std::exception& e)
+        {
+            // as above
+        }
+    }
+
+    cancel_navigations(curr_tab());
+
+    if (curr_tab().curr_page())
+    {
+        redraw(true);
+        curr_page().viewer().disp_status("fetch aborted");
+    }
+}// end App::abort_fetch
+
+// Shows where the time went in the last navigation, phase by phase (see
+// NavigationMetrics).
+void App::nav_timing(const command_args_container& args)
+{
+    const auto      *rec    = m_metrics.last();
+
+    if (not rec)
+    {
+        curr_page().viewer().disp_status("no navigations timed yet");
+        return;
+    }
+
+    curr_page().viewer().disp_status(NavigationMetrics::format(*rec));
+}// end App::nav_timing
+
+// Saves a url to a file in the background, while browsing goes on.
+//
+// usage: DOWNLOAD [URL [PATH]]
+//
+// The url is relative to the current page; by default, it is the link under
+// the cursor. Without a path, one is prompted for, suggesting the last part
+// of the url's path.
+void App::download(const command_args_container& args)
+{
+    const string    link        = (args.size() > 1)
+                                    ? args.at(1)
+                                    : curr_page().viewer().curr_url();
+    string          path        = (args.size() > 2) ? args.at(2) : "";
+    HttpFetcher     *fetcher    = nullptr;
+    Uri             url;
+    size_t          id;
+
+    if (link.empty())
+    {
+        curr_page().viewer().disp_status(
+            "usage: " + args.front() + " [URL [PATH]]"
+        );
+        return;
+    }
+
+    url = Uri::from_relative(curr_page().uri(), link);
+    url.fragment.clear();
+
+    if (not (fetcher = get_uri_handler(url.scheme)))
+    {
+        curr_page().viewer().disp_status(
+            "ERROR: no handler for scheme \"" + url.scheme + "\""
+        );
+        return;
+    }
+
+    if (path.empty())
+    {
+        path = url.path.substr(url.path.rfind('/') + 1);
+        if (path.empty())
+        {
+            path = "index.html";
+        }
+
+        if (
+            (not curr_page().viewer().prompt_string(
+                path,
+                "Save " + url.str() + " to:",
+                m_histories["DOWNLOAD"]
+            ))
+            or path.empty()
+        )
+        {
+            return;
+        }
+        m_histories.at("DOWNLOAD").push_back(path);
+    }
+
+    id = m_downloads.add(m_scheduler, *fetcher, url, path);
+
+    m_debuggerMain.printf(
+        2,
+        "%s: downloading \"%s\" to \"%s\"",
+        m_debuggerMain.format_curr_time().c_str(),
+        url.str().c_str(),
+        path.c_str()
+    );
+
+    if (showing_downloads())
+    {
+        disp_downloads();
+    }
+    curr_page().viewer().disp_status(
+        "[download " + std::to_string(id) + "] " + path + " [A: list]"
+    );
+}// end App::download
+
+// Shows the downloads, with their progress, in the current tab. The list
+// is kept up to date while it is shown.
+void App::download_list(const command_args_container& args)
+{
+    disp_downloads();
+}// end App::download_list
+
+// Pauses downloads, keeping what they have saved.
+//
+// usage: DOWNLOAD_PAUSE [ID...]
+//
+// Without ids, pauses all of them.
+void App::pause_downloads(const command_args_container& args)
+{
+    size_t      count   = 0;
+
+    for (const size_t id : download_ids(args))
+    {
+        count += m_downloads.pause(id);
+    }// end for id
+
+    if (showing_downloads())
+    {
+        disp_downloads();
+    }
+    curr_page().viewer().disp_status(
+        "paused " + std::to_string(count) + " download(s)"
+    );
+}// end App::pause_downloads
+
+// Resumes paused or failed downloads, from where they left off if their
+// handler supports byte ranges.
+//
+// usage: DOWNLOAD_RESUME [ID...]
+//
+// Without ids, resumes all of them.
+void App::resume_downloads(const command_args_container& args)
+{
+    size_t      count   = 0;
+
+    for (const size_t id : download_ids(args))
+    {
+        count += m_downloads.resume(m_scheduler, id);
+    }// end for id
+
+    if (showing_downloads())
+    {
+        disp_downloads();
+    }
+    curr_page().viewer().disp_status(
+        "resumed " + std::to_string(count) + " download(s)"
+    );
+}// end App::resume_downloads
+
+// Stops downloads and removes them from the list; what they have saved is
+// left where it is.
+//
+// usage: DOWNLOAD_CANCEL [ID...]
+//
+// Without ids, cancels all of them.
+void App::cancel_downloads(const command_args_container& args)
+{
+    size_t      count   = 0;
+
+    for (const size_t id : download_ids(args))
+    {
+        count += m_downloads.remove(id);
+    }// end for id
+
+    if (showing_downloads())
+    {
+        disp_downloads();
+    }
+    curr_page().viewer().disp_status(
+        "cancelled " + std::to_string(count) + " download(s)"
+    );
+}// end App::cancel_downloads
+
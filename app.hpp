@@ -1,21 +1,34 @@
 #ifndef __APP_HPP__
 #define __APP_HPP__
 
+#include <poll.h>
 #include <curses.h>
 
+#include <chrono>
+#include <deque>
 #include <list>
 #include <map>
+#include <unordered_set>
 
 #include "deps.hpp"
 #include "uri.hpp"
 #include "command.hpp"
 #include "http_fetcher.hpp"
+#include "http_cache.hpp"
+#include "byte_buffer.hpp"
+#include "fetch_scheduler.hpp"
+#include "document_cache.hpp"
+#include "prefetcher.hpp"
+#include "download_manager.hpp"
+#include "navigation_metrics.hpp"
 #include "html_parser.hpp"
+#include "html_push_parser.hpp"
 #include "dom_tree.hpp"
 #include "document.hpp"
 #include "tab.hpp"
 #include "viewer.hpp"
 #include "mailcap.hpp"
+#include "temp_file.hpp"
 #include "debugger.hpp"
 
 class App
@@ -26,11 +39,18 @@ class App
         struct  Config
         {
             uri_command_map         uriHandlers;
+            uri_command_map         uriCoprocesses;
             Uri                     initUrl;
             string                  tempdir;
+            bool                    tempInMemory;
             Viewer::Config          viewer;
             Document::Config        document;
             Debugger::Config        debuggerMain;
+            HttpCache::Config       cache;
+            DocumentCache::Config   documentCache;
+            Prefetcher::Config      prefetch;
+            FetchScheduler::Config  scheduler;
+            NavigationMetrics::Config   metrics;
         };// end struct Config
         typedef std::list<Tab>
             tabs_container;
@@ -61,6 +81,10 @@ class App
     protected:
         // --- protected member classes -----------------------------------
         struct  KeymapEntry;
+        struct  HandlerFeed;
+        struct  HandlerProcess;
+        struct  PageParse;
+        struct  Navigation;
 
         // --- protected member types -------------------------------------
         typedef std::map<int, KeymapEntry>              keymap;
@@ -72,6 +96,9 @@ class App
         typedef uri_handler_container::iterator         uri_handler_pointer;
         typedef std::map<string,uri_handler_pointer>    uri_handler_map;
         typedef std::deque<Mailcap>                     mailcap_container;
+        typedef std::list<Navigation>                   navigation_container;
+        typedef std::list<HandlerProcess>               handler_container;
+        typedef std::list<TempFile>                     temp_file_container;
 
         // --- protected member variables ---------------------------------
         Config                  m_config                    = {};
@@ -89,6 +116,22 @@ class App
         bool                    m_shouldTerminate           = false;
         history_map             m_histories                 = {};
         Debugger                m_debuggerMain              = {};
+        navigation_container    m_navigations               = {};
+        handler_container       m_handlers                  = {};
+        temp_file_container     m_handlerFiles              = {};
+        HttpCache               m_cache                     = {};
+        DocumentCache           m_documentCache             = {};
+        Prefetcher              m_prefetcher                = {};
+        FetchScheduler          m_scheduler                 = {};
+        string                  m_dwellKey                  = "";
+        std::chrono::steady_clock::time_point
+                                m_dwellSince                = {};
+        bool                    m_dwellHandled              = false;
+        size_t                  m_lastProgressBytes         = SIZE_MAX;
+        DownloadManager         m_downloads                 = {};
+        std::chrono::steady_clock::time_point
+                                m_downloadsShown            = {};
+        NavigationMetrics       m_metrics                   = {};
 
         // --- protected mutators -----------------------------------------
         auto curr_tab(void)
@@ -105,12 +148,91 @@ class App
             const HttpFetcher::data_container& input = {}
         );
 
+        void    start_navigation(
+            Tab& tab,
+            const Uri& targetUrl,
+            const string& requestMethod = "GET",
+            const HttpFetcher::data_container& input = {},
+            FetchScheduler::Priority priority
+                = FetchScheduler::Priority::navigation
+        );
+        auto    start_hop(
+            Navigation& nav,
+            const Uri& target,
+            const HttpFetcher::data_container& input
+        ) -> bool;
+        void    finish_navigation(Navigation& nav);
+        void    record_metrics(
+            const Navigation& nav,
+            const Document *doc,
+            size_t bytes,
+            NavigationMetrics::clock_type::duration paintTime
+        );
+        void    update_parse(Navigation& nav);
+        void    render_partial(Navigation& nav);
+        auto    make_document(
+            const string& contentType,
+            const ByteBuffer& data
+        ) -> s_ptr<Document>;
+        auto    can_display(const string& contentType) const
+            -> bool;
+        auto    start_feed(Navigation& nav)
+            -> bool;
+        auto    update_feed(Navigation& nav, bool block = false)
+            -> bool;
+        void    get_feed_pollfds(
+            const Navigation& nav,
+            std::vector<struct pollfd>& fds
+        ) const;
+        void    finish_feed(Navigation& nav);
+        void    update_navigations(void);
+        void    cancel_navigations(const Tab& tab);
+        auto    find_navigation(const Tab& tab)
+            -> Navigation*;
+        void    disp_progress(const Navigation& nav);
+        void    update_prefetches(void);
+        void    prefetch(const string& link);
+        void    disp_prefetch_stats(void);
+        void    update_downloads(void);
+        auto    showing_downloads(void)
+            -> bool;
+        void    disp_downloads(void);
+        auto    download_ids(const command_args_container& args) const
+            -> std::vector<size_t>;
+        auto    wait_for_key(void)
+            -> int;
+
         void    handle_data(
             const string& mimeType,
-            const std::vector<char>& data
+            const ByteBuffer& data
+        );
+        auto    find_mailcap_entry(const string& mimeType) const
+            -> const Mailcap::Entry*;
+        auto    next_temp_base(void) const
+            -> string;
+        auto    spawn_handler(
+            const Mailcap::Entry& entry,
+            const string& fileBase,
+            const string& mimeType
+        ) -> Command::Subprocess;
+        auto    open_temp_file(const Mailcap::Entry& entry, string& fileBase)
+            -> TempFile;
+        void    start_handler_on(
+            const Mailcap::Entry& entry,
+            TempFile file,
+            const string& fileBase,
+            const string& mimeType
         );
+        void    adopt_handler(
+            const Mailcap::Entry& entry,
+            u_ptr<Command::Subprocess> process,
+            TempFile file = {}
+        );
+        void    reap_handlers(void);
         void    parse_mailcap_file(Mailcap& mailcap, const string& fname);
         void    set_form_input(Document::FormInput& input, Viewer& viewer);
+        auto    own_form_input(Tab::Page& page, Document::FormInput& input)
+            -> Document::FormInput&;
 
         template <class CONT_T>
         void    parse_mailcap_env(CONT_T& mailcaps, const string& env);
@@ -156,6 +278,16 @@ class App
         void command(const command_args_container& args);
         void source_commands(const command_args_container& args);
         void prompt_url(const command_args_container& args);
+        void abort_fetch(const command_args_container& args);
+        void nav_timing(const command_args_container& args);
+        void download(const command_args_container& args);
+        void download_list(const command_args_container& args);
+        void pause_downloads(const command_args_container& args);
+        void resume_downloads(const command_args_container& args);
+        void cancel_downloads(const command_args_container& args);
+
+        // --- protected static constants ---------------------------------
+        static const string     DOWNLOADS_URI;
 };// end class App
 
 struct App::KeymapEntry
@@ -164,4 +296,124 @@ struct App::KeymapEntry
     std::map<int,KeymapEntry>       children    = {};
 };// end struct App::KeymapEntry
 
+// === struct App::HandlerFeed ============================================
+//
+// The body of a navigation that can't be displayed, streamed to its
+// mailcap handler as it arrives rather than collected first. Handlers that
+// read their stdin are started as soon as the headers are in, and fed
+// through <handler>'s stdin; others get <tempFile>, and are started on it
+// once it is complete (see App::open_temp_file).
+//
+// <pending> holds the bytes read from the transfer that the handler has
+// not taken yet (from <pendingPos> on); the transfer isn't read again
+// until they are gone, so the handler's pace bounds memory use.
+//
+// ========================================================================
+struct App::HandlerFeed
+{
+    const Mailcap::Entry                *entry          = nullptr;
+    string                              mimeType        = "";
+    string                              fileBase        = "";
+    TempFile                            tempFile        = {};
+    u_ptr<Command::Subprocess>          handler         = nullptr;
+    HttpFetcher::data_container         pending         = {};
+    size_t                              pendingPos      = 0;
+
+    ~HandlerFeed(void);
+};// end struct App::HandlerFeed
+
+// === struct App::HandlerProcess =========================================
+//
+// A mailcap handler left running in the background, with the temp file it
+// reads, if any. The handler is let go of once it has exited (see
+// App::reap_handlers); a temp file on disk is kept, and removed when the
+// App exits. A handler that needs the terminal is waited on instead, and
+// its file removed as soon as it exits.
+//
+// ========================================================================
+struct App::HandlerProcess
+{
+    u_ptr<Command::Subprocess>          process         = nullptr;
+    TempFile                            file            = {};
+};// end struct App::HandlerProcess
+
+// === struct App::PageParse ==============================================
+//
+// The html body of a navigation, parsed into <dom> as it arrives (see
+// HtmlPushParser), so that neither partial renders nor the finished page
+// parse the body from the start again. <parser> has been fed the first
+// <bytes> bytes of the body; it's dropped if the body doesn't parse,
+// leaving that to be reported once the body is complete.
+//
+// <closed> counts the elements the parser has closed, and <rendered> how
+// many had been closed when the page was last laid out.
+//
+// ========================================================================
+struct App::PageParse
+{
+    DomTree                             dom             = {};
+    u_ptr<HtmlPushParser>               parser          = nullptr;
+    size_t                              bytes           = 0;
+    size_t                              closed          = 0;
+    size_t                              rendered        = 0;
+    std::chrono::steady_clock::duration
+                                        time            = {};
+};// end struct App::PageParse
+
+// === struct App::Navigation =============================================
+//
+// A page fetch running in the background on behalf of a tab. Follows
+// redirects hop by hop; once the final response has been read, the
+// resulting document is pushed onto the target tab.
+//
+// Displayable documents are also rendered while they are still arriving:
+// each time the body doubles in size (starting from renderSize bytes), the
+// partial body is laid out and shown in a provisional page, which is then
+// updated in place until the transfer completes. An html body is parsed
+// a chunk at a time as it's read, through <parse>; it's laid out again
+// only once more of its elements have been closed.
+//
+// GET requests are served from the response cache when possible. A stale
+// cached response is kept in <cached> while the handler is asked whether
+// it is still valid, and substituted for the handler's "304 Not Modified".
+// If the page is still laid out in memory (see DocumentCache), no request
+// is made at all: <document> is set and <job> left empty. If it is being
+// prefetched (see Prefetcher), the prefetch's job is taken over.
+//
+// Requests are submitted to the FetchScheduler at the navigation's
+// <priority>, so <job> may wait for a while before its transfer starts.
+//
+// Content for a mailcap handler is streamed to it through <feed>.
+//
+// Where the navigation got its response from (see NavigationMetrics) is
+// kept in <source>, and the times at which it and its final hop were
+// started in <started> and <hopStarted>.
+//
+// ========================================================================
+struct App::Navigation
+{
+    Tab                                 *tab            = nullptr;
+    FetchScheduler::job_pointer         job             = nullptr;
+    FetchScheduler::Priority            priority
+                                        = FetchScheduler::Priority::navigation;
+    string                              requestMethod   = "GET";
+    std::map<string,string>             fetchEnv        = {};
+    Uri                                 prevUri         = {};
+    Uri                                 fullUri         = {};
+    std::unordered_set<string>          visitedUris     = {};
+    Tab::Page                           *page           = nullptr;
+    size_t                              renderSize      = 0x2000;
+    bool                                cacheable       = false;
+    u_ptr<HttpCache::Entry>             cached          = nullptr;
+    s_ptr<Document>                     document        = nullptr;
+    u_ptr<HandlerFeed>                  feed            = nullptr;
+    u_ptr<PageParse>                    parse           = nullptr;
+    string                              source          = "network";
+    size_t                              redirects       = 0;
+    NavigationMetrics::clock_type::time_point
+                                        started         = {};
+    NavigationMetrics::clock_type::time_point
+                                        hopStarted      = {};
+};// end struct App::Navigation
+
 #endif
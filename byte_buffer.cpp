@@ -0,0 +1,94 @@
+#include <istream>
+#include <streambuf>
+
+#include "deps.hpp"
+
+#include "byte_buffer.hpp"
+
+// === class ByteBuffer Implementation ====================================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+ByteBuffer::ByteBuffer(void)
+{
+    // do nothing
+}// end ByteBuffer::ByteBuffer
+
+// Takes over the storage of <data>.
+ByteBuffer::ByteBuffer(container&& data)
+{
+    m_data = std::make_shared<const container>(std::move(data));
+}// end ByteBuffer::ByteBuffer
+
+ByteBuffer::ByteBuffer(const container& data)
+{
+    m_data = std::make_shared<const container>(data);
+}// end ByteBuffer::ByteBuffer
+
+ByteBuffer::ByteBuffer(const string& str)
+{
+    m_data = std::make_shared<const container>(str.cbegin(), str.cend());
+}// end ByteBuffer::ByteBuffer
+
+// --- public accessors ---------------------------------------------------
+auto ByteBuffer::data(void) const
+    -> const char*
+{
+    return m_data ? m_data->data() : nullptr;
+}// end ByteBuffer::data
+
+auto ByteBuffer::size(void) const
+    -> size_t
+{
+    return m_data ? m_data->size() : 0;
+}// end ByteBuffer::size
+
+auto ByteBuffer::empty(void) const
+    -> bool
+{
+    return not size();
+}// end ByteBuffer::empty
+
+auto ByteBuffer::begin(void) const
+    -> const_iterator
+{
+    return data();
+}// end ByteBuffer::begin
+
+auto ByteBuffer::end(void) const
+    -> const_iterator
+{
+    return data() + size();
+}// end ByteBuffer::end
+
+// return: a copy of the contents, as a string
+auto ByteBuffer::str(void) const
+    -> string
+{
+    return string(begin(), end());
+}// end ByteBuffer::str
+
+// === class ByteBuffer::Reader Implementation ============================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+ByteBuffer::Reader::Reader(const ByteBuffer& buffer)
+    : std::istream(nullptr), m_buffer(buffer), m_streambuf(m_buffer)
+{
+    rdbuf(&m_streambuf);
+}// end ByteBuffer::Reader::Reader
+
+// === class ByteBuffer::Reader::streambuf Implementation =================
+//
+// ========================================================================
+
+// The get area is the buffer itself. It is never written to: putting back
+// a character other than the one read fails (see std::streambuf::pbackfail).
+ByteBuffer::Reader::streambuf::streambuf(const ByteBuffer& buffer)
+{
+    char    *start  = const_cast<char*>(buffer.begin());
+
+    setg(start, start, start + buffer.size());
+}// end ByteBuffer::Reader::streambuf::streambuf
@@ -0,0 +1,77 @@
+#ifndef __BYTE_BUFFER_HPP__
+#define __BYTE_BUFFER_HPP__
+
+#include <istream>
+#include <streambuf>
+
+#include "deps.hpp"
+
+// === class ByteBuffer ===================================================
+//
+// Immutable, reference-counted block of bytes (i.e. a response body).
+// Copying a ByteBuffer only copies a reference, so one body can be handed
+// from the fetcher to a document and on to a mailcap handler without
+// being duplicated. A ByteBuffer built from a moved vector takes over the
+// vector's storage.
+//
+// ByteBuffer::Reader reads a buffer as a std::istream, in place.
+//
+// ========================================================================
+class ByteBuffer
+{
+    public:
+        // --- public member types ----------------------------------------
+        typedef     std::vector<char>           container;
+        typedef     const char*                 const_iterator;
+        class       Reader;
+
+        // --- public constructors ----------------------------------------
+        ByteBuffer(void);
+        ByteBuffer(container&& data);
+        ByteBuffer(const container& data);
+        ByteBuffer(const string& str);
+
+        // --- public accessors -------------------------------------------
+        auto data(void) const
+            -> const char*;
+        auto size(void) const
+            -> size_t;
+        auto empty(void) const
+            -> bool;
+        auto begin(void) const
+            -> const_iterator;
+        auto end(void) const
+            -> const_iterator;
+        auto str(void) const
+            -> string;
+    private:
+        // --- private member variables -----------------------------------
+        s_ptr<const container>      m_data      = nullptr;
+};// end class ByteBuffer
+
+// === class ByteBuffer::Reader ===========================================
+//
+// Input stream over the contents of a ByteBuffer, which it keeps alive.
+// Nothing is copied; characters are read straight from the buffer.
+//
+// ========================================================================
+class ByteBuffer::Reader : public std::istream
+{
+    public:
+        // --- public constructors ----------------------------------------
+        Reader(const ByteBuffer& buffer);
+        Reader(const Reader& other) = delete;
+    private:
+        // --- private member types ---------------------------------------
+        class   streambuf : public std::streambuf
+        {
+            public:
+                streambuf(const ByteBuffer& buffer);
+        };// end class streambuf
+
+        // --- private member variables -----------------------------------
+        ByteBuffer      m_buffer;
+        streambuf       m_streambuf;
+};// end class ByteBuffer::Reader
+
+#endif
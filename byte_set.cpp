@@ -0,0 +1,287 @@
+#include <cstddef>
+#include <cstring>
+
+#include "byte_set.hpp"
+
+#if defined(__GNUC__) and (defined(__x86_64__) or defined(__i386__))
+#define BYTE_SET_X86
+#include <immintrin.h>
+#endif
+
+// === Kernels ============================================================
+//
+// Each returns the first byte in [begin, end) that is one of the <n>
+// bytes of a set, or <end> if there is none. A set is given by its
+// membership <table> and its bytes each repeated across a vector, in
+// <splat>. The vector kernels handle the tail that doesn't fill a vector with
+// the next narrower kernel.
+//
+// ========================================================================
+namespace
+{
+    typedef ByteSet::Kernel     Kernel;
+
+    // bytes checked one at a time before a vector search
+    const ptrdiff_t             SCALAR_LEAD     = 16;
+
+    auto find_scalar(
+        const bool *table,
+        const char (*)[32],
+        size_t,
+        const char *begin,
+        const char *end
+    ) -> const char*
+    {
+        while (begin != end and not table[(unsigned char)(*begin)])
+        {
+            ++begin;
+        }// end while
+
+        return begin;
+    }// end find_scalar
+
+#ifdef BYTE_SET_X86
+    __attribute__((target("sse2")))
+    auto find_sse2(
+        const bool *table,
+        const char (*splat)[32],
+        size_t n,
+        const char *begin,
+        const char *end
+    ) -> const char*
+    {
+        const __m128i   *needles    = (const __m128i*)(splat);
+
+        for (; end - begin >= 16; begin += 16)
+        {
+            const __m128i   block   = _mm_loadu_si128(
+                                        (const __m128i*)(begin)
+                                    );
+            __m128i         hits    = _mm_cmpeq_epi8(block, needles[0]);
+            int             mask    = 0;
+
+            // rows of <splat> are two vectors wide
+            for (size_t i = 1; i < n; ++i)
+            {
+                hits = _mm_or_si128(
+                    hits,
+                    _mm_cmpeq_epi8(block, needles[2 * i])
+                );
+            }// end for i
+
+            mask = _mm_movemask_epi8(hits);
+            if (mask)
+            {
+                return begin + __builtin_ctz(mask);
+            }
+        }// end for begin
+
+        return find_scalar(table, splat, n, begin, end);
+    }// end find_sse2
+
+    __attribute__((target("avx2")))
+    auto find_avx2(
+        const bool *table,
+        const char (*splat)[32],
+        size_t n,
+        const char *begin,
+        const char *end
+    ) -> const char*
+    {
+        const __m256i   *needles    = (const __m256i*)(splat);
+
+        for (; end - begin >= 32; begin += 32)
+        {
+            const __m256i   block   = _mm256_loadu_si256(
+                                        (const __m256i*)(begin)
+                                    );
+            __m256i         hits    = _mm256_cmpeq_epi8(block, needles[0]);
+            unsigned        mask    = 0;
+
+            for (size_t i = 1; i < n; ++i)
+            {
+                hits = _mm256_or_si256(
+                    hits,
+                    _mm256_cmpeq_epi8(block, needles[i])
+                );
+            }// end for i
+
+            mask = _mm256_movemask_epi8(hits);
+            if (mask)
+            {
+                return begin + __builtin_ctz(mask);
+            }
+        }// end for begin
+
+        return find_sse2(table, splat, n, begin, end);
+    }// end find_avx2
+#endif
+
+    // return: the widest kernel the CPU supports
+    auto best_kernel(void)
+        -> Kernel
+    {
+        if (ByteSet::supported(Kernel::avx2))
+        {
+            return Kernel::avx2;
+        }
+        else if (ByteSet::supported(Kernel::sse2))
+        {
+            return Kernel::sse2;
+        }
+
+        return Kernel::scalar;
+    }// end best_kernel
+
+    Kernel      currKernel      = best_kernel();
+}// end namespace
+
+// === class ByteSet Implementation =======================================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+ByteSet::ByteSet(void)
+{
+    // do nothing
+}// end ByteSet::ByteSet
+
+// Builds the set of the bytes in the nul-terminated string <bytes>.
+ByteSet::ByteSet(const char *bytes)
+{
+    for (; *bytes; ++bytes)
+    {
+        bool&       member      = m_table[(unsigned char)(*bytes)];
+
+        if (member)
+        {
+            continue;
+        }
+        member = true;
+        if (m_size < MAX_VECTOR_BYTES)
+        {
+            m_bytes[m_size] = *bytes;
+            memset(m_splat[m_size], *bytes, sizeof(m_splat[m_size]));
+        }
+        ++m_size;
+    }// end for bytes
+}// end ByteSet::ByteSet
+
+// --- public accessors ---------------------------------------------------
+
+// return: number of (distinct) bytes in the set
+auto ByteSet::size(void) const
+    -> size_t
+{
+    return m_size;
+}// end ByteSet::size
+
+auto ByteSet::contains(char byte) const
+    -> bool
+{
+    return m_table[(unsigned char)(byte)];
+}// end ByteSet::contains
+
+// return: the first byte in [begin, end) that is in the set, or <end> if
+//  there is none
+auto ByteSet::find_first(const char *begin, const char *end) const
+    -> const char*
+{
+    if (begin == end)
+    {
+        return end;
+    }
+    else if (1 == m_size)
+    {
+        const void      *found  = memchr(begin, m_bytes[0], end - begin);
+
+        return found ? (const char*)(found) : end;
+    }
+    else if (m_size <= MAX_VECTOR_BYTES and m_size)
+    {
+        const char      *lead       = (end - begin > SCALAR_LEAD) ?
+                                        begin + SCALAR_LEAD : end;
+
+        // delimiters are often close by (i.e. the end of a word), so
+        // check the first few bytes before setting up a vector search
+        begin = find_scalar(m_table, m_splat, m_size, begin, lead);
+        if (begin != lead or lead == end)
+        {
+            return begin;
+        }
+
+        switch (currKernel)
+        {
+#ifdef BYTE_SET_X86
+            case Kernel::avx2:
+                return find_avx2(m_table, m_splat, m_size, begin, end);
+            case Kernel::sse2:
+                return find_sse2(m_table, m_splat, m_size, begin, end);
+#endif
+            default:
+                break;
+        }// end switch
+    }
+
+    return find_scalar(m_table, m_splat, m_size, begin, end);
+}// end ByteSet::find_first
+
+// --- public static functions --------------------------------------------
+
+// return: the kernel find_first() uses
+auto ByteSet::kernel(void)
+    -> Kernel
+{
+    return currKernel;
+}// end ByteSet::kernel
+
+// return: true if the CPU can run <kernel>
+auto ByteSet::supported(Kernel kernel)
+    -> bool
+{
+    switch (kernel)
+    {
+        case Kernel::scalar:
+            return true;
+#ifdef BYTE_SET_X86
+        case Kernel::sse2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+        case Kernel::avx2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }// end switch
+}// end ByteSet::supported
+
+// Makes find_first() use <kernel> (i.e. to compare kernels).
+//  return: false, leaving the kernel unchanged, if the CPU can't run it
+auto ByteSet::set_kernel(Kernel kernel)
+    -> bool
+{
+    if (not supported(kernel))
+    {
+        return false;
+    }
+
+    currKernel = kernel;
+    return true;
+}// end ByteSet::set_kernel
+
+auto ByteSet::kernel_name(Kernel kernel)
+    -> const char*
+{
+    switch (kernel)
+    {
+        case Kernel::scalar:
+            return "scalar";
+        case Kernel::sse2:
+            return "sse2";
+        case Kernel::avx2:
+            return "avx2";
+    }// end switch
+
+    return "unknown";
+}// end ByteSet::kernel_name
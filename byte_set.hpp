@@ -0,0 +1,62 @@
+#ifndef __BYTE_SET_HPP__
+#define __BYTE_SET_HPP__
+
+#include <cstddef>
+
+// === class ByteSet ======================================================
+//
+// A small set of bytes (i.e. the delimiters of a token), and a search for
+// the first of them in a block of memory. The search is the hot loop of
+// the html tokenizer and of entity decoding, so it has vector kernels: on
+// x86, each 16 (SSE2) or 32 (AVX2) bytes of input are compared against
+// every byte in the set at once (each byte is kept repeated across a
+// vector, ready to compare). The widest kernel the CPU supports is
+// chosen when the program starts; the scalar kernel (a lookup table) is
+// used elsewhere, and for sets of more than MAX_VECTOR_BYTES bytes. A set
+// of one byte is searched with memchr, which is already vectorized.
+//
+// ========================================================================
+class ByteSet
+{
+    public:
+        // --- public member types ----------------------------------------
+        enum class  Kernel
+        {
+            scalar      = 0,
+            sse2        = 1,
+            avx2        = 2,
+        };// end enum class Kernel
+
+        // --- public constructors ----------------------------------------
+        ByteSet(void);
+        ByteSet(const char *bytes);
+
+        // --- public accessors -------------------------------------------
+        auto size(void) const
+            -> size_t;
+        auto contains(char byte) const
+            -> bool;
+        auto find_first(const char *begin, const char *end) const
+            -> const char*;
+
+        // --- public static functions ------------------------------------
+        static auto kernel(void)
+            -> Kernel;
+        static auto supported(Kernel kernel)
+            -> bool;
+        static auto set_kernel(Kernel kernel)
+            -> bool;
+        static auto kernel_name(Kernel kernel)
+            -> const char*;
+
+        // --- public static constants ------------------------------------
+        static const size_t     MAX_VECTOR_BYTES    = 16;
+    private:
+        // --- private member variables -----------------------------------
+        bool            m_table[256]                    = {};
+        char            m_bytes[MAX_VECTOR_BYTES]       = {};
+        size_t          m_size                          = 0;
+        alignas(32) char    m_splat[MAX_VECTOR_BYTES][32]   = {};
+};// end class ByteSet
+
+#endif
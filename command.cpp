@@ -5,8 +5,13 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <signal.h>
+#include <spawn.h>
 #include <wait.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
 #include <map>
 #include <sstream>
 
@@ -208,17 +213,180 @@ auto Command::Subprocess::wait(void)                 -> int
 {
     int     woptions    = 0;
 
-    waitpid(m_pid, &m_exitStatus, woptions);
+    if (waitpid(m_pid, &m_exitStatus, woptions) == m_pid)
+    {
+        m_hasTerminated = true;
+    }
 
     return m_exitStatus;
 }// end Command::Subprocess::wait
 
+// Collects the subprocess's exit status, if it has exited, without
+// blocking.
+//
+// return: true if the subprocess has terminated
+auto Command::Subprocess::try_wait(void)             -> bool
+{
+    if (
+        (not m_hasTerminated)
+        and (waitpid(m_pid, &m_exitStatus, WNOHANG) == m_pid)
+    )
+    {
+        m_hasTerminated = true;
+    }
+
+    return m_hasTerminated;
+}// end Command::Subprocess::try_wait
+
 auto Command::Subprocess::kill(int sig) -> int
 {
     return ::kill(m_pid, sig);
 }// end Command::Subprocess::kill
 
+auto Command::Subprocess::write_stdin(const char *data, size_t len)
+    -> ssize_t
+{
+    const int       fd          = stdin().fd();
+    sigset_t        pipeSet;
+    sigset_t        oldSet;
+    ssize_t         nWritten;
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    // a subprocess that exits without reading all of its input must not
+    // take us down with SIGPIPE; block it and collect it if raised
+    sigemptyset(&pipeSet);
+    sigaddset(&pipeSet, SIGPIPE);
+    sigprocmask(SIG_BLOCK, &pipeSet, &oldSet);
+
+    do
+    {
+        nWritten = ::write(fd, data, len);
+    } while ((nWritten < 0) and (EINTR == errno));
+
+    if ((nWritten < 0) and (EPIPE == errno))
+    {
+        const struct timespec   noWait  = { 0, 0 };
+
+        sigtimedwait(&pipeSet, nullptr, &noWait);
+    }
+
+    sigprocmask(SIG_SETMASK, &oldSet, nullptr);
+
+    if (nWritten >= 0)
+    {
+        return nWritten;
+    }
+    else if ((EAGAIN == errno) or (EWOULDBLOCK == errno))
+    {
+        return 0;
+    }
+
+    return -1;
+}// end Command::Subprocess::write_stdin
+
+void Command::Subprocess::communicate(
+    const char *input,
+    size_t len,
+    std::vector<char> *out,
+    std::vector<char> *err
+)
+{
+    enum { IN = 0, OUT = 1, ERR = 2 };
+
+    struct pollfd           fds[3]      = {};
+    std::vector<char>       *sinks[3]   = { nullptr, out, err };
+    char                    buf[0x1000];
+
+    fds[IN].fd = stdin_piped() ? stdin().fd() : -1;
+    fds[IN].events = POLLOUT;
+    fds[OUT].fd = stdout_piped() ? stdout().fd() : -1;
+    fds[OUT].events = POLLIN;
+    fds[ERR].fd = stderr_piped() ? stderr().fd() : -1;
+    fds[ERR].events = POLLIN;
+
+    if ((fds[IN].fd >= 0) and (not len))
+    {
+        stdin().close();
+        fds[IN].fd = -1;
+    }
+
+    while ((fds[IN].fd >= 0) or (fds[OUT].fd >= 0) or (fds[ERR].fd >= 0))
+    {
+        if (poll(fds, 3, -1) < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            break;
+        }
+
+        if (fds[IN].revents)
+        {
+            const ssize_t   nWritten    = write_stdin(input, len);
+
+            if (nWritten > 0)
+            {
+                input += nWritten;
+                len -= nWritten;
+            }
+
+            // close once done, or if the subprocess stopped reading
+            if ((nWritten < 0) or (not len))
+            {
+                stdin().close();
+                fds[IN].fd = -1;
+            }
+        }
+
+        for (int i = OUT; i <= ERR; ++i)
+        {
+            ssize_t     nRead;
+
+            if ((fds[i].fd < 0) or (not fds[i].revents))
+            {
+                continue;
+            }
+
+            nRead = ::read(fds[i].fd, buf, sizeof(buf));
+
+            if (nRead > 0)
+            {
+                if (sinks[i])
+                {
+                    sinks[i]->insert(sinks[i]->end(), buf, buf + nRead);
+                }
+            }
+            else if ((0 == nRead) or (EINTR != errno))
+            {
+                if (OUT == i)
+                {
+                    stdout().close();
+                }
+                else
+                {
+                    stderr().close();
+                }
+                fds[i].fd = -1;
+            }
+        }// end for i
+    }// end while
+
+    if (fds[IN].fd >= 0)
+    {
+        stdin().close();
+    }
+}// end Command::Subprocess::communicate
+
 // --- protected member constructor(s) ------------------------------------
+
+// Spawns the subprocess with posix_spawnp, rather than fork/exec: the
+// child doesn't copy our page tables, and everything it needs (argv,
+// envp, pipe redirections) is prepared up front, so nothing unsafe runs
+// between fork and exec. All pipe ends are created close-on-exec, so they
+// don't leak into this or any other child; the child's ends are dup'ed
+// onto its stdin/stdout/stderr, which clears the flag.
 Command::Subprocess::Subprocess(
     std::vector<string> args,
     const std::map<string,string>& env,
@@ -235,15 +403,17 @@ Command::Subprocess::Subprocess(
     vector<char*>           argsRaw                 = {};
     vector<string>          envArray                = {};
     vector<char*>           envArrayRaw             = {};
-    int                     inPipe[2]               = {};
-    int                     outPipe[2]              = {};
-    int                     errPipe[2]              = {};
+    int                     inPipe[2]               = { -1, -1 };
+    int                     outPipe[2]              = { -1, -1 };
+    int                     errPipe[2]              = { -1, -1 };
+    posix_spawn_file_actions_t  actions;
+    posix_spawnattr_t           attr;
+    sigset_t                    noSignals;
+    int                         err;
 
     // NOTE: need to allocate at least one more than number of args.
     // That way, final const char* ptr is null terminator.
     argsRaw.reserve(args.size() + 3);
-    envArray.reserve(env.size());
-    envArrayRaw.reserve(env.size() + 1);
 
     if (isShellCommand)
     {
@@ -258,114 +428,120 @@ Command::Subprocess::Subprocess(
 
     argsRaw.push_back(NULL);
 
-    // build env array
+    // build env array: our environment, with variables in <env> replaced
+    // (or removed, if empty)
+    for (char **var = environ; *var; ++var)
+    {
+        const char  *eq     = strchr(*var, '=');
+        const string key    = eq ? string(*var, eq - *var) : string(*var);
+
+        if (not env.count(key))
+        {
+            envArray.push_back(*var);
+        }
+    }// end for var
+
     for (auto& kv : env)
     {
-        envArray.push_back(kv.first + "=" + kv.second);
-        envArrayRaw.push_back(&envArray.back()[0]);
+        if (not kv.second.empty())
+        {
+            envArray.push_back(kv.first + "=" + kv.second);
+        }
     }// end for kv
 
+    envArrayRaw.reserve(envArray.size() + 1);
+    for (auto& var : envArray)
+    {
+        envArrayRaw.push_back(&var[0]);
+    }// end for var
+
     envArrayRaw.push_back(NULL);
 
-    if (pipeStdin)
+    // create pipes
+    if (
+        (pipeStdin and pipe2(inPipe, O_CLOEXEC))
+        or (pipeStdout and pipe2(outPipe, O_CLOEXEC))
+        or (pipeStderr and pipe2(errPipe, O_CLOEXEC))
+    )
     {
-        switch (pipe(inPipe))
+        for (int fd : { inPipe[0], inPipe[1], outPipe[0], outPipe[1],
+            errPipe[0], errPipe[1] })
         {
-            // success
-            case 0:
-                m_stdin = make_unique<ofdstream>(inPipe[1]);
-                break;
-            // failure
-            case -1:
-                throw logic_error("call to pipe() failed");
-                break;
-            default:
-                throw logic_error("unrecognized pipe() return value");
-                break;
-        }// end switch (pipe(inPipe))
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }// end for fd
+        throw logic_error("call to pipe() failed");
     }
 
+    posix_spawn_file_actions_init(&actions);
+    if (pipeStdin)
+    {
+        posix_spawn_file_actions_adddup2(&actions, inPipe[0], 0);
+    }
     if (pipeStdout)
     {
-        switch (pipe(outPipe))
-        {
-            // success
-            case 0:
-                m_stdout = make_unique<ifdstream>(outPipe[0]);
-                break;
-            // failure
-            case -1:
-                throw logic_error("call to pipe() failed");
-                break;
-            default:
-                throw logic_error("unrecognized pipe() return value");
-                break;
-        }// end switch (pipe(outPipe))
+        posix_spawn_file_actions_adddup2(&actions, outPipe[1], 1);
     }
-
     if (pipeStderr)
     {
-        switch (pipe(errPipe))
-        {
-            // success
-            case 0:
-                m_stderr = make_unique<ifdstream>(errPipe[0]);
-                break;
-            // failure
-            case -1:
-                throw logic_error("call to pipe() failed");
-                break;
-            default:
-                throw logic_error("unrecognized pipe() return value");
-                break;
-        }// end switch (pipe(errPipe))
+        posix_spawn_file_actions_adddup2(&actions, errPipe[1], 2);
     }
 
-    // perform fork
-    m_pid = fork();
-    switch (m_pid)
+    // don't pass on any signals we happen to be blocking
+    sigemptyset(&noSignals);
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setsigmask(&attr, &noSignals);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+    // perform spawn
+    err = posix_spawnp(
+        &m_pid,
+        argsRaw[0],
+        &actions,
+        &attr,
+        &argsRaw[0],
+        &envArrayRaw[0]
+    );
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+
+    // close child's ends of the pipes
+    for (int fd : { inPipe[0], outPipe[1], errPipe[1] })
     {
-        // in child process
-        case 0:
-            if (pipeStdin)
-            {
-                close(inPipe[1]);
-                dup2(inPipe[0], 0);
-            }
-            if (pipeStdout)
-            {
-                close(outPipe[0]);
-                dup2(outPipe[1], 1);
-            }
-            if (pipeStderr)
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }// end for fd
+
+    if (err)
+    {
+        for (int fd : { inPipe[1], outPipe[0], errPipe[0] })
+        {
+            if (fd >= 0)
             {
-                close(errPipe[0]);
-                dup2(errPipe[1], 2);
+                close(fd);
             }
-            // set environment
-            for (const auto& kv : env)
-            {
-                if (kv.second.empty())
-                    ::unsetenv(kv.first.c_str());
-                else
-                    ::setenv(kv.first.c_str(), kv.second.c_str(), 1);
-            }// end for kv
-            execvp(argsRaw[0], &argsRaw[0]);
-            break;
-        // error
-        case -1:
-            throw logic_error("call to fork() failed");
-            break;
-        // in parent process
-        default:
-            if (pipeStdin)
-                close(inPipe[0]);
-            if (pipeStdout)
-                close(outPipe[1]);
-            if (pipeStderr)
-                close(errPipe[1]);
-            break;
-    }// switch (m_pid)
+        }// end for fd
+        m_pid = 0;
+        throw logic_error("call to posix_spawn() failed");
+    }
+
+    if (pipeStdin)
+    {
+        m_stdin = make_unique<ofdstream>(inPipe[1]);
+    }
+    if (pipeStdout)
+    {
+        m_stdout = make_unique<ifdstream>(outPipe[0]);
+    }
+    if (pipeStderr)
+    {
+        m_stderr = make_unique<ifdstream>(errPipe[0]);
+    }
 }// end Command::Subprocess::Subprocess
 
 // === class Command::Subprocess::except_file_unpiped Implementation ======
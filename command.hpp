@@ -92,7 +92,35 @@ class   Command::Subprocess
         auto stdout(void)   -> ifdstream&;
         auto stderr(void)   -> ifdstream&;
         auto wait(void)     -> int;
+        auto try_wait(void) -> bool;
         auto kill(int sig)  -> int;
+
+        // ------ write_stdin ---------------------------------------------
+        //
+        // Writes as much of <data> to the subprocess's stdin as the pipe
+        // will take without blocking. Puts stdin into non-blocking mode.
+        //
+        // Returns the number of bytes written (0 if the pipe is full), or
+        // -1 if the subprocess has closed its end of the pipe.
+        //
+        // ----------------------------------------------------------------
+        auto write_stdin(const char *data, size_t len)  -> ssize_t;
+
+        // ------ communicate ---------------------------------------------
+        //
+        // Writes <input> to the subprocess's stdin while reading its stdout
+        // and stderr, so that neither process can block on a full pipe.
+        // Returns once stdout and stderr have reached EOF; all piped
+        // streams are closed on return. Output is appended to <out> and
+        // <err>, or discarded if they are null.
+        //
+        // ----------------------------------------------------------------
+        void communicate(
+            const char *input,
+            size_t len,
+            std::vector<char> *out = nullptr,
+            std::vector<char> *err = nullptr
+        );
     protected:
         // === protected member variable(s) ===============================
         pid_t                   m_pid               = 0;
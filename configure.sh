@@ -12,7 +12,7 @@ export BIN=w3m
 export TEST_DIR=tests
 export CPP=g++
 export LD="${CPP}"
-export LDFLAGS="-lncursesw"
+export LDFLAGS="-lncursesw -lz"
 export PREFIX="/usr/local"
 
 # misc. files
@@ -20,6 +20,8 @@ generated_files=(
     document_html_entMap.gen.hpp
     document_FormInput_Type_enum.gen.hpp 
     document_FormInput_type_typeMap.gen.hpp
+    html_atom_enum.gen.hpp
+    html_atom_names.gen.hpp
 )
 
 # parse options from args
@@ -309,6 +311,12 @@ ${TAB}./\$< < html_form_input_types.txt > \$@
 document_FormInput_type_typeMap.gen.hpp :  document_FormInput_type_typeMap.hpp.sh html_form_input_types.txt
 ${TAB}./\$< < html_form_input_types.txt > \$@
 
+html_atom_enum.gen.hpp : html_atom_enum.hpp.sh html_atoms.txt
+${TAB}./\$< < html_atoms.txt > \$@
+
+html_atom_names.gen.hpp : html_atom_names.hpp.sh html_atoms.txt
+${TAB}./\$< < html_atoms.txt > \$@
+
 _EOF_
 
 # Generate test dependencies
@@ -0,0 +1,199 @@
+#include <cctype>
+
+#include <zlib.h>
+
+#include "deps.hpp"
+
+#include "content_decoder.hpp"
+
+// === class ContentDecoder Implementation ================================
+//
+// ========================================================================
+
+// --- private static constants -------------------------------------------
+const size_t    ContentDecoder::C_OUTPUT_CHUNK      = 0x10000;
+
+// --- public constructors ------------------------------------------------
+ContentDecoder::ContentDecoder(Coding coding)
+    : m_coding(coding)
+{
+    // 32: detect a zlib or gzip header
+    if (Z_OK != inflateInit2(&m_stream, MAX_WBITS + 32))
+    {
+        m_failed = true;
+    }
+}// end ContentDecoder::ContentDecoder
+
+ContentDecoder::~ContentDecoder(void)
+{
+    inflateEnd(&m_stream);
+}// end ContentDecoder::~ContentDecoder
+
+// --- public accessors ---------------------------------------------------
+auto ContentDecoder::coding(void) const
+    -> Coding
+{
+    return m_coding;
+}// end ContentDecoder::coding
+
+auto ContentDecoder::failed(void) const
+    -> bool
+{
+    return m_failed;
+}// end ContentDecoder::failed
+
+// return: number of encoded bytes decoded so far
+auto ContentDecoder::bytes_in(void) const
+    -> size_t
+{
+    return m_bytesIn;
+}// end ContentDecoder::bytes_in
+
+// --- public mutators ----------------------------------------------------
+
+// Decodes the next <len> bytes of encoded data, appending the result to
+// <out>.
+//
+// return: false if the data is corrupt (now, or earlier)
+auto ContentDecoder::decode(
+    const char *data,
+    size_t len,
+    std::vector<char>& out
+) -> bool
+{
+    bool        more        = true;
+
+    if (m_failed)
+    {
+        return false;
+    }
+
+    m_bytesIn += len;
+
+    // kept until the format is certain (see restart_raw)
+    if ((Coding::deflate == m_coding) and (not m_raw) and (not m_produced))
+    {
+        m_head.insert(m_head.end(), data, data + len);
+    }
+
+    m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    m_stream.avail_in = len;
+
+    while (more)
+    {
+        const size_t    oldSize     = out.size();
+        int             err;
+
+        out.resize(oldSize + C_OUTPUT_CHUNK);
+        m_stream.next_out = reinterpret_cast<Bytef*>(out.data() + oldSize);
+        m_stream.avail_out = C_OUTPUT_CHUNK;
+
+        err = inflate(&m_stream, Z_NO_FLUSH);
+        out.resize(out.size() - m_stream.avail_out);
+
+        if (out.size() > oldSize)
+        {
+            m_produced = true;
+            m_head.clear();
+        }
+
+        switch (err)
+        {
+            case Z_OK:
+                more = m_stream.avail_in or (0 == m_stream.avail_out);
+                break;
+            case Z_STREAM_END:
+                // another gzip member may follow
+                more = m_stream.avail_in;
+                if (more)
+                {
+                    inflateReset(&m_stream);
+                }
+                break;
+            case Z_BUF_ERROR:
+                // i.e. needs more input
+                more = false;
+                break;
+            default:
+                if (
+                    (Coding::deflate == m_coding)
+                    and (not m_raw) and (not m_produced)
+                )
+                {
+                    return restart_raw(out);
+                }
+                m_failed = true;
+                return false;
+        }// end switch
+    }// end while
+
+    return true;
+}// end ContentDecoder::decode
+
+// --- public static functions --------------------------------------------
+
+// param value: value of a Content-Encoding header
+// return: the coding, or Coding::unknown if it isn't one we can decode
+//  (including a list of several codings)
+auto ContentDecoder::parse_coding(std::string_view value)
+    -> Coding
+{
+    string      name        = "";
+
+    for (char ch : value)
+    {
+        if (not isspace(ch))
+        {
+            name.push_back(tolower(ch));
+        }
+    }// end for ch
+
+    if (name.empty() or ("identity" == name))
+    {
+        return Coding::identity;
+    }
+    else if (("gzip" == name) or ("x-gzip" == name))
+    {
+        return Coding::gzip;
+    }
+    else if ("deflate" == name)
+    {
+        return Coding::deflate;
+    }
+
+    return Coding::unknown;
+}// end ContentDecoder::parse_coding
+
+// return: value for an Accept-Encoding request header, listing the codings
+//  that can be decoded
+auto ContentDecoder::accept_encoding(void)
+    -> const string&
+{
+    static const string     value       = "gzip, deflate";
+
+    return value;
+}// end ContentDecoder::accept_encoding
+
+// --- private mutators ---------------------------------------------------
+
+// Starts over on the data received so far as raw deflate data, once it
+// has turned out not to be in the zlib format.
+auto ContentDecoder::restart_raw(std::vector<char>& out)
+    -> bool
+{
+    const std::vector<char>     head        = std::move(m_head);
+
+    inflateEnd(&m_stream);
+    m_stream = {};
+    m_raw = true;
+    m_head.clear();
+    m_bytesIn -= head.size();
+
+    if (Z_OK != inflateInit2(&m_stream, -MAX_WBITS))
+    {
+        m_failed = true;
+        return false;
+    }
+
+    return decode(head.data(), head.size(), out);
+}// end ContentDecoder::restart_raw
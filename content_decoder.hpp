@@ -0,0 +1,73 @@
+#ifndef __CONTENT_DECODER_HPP__
+#define __CONTENT_DECODER_HPP__
+
+#include <string_view>
+
+#include <zlib.h>
+
+#include "deps.hpp"
+
+// === class ContentDecoder ===============================================
+//
+// Incremental decoder for a compressed Content-Encoding (gzip or deflate),
+// fed a response body piece by piece as it arrives.
+//
+// Servers disagree on what "deflate" means: the zlib format (as the spec
+// says) or raw deflate data; both are accepted. Concatenated gzip members
+// are decoded one after another. Once the data turns out to be corrupt,
+// the decoder fails, and ignores anything more it is given.
+//
+// ========================================================================
+class ContentDecoder
+{
+    public:
+        // --- public member types ----------------------------------------
+        enum class  Coding
+        {
+            identity    = 0,
+            gzip        = 1,
+            deflate     = 2,
+            unknown     = 3,
+        };// end enum class Coding
+
+        // --- public constructors ----------------------------------------
+        ContentDecoder(Coding coding);
+        ContentDecoder(const ContentDecoder& other) = delete;
+        ~ContentDecoder(void);
+
+        // --- public accessors -------------------------------------------
+        auto coding(void) const
+            -> Coding;
+        auto failed(void) const
+            -> bool;
+        auto bytes_in(void) const
+            -> size_t;
+
+        // --- public mutators --------------------------------------------
+        auto decode(const char *data, size_t len, std::vector<char>& out)
+            -> bool;
+
+        // --- public static functions ------------------------------------
+        static auto parse_coding(std::string_view value)
+            -> Coding;
+        static auto accept_encoding(void)
+            -> const string&;
+    private:
+        // --- private member variables -----------------------------------
+        Coding              m_coding        = Coding::identity;
+        z_stream            m_stream        = {};
+        std::vector<char>   m_head          = {};
+        bool                m_produced      = false;
+        bool                m_raw           = false;
+        bool                m_failed        = false;
+        size_t              m_bytesIn       = 0;
+
+        // --- private static constants -----------------------------------
+        static const size_t     C_OUTPUT_CHUNK;
+
+        // --- private mutators -------------------------------------------
+        auto restart_raw(std::vector<char>& out)
+            -> bool;
+};// end class ContentDecoder
+
+#endif
@@ -253,6 +253,14 @@ auto Document::buffer_const_iter(size_t lineIdx, size_t nodeIdx) const
     }
 }// end Document::buffer_const_iter
 
+// return: time taken to parse and lay out the document when it was built,
+//  and the number of nodes parsed
+auto Document::stats(void) const
+    -> const Stats&
+{
+    return m_stats;
+}// end Document::stats
+
 // --- public mutator(s) --------------------------------------------------
 void    Document::clear(void)
 {
@@ -641,7 +649,7 @@ void    Document::FormInput::set_name(const string& name)
 
     if (m_domNode)
     {
-        m_domNode->attributes["name"] = name;
+        m_domNode->attributes[HtmlAtom::name] = name;
     }
 }// end Document::FormInput::set_name
 
@@ -651,7 +659,7 @@ void    Document::FormInput::set_value(const string& value)
 
     if (m_domNode)
     {
-        m_domNode->attributes["value"] = value;
+        m_domNode->attributes[HtmlAtom::value] = value;
     }
 }// end Document::FormInput::set_value
 
@@ -677,12 +685,12 @@ void    Document::FormInput::set_is_active(bool state)
                     if (m_isActive)
                     {
                         form().insert_input(m_index);
-                        m_domNode->attributes["checked"] = "1";
+                        m_domNode->attributes[HtmlAtom::checked] = "1";
                     }
                     else
                     {
                         form().remove_input(m_index);
-                        m_domNode->attributes.erase("checked");
+                        m_domNode->attributes.erase(HtmlAtom::checked);
                     }
                 }
                 break;
@@ -702,12 +710,12 @@ void    Document::FormInput::set_is_active(bool state)
                                 formInput.set_is_active(false);
                             }// end for
                         }
-                        m_domNode->attributes["checked"] = "1";
+                        m_domNode->attributes[HtmlAtom::checked] = "1";
                     }
                     else
                     {
                         form().remove_input(m_index);
-                        m_domNode->attributes.erase("checked");
+                        m_domNode->attributes.erase(HtmlAtom::checked);
                     }
                 }
                 break;
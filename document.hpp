@@ -1,6 +1,7 @@
 #ifndef __DOCUMENT_HPP__
 #define __DOCUMENT_HPP__
 
+#include <chrono>
 #include <list>
 #include <map>
 #include <unordered_set>
@@ -22,6 +23,12 @@ class   Document
                 size_t      max;
             } inputWidth;
         };// end struct Document::Config
+        struct  Stats
+        {
+            std::chrono::steady_clock::duration     parseTime;
+            std::chrono::steady_clock::duration     layoutTime;
+            size_t                                  nodes;
+        };// end struct Document::Stats
         class       BufferNode;
         class       Reference;
         class       Form;
@@ -137,6 +144,8 @@ class   Document
             -> buffer_node_const_iterator;
         auto buffer_const_iter(size_t lineIdx, size_t nodeIdx) const
             -> buffer_node_const_iterator;
+        auto stats(void) const
+            -> const Stats&;
 
         // --- public mutator(s) ------------------------------------------
         void            clear(void);
@@ -144,6 +153,8 @@ class   Document
         {
             // do nothing
         }
+        virtual auto    clone(size_t cols) const
+            -> s_ptr<Document> = 0;
         void set_title(const string& title);
         auto forms(void)
             -> form_container::iterator;
@@ -162,6 +173,7 @@ class   Document
         form_container          m_forms         = {};
         form_input_container    m_form_inputs   = {};
         section_map             m_sections      = {};
+        Stats                   m_stats         = {};
 
         // --- protected static functions ---------------------------------
         static auto debugger(void)
@@ -0,0 +1,28 @@
+// Does not use include guards, by design.
+// Should be #include'd at the appropriate location in document.hpp.
+
+enum class Type
+{
+    text = 0,
+    button,
+    checkbox,
+    color,
+    date,
+    datetime_local,
+    email,
+    file,
+    hidden,
+    image,
+    month,
+    number,
+    password,
+    radio,
+    range,
+    reset,
+    search,
+    submit,
+    tel,
+    time,
+    url,
+    week,
+};// end enum class Type
@@ -0,0 +1,28 @@
+// Does not use include guards, by design.
+// Should be #include'd at the appropriate location in document.hpp.
+
+static const std::map<string,Type> typeMap =
+{
+    { "text", Type::text },
+    { "button", Type::button },
+    { "checkbox", Type::checkbox },
+    { "color", Type::color },
+    { "date", Type::date },
+    { "datetime-local", Type::datetime_local },
+    { "email", Type::email },
+    { "file", Type::file },
+    { "hidden", Type::hidden },
+    { "image", Type::image },
+    { "month", Type::month },
+    { "number", Type::number },
+    { "password", Type::password },
+    { "radio", Type::radio },
+    { "range", Type::range },
+    { "reset", Type::reset },
+    { "search", Type::search },
+    { "submit", Type::submit },
+    { "tel", Type::tel },
+    { "time", Type::time },
+    { "url", Type::url },
+    { "week", Type::week },
+};// end static const std::map<string,Type> typeMap
@@ -0,0 +1,160 @@
+#include <ctime>
+#include <list>
+#include <unordered_map>
+
+#include "deps.hpp"
+#include "uri.hpp"
+#include "http_fetcher.hpp"
+#include "document.hpp"
+#include "http_cache.hpp"
+
+#include "document_cache.hpp"
+
+// === class DocumentCache Implementation =================================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+DocumentCache::DocumentCache(void)
+{
+    // do nothing
+}// end DocumentCache::DocumentCache
+
+DocumentCache::DocumentCache(const Config& cfg)
+{
+    m_maxSize = cfg.maxSize;
+    m_lifetime = cfg.lifetime;
+}// end DocumentCache::DocumentCache
+
+// --- public accessors ---------------------------------------------------
+
+// return: total weight of the cached documents
+auto DocumentCache::size(void) const
+    -> size_t
+{
+    return m_size;
+}// end DocumentCache::size
+
+auto DocumentCache::count(void) const
+    -> size_t
+{
+    return m_entries.size();
+}// end DocumentCache::count
+
+// --- public mutators ----------------------------------------------------
+
+// return: the cached document for a url at a given width, or nullptr if
+//  there is none (or it has expired)
+auto DocumentCache::find(const Uri& url, size_t cols, time_t now)
+    -> s_ptr<Document>
+{
+    const auto      found   = m_index.find(key(url, cols));
+
+    if (found == m_index.end())
+    {
+        return nullptr;
+    }
+
+    if (found->second->expires <= now)
+    {
+        erase(found->second);
+        return nullptr;
+    }
+
+    // move to front
+    m_entries.splice(m_entries.begin(), m_entries, found->second);
+
+    return m_entries.front().doc;
+}// end DocumentCache::find
+
+// Adds (or replaces) the document for a url at a given width.
+//  weight: approximate memory cost (i.e. size of the document's source)
+//  headers: the response the document was built from, whose freshness
+//      (if it gives one) is kept; the cache's lifetime is used otherwise
+void DocumentCache::insert(
+    const Uri& url,
+    size_t cols,
+    const s_ptr<Document>& doc,
+    size_t weight,
+    const HttpFetcher::header_type& headers
+)
+{
+    const string        str     = key(url, cols);
+    const auto          found   = m_index.find(str);
+    const time_t        now     = time(nullptr);
+    time_t              expires = now + m_lifetime;
+
+    if (found != m_index.end())
+    {
+        erase(found->second);
+    }
+
+    if (
+        (not doc) or (weight > m_maxSize)
+        or HttpCache::has_directive(headers, "no-store")
+        or HttpCache::has_directive(headers, "no-cache")
+    )
+    {
+        return;
+    }
+
+    if (HttpCache::has_explicit_freshness(headers))
+    {
+        HttpCache::Entry    entry   = {};
+
+        entry.headers = headers;
+        entry.storedAt = now;
+        expires = now + HttpCache::freshness_lifetime(entry);
+
+        // already stale (i.e. max-age=0, or an Expires in the past)
+        if (expires <= now)
+        {
+            return;
+        }
+    }
+
+    m_entries.push_front({ str, doc, weight, expires });
+    m_index[str] = m_entries.begin();
+    m_size += weight;
+
+    while (m_size > m_maxSize)
+    {
+        erase(std::prev(m_entries.end()));
+    }// end while
+}// end DocumentCache::insert
+
+// Drops a document (i.e. once it has been modified by user input, and so
+// no longer matches its source).
+void DocumentCache::erase(const Document *doc)
+{
+    for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+    {
+        if (iter->doc.get() == doc)
+        {
+            erase(iter);
+            return;
+        }
+    }// end for iter
+}// end DocumentCache::erase
+
+void DocumentCache::clear(void)
+{
+    m_entries.clear();
+    m_index.clear();
+    m_size = 0;
+}// end DocumentCache::clear
+
+// --- private mutators ---------------------------------------------------
+void DocumentCache::erase(entry_list::iterator iter)
+{
+    m_size -= iter->weight;
+    m_index.erase(iter->key);
+    m_entries.erase(iter);
+}// end DocumentCache::erase
+
+// --- private static functions -------------------------------------------
+auto DocumentCache::key(const Uri& url, size_t cols)
+    -> string
+{
+    return std::to_string(cols) + " " + HttpCache::key(url);
+}// end DocumentCache::key
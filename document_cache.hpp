@@ -0,0 +1,88 @@
+#ifndef __DOCUMENT_CACHE_HPP__
+#define __DOCUMENT_CACHE_HPP__
+
+#include <ctime>
+#include <list>
+#include <unordered_map>
+
+#include "deps.hpp"
+#include "uri.hpp"
+#include "http_fetcher.hpp"
+#include "document.hpp"
+
+// === class DocumentCache ================================================
+//
+// In-memory cache of laid-out documents, keyed by url and layout width, so
+// that a page already open in one tab (or visited recently) can be shown
+// in another without being fetched, parsed and laid out again. Cached
+// documents are shared with the pages showing them.
+//
+// Each entry is weighed by the size of the source it was built from; once
+// the total passes the budget, the least recently used entries are dropped
+// (pages still showing them keep them alive). Entries also expire, so that
+// a page isn't shown from memory indefinitely: when the response says how
+// long it is fresh, then, otherwise after the cache's lifetime. Responses
+// that must not be reused without asking the server (no-store, no-cache)
+// aren't cached.
+//
+// ========================================================================
+class DocumentCache
+{
+    public:
+        // --- public member types ----------------------------------------
+        struct  Config
+        {
+            size_t      maxSize;
+            time_t      lifetime;
+        };// end struct Config
+
+        // --- public constructors ----------------------------------------
+        DocumentCache(void);
+        DocumentCache(const Config& cfg);
+
+        // --- public accessors -------------------------------------------
+        auto size(void) const
+            -> size_t;
+        auto count(void) const
+            -> size_t;
+
+        // --- public mutators --------------------------------------------
+        auto find(const Uri& url, size_t cols, time_t now)
+            -> s_ptr<Document>;
+        void insert(
+            const Uri& url,
+            size_t cols,
+            const s_ptr<Document>& doc,
+            size_t weight,
+            const HttpFetcher::header_type& headers
+        );
+        void erase(const Document *doc);
+        void clear(void);
+    private:
+        // --- private member types ---------------------------------------
+        struct  Entry
+        {
+            string              key;
+            s_ptr<Document>     doc;
+            size_t              weight;
+            time_t              expires;
+        };// end struct Entry
+        typedef std::list<Entry>                                entry_list;
+        typedef std::unordered_map<string,entry_list::iterator> entry_map;
+
+        // --- private member variables -----------------------------------
+        size_t          m_maxSize       = 0;
+        time_t          m_lifetime      = 0;
+        size_t          m_size          = 0;
+        entry_list      m_entries       = {};   // most recently used first
+        entry_map       m_index         = {};
+
+        // --- private mutators -------------------------------------------
+        void erase(entry_list::iterator iter);
+
+        // --- private static functions -----------------------------------
+        static auto key(const Uri& url, size_t cols)
+            -> string;
+};// end class DocumentCache
+
+#endif
@@ -1,12 +1,18 @@
+#include <chrono>
 #include <cstdio>
 #include <cctype>
+#include <iterator>
 #include <sstream>
 #include <map>
 
 #include "deps.hpp"
 #include "utils.hpp"
+#include "byte_buffer.hpp"
+#include "byte_set.hpp"
 #include "dom_tree.hpp"
+#include "html_atom.hpp"
 #include "html_parser_basic.hpp"
+#include "html_push_parser.hpp"
 #include "document.hpp"
 #include "document_html.hpp"
 
@@ -15,26 +21,26 @@ DocumentHtml::DocumentHtml(const Document::Config& cfg)
     : Document(cfg)
 {
     // initialize dispatcher
-    m_dispatcher["a"] = &DocumentHtml::append_a;
-    m_dispatcher["audio"] = &DocumentHtml::append_embed;
-    m_dispatcher["br"] = &DocumentHtml::append_br;
-    m_dispatcher["div"] = &DocumentHtml::append_div;
-    m_dispatcher["form"] = &DocumentHtml::append_form;
-    m_dispatcher["h1"] = &DocumentHtml::append_hn;
-    m_dispatcher["h2"] = &DocumentHtml::append_hn;
-    m_dispatcher["h3"] = &DocumentHtml::append_hn;
-    m_dispatcher["h4"] = &DocumentHtml::append_hn;
-    m_dispatcher["h5"] = &DocumentHtml::append_hn;
-    m_dispatcher["h6"] = &DocumentHtml::append_hn;
-    m_dispatcher["hr"] = &DocumentHtml::append_hr;
-    m_dispatcher["img"] = &DocumentHtml::append_img;
-    m_dispatcher["input"] = &DocumentHtml::append_input;
-    m_dispatcher["ul"] = &DocumentHtml::append_ul;
-    m_dispatcher["ol"] = &DocumentHtml::append_ol;
-    m_dispatcher["p"] = &DocumentHtml::append_p;
-    m_dispatcher["table"] = &DocumentHtml::append_table;
-    m_dispatcher["tbody"] = &DocumentHtml::append_tbody;
-    m_dispatcher["video"] = &DocumentHtml::append_embed;
+    m_dispatcher[size_t(HtmlAtom::a)] = &DocumentHtml::append_a;
+    m_dispatcher[size_t(HtmlAtom::audio)] = &DocumentHtml::append_embed;
+    m_dispatcher[size_t(HtmlAtom::br)] = &DocumentHtml::append_br;
+    m_dispatcher[size_t(HtmlAtom::div)] = &DocumentHtml::append_div;
+    m_dispatcher[size_t(HtmlAtom::form)] = &DocumentHtml::append_form;
+    m_dispatcher[size_t(HtmlAtom::h1)] = &DocumentHtml::append_hn;
+    m_dispatcher[size_t(HtmlAtom::h2)] = &DocumentHtml::append_hn;
+    m_dispatcher[size_t(HtmlAtom::h3)] = &DocumentHtml::append_hn;
+    m_dispatcher[size_t(HtmlAtom::h4)] = &DocumentHtml::append_hn;
+    m_dispatcher[size_t(HtmlAtom::h5)] = &DocumentHtml::append_hn;
+    m_dispatcher[size_t(HtmlAtom::h6)] = &DocumentHtml::append_hn;
+    m_dispatcher[size_t(HtmlAtom::hr)] = &DocumentHtml::append_hr;
+    m_dispatcher[size_t(HtmlAtom::img)] = &DocumentHtml::append_img;
+    m_dispatcher[size_t(HtmlAtom::input)] = &DocumentHtml::append_input;
+    m_dispatcher[size_t(HtmlAtom::ul)] = &DocumentHtml::append_ul;
+    m_dispatcher[size_t(HtmlAtom::ol)] = &DocumentHtml::append_ol;
+    m_dispatcher[size_t(HtmlAtom::p)] = &DocumentHtml::append_p;
+    m_dispatcher[size_t(HtmlAtom::table)] = &DocumentHtml::append_table;
+    m_dispatcher[size_t(HtmlAtom::tbody)] = &DocumentHtml::append_tbody;
+    m_dispatcher[size_t(HtmlAtom::video)] = &DocumentHtml::append_embed;
 }// end DocumentHtml(void)
 
 DocumentHtml::DocumentHtml(
@@ -55,43 +61,107 @@ DocumentHtml::DocumentHtml(
     from_string(text, cols);
 }// end DocumentHtml(const string& text, const size_t cols)
 
+DocumentHtml::DocumentHtml(
+    const Document::Config& cfg,
+    const ByteBuffer& data,
+    const size_t cols
+) : DocumentHtml(cfg)
+{
+    from_buffer(data, cols);
+}// end DocumentHtml(const ByteBuffer& data, const size_t cols)
+
+DocumentHtml::DocumentHtml(
+    const Document::Config& cfg,
+    const ByteBuffer& data,
+    DomTree dom,
+    std::chrono::steady_clock::duration parseTime,
+    const size_t cols
+) : DocumentHtml(cfg)
+{
+    from_dom(data, std::move(dom), parseTime, cols);
+}// end DocumentHtml(const ByteBuffer& data, DomTree dom, ...)
+
 // === public mutator(s) ==========================================
+
+// Parses the document a chunk at a time as it's read, so that parsing
+// overlaps the transfer (i.e. from a pipe).
 void        DocumentHtml::from_stream(std::istream& ins, const size_t cols)
 {
-    std::getline(ins, m_data, static_cast<char>(EOF));
-    from_string(m_data, cols);
+    using clock = std::chrono::steady_clock;
+
+    char                    chunk[STREAM_CHUNK_SIZE];
+    clock::duration         parseTime   = {};
+    auto                    start       = clock::now();
+
+    m_dom.reset_root("window");
+    m_data = ByteBuffer();
+
+    HtmlPushParser          parser(*m_dom.root());
+
+    // only the time spent parsing counts, not the time spent waiting
+    while (ins.read(chunk, sizeof(chunk)) or ins.gcount())
+    {
+        start = clock::now();
+        parser.feed(chunk, ins.gcount());
+        parseTime += clock::now() - start;
+    }// end while
+    start = clock::now();
+    parser.finish();
+    parseTime += clock::now() - start;
+
+    finish_parse(parseTime, cols);
 }// end DocumentHtml::from_stream(std::istream& ins, const size_t cols)
 
 void        DocumentHtml::from_string(const string& text, const size_t cols)
 {
-    using namespace std;
+    from_buffer(text, cols);
+}// end DocumentHtml::from_string(const string& text, const size_t cols)
+
+// Shares the given buffer, rather than copying it, and parses it in place.
+void        DocumentHtml::from_buffer(const ByteBuffer& data, const size_t cols)
+{
+    using clock = std::chrono::steady_clock;
 
     HtmlParserBasic     parser;
-    istringstream       inBuf(text);
+    auto                start   = clock::now();
 
     m_dom.reset_root("window");
-    m_data = text;
-    parser.parse_html(*m_dom.root(), inBuf);
+    m_data = data;
+    parser.parse_html(*m_dom.root(), data.begin(), data.end());
+
+    finish_parse(clock::now() - start, cols);
+}// end DocumentHtml::from_buffer(const ByteBuffer& data, const size_t cols)
+
+// Takes a tree already parsed from <data> (i.e. by an HtmlPushParser, as
+// the data arrived), which took <parseTime> to build, and lays it out.
+void        DocumentHtml::from_dom(
+    const ByteBuffer& data,
+    DomTree dom,
+    std::chrono::steady_clock::duration parseTime,
+    const size_t cols
+)
+{
+    m_dom = std::move(dom);
+    m_data = data;
 
-    parse_title_from_data();
-    redraw(cols);
-}// end DocumentHtml::from_string(const string& text, const size_t cols)
+    finish_parse(parseTime, cols);
+}// end DocumentHtml::from_dom(const ByteBuffer& data, DomTree dom, ...)
 
 void        DocumentHtml::parse_title_from_data(void)
 {
     for (auto& nd : *m_dom.root())
     {
-        if (nd.identifier() == "document" or nd.identifier() == "html")
+        if (nd.identifier() == "document" or nd.atom() == HtmlAtom::html)
         {
             for (auto& child : nd)
             {
-                if (child.identifier() == "head")
+                if (child.atom() == HtmlAtom::head)
                 {
                     if (title().empty())
                     {
                         for (auto& item : child)
                         {
-                            if (item.identifier() == "title")
+                            if (item.atom() == HtmlAtom::title)
                             {
                                 for (auto& nd : item)
                                 {
@@ -130,12 +200,12 @@ void        DocumentHtml::redraw(size_t cols)
 
     for (auto& nd : *m_dom.root())
     {
-        if (nd.identifier() == "document" or nd.identifier() == "html")
+        if (nd.identifier() == "document" or nd.atom() == HtmlAtom::html)
         {
             for (auto& child : nd)
             {
                 // skip <head>
-                if (child.identifier() != "head")
+                if (child.atom() != HtmlAtom::head)
                 {
                     append_node(child, cols, fmt, stacks);
                 }
@@ -167,8 +237,48 @@ void        DocumentHtml::redraw(size_t cols)
     }// end for (auto& line : m_buffer)
 }// end DocumentHtml::redraw(size_t cols)
 
+// Returns a copy of the document (i.e. to edit its forms without changing
+// the pages sharing it), laid out to <cols> columns. The tree is copied,
+// so the copy's form inputs refer to its own nodes.
+auto        DocumentHtml::clone(size_t cols) const -> s_ptr<Document>
+{
+    s_ptr<DocumentHtml>     out(new DocumentHtml(m_config));
+
+    out->m_title = m_title;
+    out->m_stats = m_stats;
+    out->m_data = m_data;
+    out->m_dom = m_dom;
+    out->m_tabWidth = m_tabWidth;
+    out->redraw(cols);
+
+    return out;
+}// end DocumentHtml::clone(size_t cols) const -> s_ptr<Document>
+
 // === protected mutator(s) ===============================================
 
+// === DocumentHtml::finish_parse =========================================
+//
+// Records the parse statistics of the tree just built, and lays it out.
+//
+// ========================================================================
+void        DocumentHtml::finish_parse(
+    std::chrono::steady_clock::duration parseTime,
+    const size_t cols
+)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto                start   = clock::now();
+
+    parse_title_from_data();
+    m_stats.parseTime = parseTime + (clock::now() - start);
+    m_stats.nodes = m_dom.size();
+
+    start = clock::now();
+    redraw(cols);
+    m_stats.layoutTime = clock::now() - start;
+}// end DocumentHtml::finish_parse
+
 // === DocumentHtml::append_node ==========================================
 //
 // ========================================================================
@@ -200,18 +310,18 @@ void    DocumentHtml::append_node(
         append_text(nd, cols, fmt, stacks);
     }
     // ignore scripts
-    else if (nd.identifier() == "script")
+    else if (nd.atom() == HtmlAtom::script)
     {
         // do nothing
     }
     // ignore styles
-    else if (nd.identifier() == "style")
+    else if (nd.atom() == HtmlAtom::style)
     {
         // do nothing
     }
-    else if (m_dispatcher.count(nd.identifier()))
+    else if (m_dispatcher[size_t(nd.atom())])
     {
-        auto func = m_dispatcher.at(nd.identifier());
+        auto func = m_dispatcher[size_t(nd.atom())];
 
         (this->*func)(nd, cols, fmt, stacks);
     }
@@ -221,9 +331,9 @@ void    DocumentHtml::append_node(
     }
 
     // if node has an id, add it to m_sections
-    if (nd.attributes.count("id"))
+    if (nd.attributes.count(HtmlAtom::id))
     {
-        const string&   id      = nd.attributes.at("id");
+        const string&   id      = nd.attributes.at(HtmlAtom::id);
 
         if (currLines)
         {
@@ -383,14 +493,14 @@ void    DocumentHtml::append_a(
 
     append_children(a, cols, fmt, stacks);
 
-    if (not a.attributes.count("href"))
+    if (not a.attributes.count(HtmlAtom::href))
     {
         return;
     }
 
     const size_t    linkIdx     = m_links.size();
     const string    linkUrl     = utils::from_wstr(
-        decode_text(a.attributes.at("href"))
+        decode_text(a.attributes.at(HtmlAtom::href))
     );
 
     m_links.emplace_back(linkUrl);
@@ -429,20 +539,20 @@ void    DocumentHtml::append_embed(
 {
     const string    *src    = nullptr;
 
-    if (embed.attributes.count("src"))
+    if (embed.attributes.count(HtmlAtom::src))
     {
-        src = &embed.attributes.at("src");
+        src = &embed.attributes.at(HtmlAtom::src);
     }
     else
     {
         for (const auto& nd : embed)
         {
             if (
-                (nd.identifier() == "source")
-                and (nd.attributes.count("src"))
+                (nd.atom() == HtmlAtom::source)
+                and (nd.attributes.count(HtmlAtom::src))
             )
             {
-                src = &nd.attributes.at("src");
+                src = &nd.attributes.at(HtmlAtom::src);
                 break;
             }
         }// end for nd
@@ -569,8 +679,8 @@ void    DocumentHtml::append_form(
     #define     GET_ATTR(ATTR) (form.attributes.count((ATTR)) ? \
                     form.attributes.at((ATTR)) : \
                     (NULL_STR))
-    const string&           action          = GET_ATTR("action");
-    const string&           method          = GET_ATTR("method");
+    const string&           action          = GET_ATTR(HtmlAtom::action);
+    const string&           method          = GET_ATTR(HtmlAtom::method);
     #undef      GET_ATTR
 
     m_buffer.emplace_back();
@@ -651,7 +761,7 @@ void    DocumentHtml::append_img(
         m_buffer.emplace_back();
     }
 
-    if (not img.attributes.count("src"))
+    if (not img.attributes.count(HtmlAtom::src))
     {
         return;
     }
@@ -664,13 +774,13 @@ void    DocumentHtml::append_img(
     // if alt not provided, use truncated url from src
     string      imgText     = "[";
 
-    imgText += img.attributes.count("alt") ?
-                img.attributes.at("alt") :
-                utils::path_base(img.attributes.at("src"));
+    imgText += img.attributes.count(HtmlAtom::alt) ?
+                img.attributes.at(HtmlAtom::alt) :
+                utils::path_base(img.attributes.at(HtmlAtom::src));
 
     if (imgText.length() == 1)
     {
-        imgText += utils::path_base(img.attributes.at("src"));
+        imgText += utils::path_base(img.attributes.at(HtmlAtom::src));
     }
 
     imgText += ']';
@@ -678,7 +788,7 @@ void    DocumentHtml::append_img(
 
     const size_t        linkIdx     = m_images.size();
 
-    m_images.emplace_back(img.attributes.at("src"));
+    m_images.emplace_back(img.attributes.at(HtmlAtom::src));
 
     auto&               currImg     = m_images.back();
 
@@ -714,9 +824,12 @@ void    DocumentHtml::append_input(
     #define     GET_ATTR(ATTR, DEF)     (input.attributes.count((ATTR)) ? \
                                             input.attributes.at((ATTR)) : \
                                             (DEF))
-    const string&       typeName    = GET_ATTR("type", DEFAULT_INPUT_TYPE);
-    const string&       name        = GET_ATTR("name", NULL_STR);
-    const string&       value       = GET_ATTR("value", NULL_STR);
+    const string&       typeName    = GET_ATTR(
+                                        HtmlAtom::type,
+                                        DEFAULT_INPUT_TYPE
+                                    );
+    const string&       name        = GET_ATTR(HtmlAtom::name, NULL_STR);
+    const string&       value       = GET_ATTR(HtmlAtom::value, NULL_STR);
     #undef GET_ATTR
 
     const size_t        formIdx     = stacks.formIndices.back();
@@ -806,11 +919,15 @@ void    DocumentHtml::append_input(
                 static const string     NULL_STR        = "";
 
                 bool            isChecked   = false;
-                const string&   val         = input.attributes.count("value") ?
-                    input.attributes.at("value") :
+                const string&   val         =
+                    input.attributes.count(HtmlAtom::value) ?
+                    input.attributes.at(HtmlAtom::value) :
                     NULL_STR;
 
-                isChecked = (input.attributes.count("checked") and value.size());
+                isChecked = (
+                    input.attributes.count(HtmlAtom::checked)
+                    and value.size()
+                );
                 formInput.set_is_active(isChecked);
 
                 FMT_FIELD_ENCLOSED(
@@ -844,11 +961,15 @@ void    DocumentHtml::append_input(
                 static const string     NULL_STR        = "";
 
                 bool            isChecked   = false;
-                const string&   val         = input.attributes.count("value") ?
-                    input.attributes.at("value") :
+                const string&   val         =
+                    input.attributes.count(HtmlAtom::value) ?
+                    input.attributes.at(HtmlAtom::value) :
                     NULL_STR;
 
-                isChecked = (input.attributes.count("checked") and value.size());
+                isChecked = (
+                    input.attributes.count(HtmlAtom::checked)
+                    and value.size()
+                );
                 formInput.set_is_active(isChecked);
 
                 FMT_FIELD_ENCLOSED(
@@ -872,7 +993,7 @@ void    DocumentHtml::append_input(
         // unhandled/undefined fields
         default:
             {
-                if (input.attributes.count("value"))
+                if (input.attributes.count(HtmlAtom::value))
                 {
                     std::stringstream   builder;
 
@@ -916,7 +1037,7 @@ void    DocumentHtml::append_ul(
     {
         auto& child = *iter;
 
-        if (child.identifier() == "li")
+        if (child.atom() == HtmlAtom::li)
         {
             m_buffer.emplace_back();
             append_li_ul(child, cols, fmt, stacks);
@@ -949,7 +1070,7 @@ void    DocumentHtml::append_ol(
     {
         auto& child = *iter;
 
-        if (child.identifier() == "li")
+        if (child.atom() == HtmlAtom::li)
         {
             m_buffer.emplace_back();
             append_li_ol(child, cols, fmt, stacks);
@@ -1069,7 +1190,7 @@ void    DocumentHtml::append_tbody(
         auto&     elem        = *iter;
 
         append_node(elem, cols, fmt, stacks);
-        if (elem.identifier() == "tr")
+        if (elem.atom() == HtmlAtom::tr)
         {
             append_hr(tbody, cols, fmt, stacks);
         }
@@ -1185,36 +1306,36 @@ unsigned    DocumentHtml::parse_html_entity(const string& id)
 
 wstring  DocumentHtml::decode_text(const string& text)
 {
-    using namespace std;
+    static const ByteSet    AMPERSAND("&");
+    static const ByteSet    SEMICOLON(";");
 
-    size_t      idx     = 0;
-    size_t      beg     = 0;
-    wstring     out     = {};
+    const char      *curr       = text.data();
+    const char      *end        = curr + text.size();
+    wstring         out         = {};
 
-    do
+    while (curr != end)
     {
-        idx = text.find('&', beg);
+        const char      *amp        = AMPERSAND.find_first(curr, end);
+        const char      *semi       = nullptr;
 
-        out += utils::to_wstr(text.substr(beg, idx - beg));
-        if (string::npos == idx)
+        out += utils::to_wstr(string(curr, amp));
+        if (amp == end)
         {
             break;
         }
 
-        beg = idx + 1;
-        idx = text.find(';', beg);
-        if (string::npos == idx)
+        semi = SEMICOLON.find_first(amp + 1, end);
+        if (semi == end)
         {
             out.push_back('&');
+            curr = amp + 1;
         }
         else
         {
-            const string    entId   = text.substr(beg, idx - beg);
-
-            out.push_back(parse_html_entity(entId));
-            beg = idx + 1;
+            out.push_back(parse_html_entity(string(amp + 1, semi)));
+            curr = semi + 1;
         }
-    } while (beg < text.size());
+    }// end while
 
     return out;
 }// end DocumentHtml::decode_text(const string& text)
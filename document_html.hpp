@@ -1,8 +1,13 @@
 #ifndef __DOCUMENT_HTML_HPP__
 #define __DOCUMENT_HTML_HPP__
 
+#include <array>
+#include <chrono>
+
 #include "deps.hpp"
+#include "byte_buffer.hpp"
 #include "dom_tree.hpp"
+#include "html_atom.hpp"
 #include "document.hpp"
 
 // === class DocumentHtml =================================================
@@ -23,14 +28,38 @@ class   DocumentHtml : public Document
             const string& text,
             const size_t cols
         );// type 2
+        DocumentHtml(
+            const Document::Config& cfg,
+            const ByteBuffer& data,
+            const size_t cols
+        );// type 3
+        DocumentHtml(
+            const Document::Config& cfg,
+            const ByteBuffer& data,
+            DomTree dom,
+            std::chrono::steady_clock::duration parseTime,
+            const size_t cols
+        );// type 4
 
         // === public mutator(s) ==========================================
         void        from_stream(std::istream& ins, const size_t cols);
         void        from_string(const string& text, const size_t cols);
+        void        from_buffer(const ByteBuffer& data, const size_t cols);
+        void        from_dom(
+            const ByteBuffer& data,
+            DomTree dom,
+            std::chrono::steady_clock::duration parseTime,
+            const size_t cols
+        );
         void        parse_title_from_data(void);
         // ------ override(s) ---------------------------------------------
         void        redraw(size_t cols) override;
+        auto        clone(size_t cols) const
+            -> s_ptr<Document> override;
     protected:
+        // === protected static constant(s) ===============================
+        static const size_t     STREAM_CHUNK_SIZE   = 16 * 1024;
+
         // === protected member type(s) ===================================
         class   Format;
         struct  Stacks
@@ -40,19 +69,24 @@ class   DocumentHtml : public Document
         };
 
         // === protected member variable(s) ===============================
-        string      m_data      = "";
+        ByteBuffer  m_data      = {};
         DomTree     m_dom       = {};
         size_t      m_tabWidth  = 4;// TODO: read from config
-        std::map<
-            string,
+        // indexed by the atom of the tag each appends
+        std::array<
             void (DocumentHtml::*)(
                 DomTree::node&,
                 const size_t,
                 Format,
-                Stacks&)
-        >           m_dispatcher;
+                Stacks&),
+            html_atom::COUNT
+        >           m_dispatcher    = {};
 
         // === protected mutator(s) =======================================
+        void    finish_parse(
+            std::chrono::steady_clock::duration parseTime,
+            const size_t cols
+        );
         void    append_node(
             DomTree::node& nd,
             const size_t cols,
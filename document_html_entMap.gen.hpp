@@ -0,0 +1,797 @@
+static const std::map<string, unsigned> entMap  =
+{
+	{"dollar", 36},
+	{"cent", 162},
+	{"pound", 163},
+	{"curren", 164},
+	{"yen", 165},
+	{"copy", 169},
+	{"reg", 174},
+	{"trade", 8482},
+	{"commat", 64},
+	{"Copf", 8450},
+	{"incare", 8453},
+	{"gscr", 8458},
+	{"hamilt", 8459},
+	{"Hfr", 8460},
+	{"Hopf", 8461},
+	{"planckh", 8462},
+	{"planck", 8463},
+	{"Iscr", 8464},
+	{"image", 8465},
+	{"Lscr", 8466},
+	{"ell", 8467},
+	{"Nopf", 8469},
+	{"numero", 8470},
+	{"copysr", 8471},
+	{"weierp", 8472},
+	{"Popf", 8473},
+	{"Qopf", 8474},
+	{"Rscr", 8475},
+	{"real", 8476},
+	{"Ropf", 8477},
+	{"rx", 8478},
+	{"Zopf", 8484},
+	{"mho", 8487},
+	{"Zfr", 8488},
+	{"iiota", 8489},
+	{"bernou", 8492},
+	{"Cfr", 8493},
+	{"escr", 8495},
+	{"Escr", 8496},
+	{"Fscr", 8497},
+	{"Mscr", 8499},
+	{"oscr", 8500},
+	{"alefsym", 8501},
+	{"beth", 8502},
+	{"gimel", 8503},
+	{"daleth", 8504},
+	{"DD", 8517},
+	{"dd", 8518},
+	{"ee", 8519},
+	{"ii", 8520},
+	{"starf", 9733},
+	{"star", 9734},
+	{"phone", 9742},
+	{"female", 9792},
+	{"male", 9794},
+	{"spades", 9824},
+	{"clubs", 9827},
+	{"hearts", 9829},
+	{"diams", 9830},
+	{"loz", 9674},
+	{"sung", 9834},
+	{"flat", 9837},
+	{"natural", 9838},
+	{"sharp", 9839},
+	{"check", 10003},
+	{"cross", 10007},
+	{"malt", 10016},
+	{"sext", 10038},
+	{"VerticalSeparator", 10072},
+	{"lbbrk", 10098},
+	{"rbbrk", 10099},
+	{"excl", 33},
+	{"num", 35},
+	{"percnt", 37},
+	{"amp", 38},
+	{"lpar", 40},
+	{"rpar", 41},
+	{"ast", 42},
+	{"comma", 44},
+	{"period", 46},
+	{"sol", 47},
+	{"colon", 58},
+	{"semi", 59},
+	{"quest", 63},
+	{"lbrack", 91},
+	{"bsol", 92},
+	{"rbrack", 93},
+	{"Hat", 94},
+	{"lowbar", 95},
+	{"grave", 96},
+	{"lbrace", 123},
+	{"vert", 124},
+	{"rbrace", 125},
+	{"tilde", 126},
+	{"circ", 710},
+	{"nbsp", 160},
+	{"ensp", 8194},
+	{"emsp", 8195},
+	{"thinsp", 8201},
+	{"zwnj", 8204},
+	{"zwj", 8205},
+	{"lrm", 8206},
+	{"rlm", 8207},
+	{"iexcl", 161},
+	{"brvbar", 166},
+	{"sect", 167},
+	{"uml", 168},
+	{"ordf", 170},
+	{"not", 172},
+	{"shy", 173},
+	{"macr", 175},
+	{"sup2", 178},
+	{"sup3", 179},
+	{"acute", 180},
+	{"micro", 181},
+	{"para", 182},
+	{"middot", 183},
+	{"cedil", 184},
+	{"sup1", 185},
+	{"ordm", 186},
+	{"iquest", 191},
+	{"hyphen", 8208},
+	{"ndash", 8211},
+	{"mdash", 8212},
+	{"horbar", 8213},
+	{"Vert", 8214},
+	{"dagger", 8224},
+	{"Dagger", 8225},
+	{"bull", 8226},
+	{"nldr", 8229},
+	{"hellip", 8230},
+	{"pertenk", 8241},
+	{"prime", 8242},
+	{"Prime", 8243},
+	{"tprime", 8244},
+	{"bprime", 8245},
+	{"oline", 8254},
+	{"caret", 8257},
+	{"hybull", 8259},
+	{"frasl", 8260},
+	{"bsemi", 8271},
+	{"qprime", 8279},
+	{"quot", 34},
+	{"apos", 39},
+	{"laquo", 171},
+	{"raquo", 187},
+	{"lsquo", 8216},
+	{"rsquo", 8217},
+	{"sbquo", 8218},
+	{"ldquo", 8220},
+	{"rdquo", 8221},
+	{"bdquo", 8222},
+	{"lsaquo", 8249},
+	{"rsaquo", 8250},
+	{"frac14", 188},
+	{"frac12", 189},
+	{"frac34", 190},
+	{"frac13", 8531},
+	{"frac23", 8532},
+	{"frac15", 8533},
+	{"frac25", 8534},
+	{"frac35", 8535},
+	{"frac45", 8536},
+	{"frac16", 8537},
+	{"frac56", 8538},
+	{"frac18", 8539},
+	{"frac38", 8540},
+	{"frac58", 8541},
+	{"frac78", 8542},
+	{"plus", 43},
+	{"minus", 8722},
+	{"times", 215},
+	{"divide", 247},
+	{"equals", 61},
+	{"ne", 8800},
+	{"plusmn", 177},
+	{"not", 172},
+	{"lt", 60},
+	{"gt", 62},
+	{"deg", 176},
+	{"sup1", 185},
+	{"sup2", 178},
+	{"sup3", 179},
+	{"fnof", 402},
+	{"percnt", 37},
+	{"permil", 137},
+	{"pertenk", 8241},
+	{"forall", 8704},
+	{"comp", 8705},
+	{"part", 8706},
+	{"exist", 8707},
+	{"nexist", 8708},
+	{"empty", 8709},
+	{"nabla", 8711},
+	{"isin", 8712},
+	{"notin", 8713},
+	{"ni", 8715},
+	{"notni", 8716},
+	{"prod", 8719},
+	{"coprod", 8720},
+	{"sum", 8721},
+	{"mnplus", 8723},
+	{"plusdo", 8724},
+	{"setminus", 8726},
+	{"lowast", 8727},
+	{"compfn", 8728},
+	{"radic", 8730},
+	{"prop", 8733},
+	{"infin", 8734},
+	{"angrt", 8735},
+	{"ang", 8736},
+	{"angmsd", 8737},
+	{"angsph", 8738},
+	{"mid", 8739},
+	{"nmid", 8740},
+	{"parallel", 8741},
+	{"npar", 8742},
+	{"and", 8743},
+	{"or", 8744},
+	{"cap", 8745},
+	{"cup", 8746},
+	{"int", 8747},
+	{"Int", 8748},
+	{"iiint", 8749},
+	{"conint", 8750},
+	{"Conint", 8751},
+	{"Cconint", 8752},
+	{"cwint", 8753},
+	{"cwconint", 8754},
+	{"awconint", 8755},
+	{"there4", 8756},
+	{"because", 8757},
+	{"ratio", 8758},
+	{"Colon", 8759},
+	{"minusd", 8760},
+	{"mDDot", 8762},
+	{"homtht", 8763},
+	{"sim", 8764},
+	{"bsim", 8765},
+	{"ac", 8766},
+	{"acd", 8767},
+	{"wreath", 8768},
+	{"nsim", 8769},
+	{"esim", 8770},
+	{"sime", 8771},
+	{"nsime", 8772},
+	{"cong", 8773},
+	{"simne", 8774},
+	{"ncong", 8775},
+	{"asymp", 8776},
+	{"nap", 8777},
+	{"approxeq", 8778},
+	{"apid", 8779},
+	{"bcong", 8780},
+	{"asympeq", 8781},
+	{"bump", 8782},
+	{"bumpe", 8783},
+	{"esdot", 8784},
+	{"eDot", 8785},
+	{"efDot", 8786},
+	{"erDot", 8787},
+	{"colone", 8788},
+	{"ecolon", 8789},
+	{"ecir", 8790},
+	{"cire", 8791},
+	{"wedgeq", 8793},
+	{"veeeq", 8794},
+	{"trie", 8796},
+	{"equest", 8799},
+	{"equiv", 8801},
+	{"nequiv", 8802},
+	{"le", 8804},
+	{"ge", 8805},
+	{"lE", 8806},
+	{"gE", 8807},
+	{"lnE", 8808},
+	{"gnE", 8809},
+	{"Lt", 8810},
+	{"Gt", 8811},
+	{"between", 8812},
+	{"NotCupCap", 8813},
+	{"nlt", 8814},
+	{"ngt", 8815},
+	{"nle", 8816},
+	{"nge", 8817},
+	{"lsim", 8818},
+	{"gsim", 8819},
+	{"nlsim", 8820},
+	{"ngsim", 8821},
+	{"lg", 8822},
+	{"gl", 8823},
+	{"ntlg", 8824},
+	{"ntgl", 8825},
+	{"pr", 8826},
+	{"sc", 8827},
+	{"prcue", 8828},
+	{"sccue", 8829},
+	{"prsim", 8830},
+	{"scsim", 8831},
+	{"npr", 8832},
+	{"nsc", 8833},
+	{"sub", 8834},
+	{"sup", 8835},
+	{"nsub", 8836},
+	{"nsup", 8837},
+	{"sube", 8838},
+	{"supe", 8839},
+	{"nsube", 8840},
+	{"nsupe", 8841},
+	{"subne", 8842},
+	{"supne", 8843},
+	{"cupdot", 8845},
+	{"uplus", 8846},
+	{"sqsub", 8847},
+	{"sqsup", 8848},
+	{"sqsube", 8849},
+	{"sqsupe", 8850},
+	{"sqcap", 8851},
+	{"sqcup", 8852},
+	{"oplus", 8853},
+	{"ominus", 8854},
+	{"otimes", 8855},
+	{"osol", 8856},
+	{"odot", 8857},
+	{"ocir", 8858},
+	{"oast", 8859},
+	{"odash", 8861},
+	{"plusb", 8862},
+	{"minusb", 8863},
+	{"timesb", 8864},
+	{"sdotb", 8865},
+	{"vdash", 8866},
+	{"dashv", 8867},
+	{"top", 8868},
+	{"perp", 8869},
+	{"models", 8871},
+	{"vDash", 8872},
+	{"Vdash", 8873},
+	{"Vvdash", 8874},
+	{"VDash", 8875},
+	{"nvdash", 8876},
+	{"nvDash", 8877},
+	{"nVdash", 8878},
+	{"nVDash", 8879},
+	{"prurel", 8880},
+	{"vltri", 8882},
+	{"vrtri", 8883},
+	{"ltrie", 8884},
+	{"rtrie", 8885},
+	{"origof", 8886},
+	{"imof", 8887},
+	{"mumap", 8888},
+	{"hercon", 8889},
+	{"intcal", 8890},
+	{"veebar", 8891},
+	{"barvee", 8893},
+	{"angrtvb", 8894},
+	{"lrtri", 8895},
+	{"xwedge", 8896},
+	{"xvee", 8897},
+	{"xcap", 8898},
+	{"xcup", 8899},
+	{"diamond", 8900},
+	{"sdot", 8901},
+	{"Star", 8902},
+	{"divonx", 8903},
+	{"bowtie", 8904},
+	{"ltimes", 8905},
+	{"rtimes", 8906},
+	{"lthree", 8907},
+	{"rthree", 8908},
+	{"bsime", 8909},
+	{"cuvee", 8910},
+	{"cuwed", 8911},
+	{"Sub", 8912},
+	{"Sup", 8913},
+	{"Cap", 8914},
+	{"Cup", 8915},
+	{"fork", 8916},
+	{"epar", 8917},
+	{"ltdot", 8918},
+	{"gtdot", 8919},
+	{"Ll", 8920},
+	{"Gg", 8921},
+	{"leg", 8922},
+	{"gel", 8923},
+	{"cuepr", 8926},
+	{"cuesc", 8927},
+	{"nprcue", 8928},
+	{"nsccue", 8929},
+	{"nsqsube", 8930},
+	{"nsqsupe", 8931},
+	{"lnsim", 8934},
+	{"gnsim", 8935},
+	{"prnsim", 8936},
+	{"scnsim", 8937},
+	{"nltri", 8938},
+	{"nrtri", 8939},
+	{"nltrie", 8940},
+	{"nrtrie", 8941},
+	{"vellip", 8942},
+	{"ctdot", 8943},
+	{"utdot", 8944},
+	{"dtdot", 8945},
+	{"disin", 8946},
+	{"isinsv", 8947},
+	{"isins", 8948},
+	{"isindot", 8949},
+	{"notinvc", 8950},
+	{"notinvb", 8951},
+	{"isinE", 8953},
+	{"nisd", 8954},
+	{"xnis", 8955},
+	{"nis", 8956},
+	{"notnivc", 8957},
+	{"notnivb", 8958},
+	{"lceil", 8968},
+	{"rceil", 8969},
+	{"lfloor", 8970},
+	{"rfloor", 8971},
+	{"lang", 9001},
+	{"rang", 9002},
+	{"Alpha", 913},
+	{"Beta", 914},
+	{"Gamma", 915},
+	{"Delta", 916},
+	{"Epsilon", 917},
+	{"Zeta", 918},
+	{"Eta", 919},
+	{"Theta", 920},
+	{"Iota", 921},
+	{"Kappa", 922},
+	{"Lambda", 923},
+	{"Mu", 924},
+	{"Nu", 925},
+	{"Xi", 926},
+	{"Omicron", 927},
+	{"Pi", 928},
+	{"Rho", 929},
+	{"Sigma", 931},
+	{"Tau", 932},
+	{"Upsilon", 933},
+	{"Phi", 934},
+	{"Chi", 935},
+	{"Psi", 936},
+	{"Omega", 937},
+	{"alpha", 945},
+	{"beta", 946},
+	{"gamma", 947},
+	{"delta", 948},
+	{"epsilon", 949},
+	{"zeta", 950},
+	{"eta", 951},
+	{"theta", 952},
+	{"iota", 953},
+	{"kappa", 954},
+	{"lambda", 955},
+	{"mu", 956},
+	{"nu", 957},
+	{"xi", 958},
+	{"omicron", 959},
+	{"pi", 960},
+	{"rho", 961},
+	{"sigmaf", 962},
+	{"sigma", 963},
+	{"tau", 964},
+	{"upsilon", 965},
+	{"phi", 966},
+	{"chi", 967},
+	{"psi", 968},
+	{"omega", 969},
+	{"thetasym", 977},
+	{"upsih", 978},
+	{"piv", 982},
+	{"Agrave", 192},
+	{"Aacute", 193},
+	{"Acirc", 194},
+	{"Atilde", 195},
+	{"Auml", 196},
+	{"Aring", 197},
+	{"AElig", 198},
+	{"Ccedil", 199},
+	{"Egrave", 200},
+	{"Eacute", 201},
+	{"Ecirc", 202},
+	{"Euml", 203},
+	{"Lgrave", 204},
+	{"Lacute", 313},
+	{"Lcirc", 206},
+	{"Luml", 207},
+	{"ETH", 208},
+	{"Ntilde", 209},
+	{"Ograve", 210},
+	{"Oacute", 211},
+	{"Ocirc", 212},
+	{"Otilde", 213},
+	{"Ouml", 214},
+	{"Oslash", 216},
+	{"Ugrave", 217},
+	{"Uacute", 218},
+	{"Ucirc", 219},
+	{"Uuml", 220},
+	{"Yacute", 221},
+	{"THORN", 222},
+	{"szlig", 223},
+	{"agrave", 224},
+	{"aacute", 225},
+	{"acirc", 226},
+	{"atilde", 227},
+	{"auml", 228},
+	{"aring", 229},
+	{"aelig", 230},
+	{"ccedil", 231},
+	{"egrave", 232},
+	{"eacute", 233},
+	{"ecirc", 234},
+	{"euml", 235},
+	{"igrave", 236},
+	{"iacute", 237},
+	{"icirc", 238},
+	{"iuml", 239},
+	{"eth", 240},
+	{"ntilde", 241},
+	{"ograve", 242},
+	{"oacute", 243},
+	{"ocirc", 244},
+	{"otilde", 245},
+	{"ouml", 246},
+	{"oslash", 248},
+	{"ugrave", 249},
+	{"uacute", 250},
+	{"ucirc", 251},
+	{"uuml", 252},
+	{"yacute", 253},
+	{"thorn", 254},
+	{"yuml", 255},
+	{"Amacr", 256},
+	{"amacr", 257},
+	{"Abreve", 258},
+	{"abreve", 259},
+	{"Aogon", 260},
+	{"aogon", 261},
+	{"Cacute", 262},
+	{"cacute", 263},
+	{"Ccirc", 264},
+	{"ccirc", 265},
+	{"Cdot", 266},
+	{"cdot", 267},
+	{"Ccaron", 268},
+	{"ccaron", 269},
+	{"Dcaron", 270},
+	{"dcaron", 271},
+	{"Dstrok", 272},
+	{"dstrok", 273},
+	{"Emacr", 274},
+	{"emacr", 275},
+	{"Edot", 278},
+	{"edot", 279},
+	{"Eogon", 280},
+	{"eogon", 281},
+	{"Ecaron", 282},
+	{"ecaron", 283},
+	{"Gcirc", 284},
+	{"gcirc", 285},
+	{"Gbreve", 286},
+	{"gbreve", 287},
+	{"Gdot", 288},
+	{"gdot", 289},
+	{"Gcedil", 290},
+	{"Hcirc", 292},
+	{"hcirc", 293},
+	{"Hstrok", 294},
+	{"hstrok", 295},
+	{"Itilde", 296},
+	{"itilde", 297},
+	{"Imacr", 298},
+	{"imacr", 299},
+	{"Iogon", 302},
+	{"iogon", 303},
+	{"Idot", 304},
+	{"imath", 305},
+	{"IJlig", 306},
+	{"ijlig", 307},
+	{"Jcirc", 308},
+	{"jcirc", 309},
+	{"Kcedil", 310},
+	{"kcedil", 311},
+	{"kgreen", 312},
+	{"lacute", 314},
+	{"Lcedil", 315},
+	{"lcedil", 316},
+	{"Lcaron", 317},
+	{"lcaron", 318},
+	{"Lmidot", 319},
+	{"lmidot", 320},
+	{"Lstrok", 321},
+	{"lstrok", 322},
+	{"Nacute", 323},
+	{"nacute", 324},
+	{"Ncedil", 325},
+	{"ncedil", 326},
+	{"Ncaron", 327},
+	{"ncaron", 328},
+	{"napos", 329},
+	{"ENG", 330},
+	{"eng", 331},
+	{"Omacr", 332},
+	{"omacr", 333},
+	{"Odblac", 336},
+	{"odblac", 337},
+	{"OElig", 338},
+	{"oelig", 339},
+	{"Racute", 340},
+	{"racute", 341},
+	{"Rcedil", 342},
+	{"rcedil", 343},
+	{"Rcaron", 344},
+	{"rcaron", 345},
+	{"Sacute", 346},
+	{"sacute", 347},
+	{"Scirc", 348},
+	{"scirc", 349},
+	{"Scedil", 350},
+	{"scedil", 351},
+	{"Scaron", 352},
+	{"scaron", 353},
+	{"Tcedil", 354},
+	{"tcedil", 355},
+	{"Tcaron", 356},
+	{"tcaron", 357},
+	{"Tstrok", 358},
+	{"tstrok", 359},
+	{"Utilde", 360},
+	{"utilde", 361},
+	{"Umacr", 362},
+	{"umacr", 363},
+	{"Ubreve", 364},
+	{"ubreve", 365},
+	{"Uring", 366},
+	{"uring", 367},
+	{"Udblac", 368},
+	{"udblac", 369},
+	{"Uogon", 370},
+	{"uogon", 371},
+	{"Wcirc", 372},
+	{"wcirc", 373},
+	{"Ycirc", 374},
+	{"ycirc", 375},
+	{"Yuml", 376},
+	{"Zacute", 377},
+	{"zacute", 378},
+	{"Zdot", 379},
+	{"zdot", 380},
+	{"Zcaron", 381},
+	{"zcaron", 382},
+	{"DownBreve", 785},
+	{"olarr", 8634},
+	{"orarr", 8635},
+	{"lharu", 8636},
+	{"lhard", 8637},
+	{"uharr", 8638},
+	{"uharl", 8639},
+	{"rharu", 8640},
+	{"rhard", 8641},
+	{"dharr", 8642},
+	{"dharl", 8643},
+	{"rlarr", 8644},
+	{"udarr", 8645},
+	{"lrarr", 8646},
+	{"llarr", 8647},
+	{"uuarr", 8648},
+	{"rrarr", 8649},
+	{"ddarr", 8650},
+	{"lrhar", 8651},
+	{"rlhar", 8652},
+	{"nlArr", 8653},
+	{"nhArr", 8654},
+	{"nrArr", 8655},
+	{"lArr", 8656},
+	{"uArr", 8657},
+	{"rArr", 8658},
+	{"dArr", 8659},
+	{"hArr", 8660},
+	{"vArr", 8661},
+	{"nwArr", 8662},
+	{"neArr", 8663},
+	{"seArr", 8664},
+	{"swArr", 8665},
+	{"lAarr", 8666},
+	{"rAarr", 8667},
+	{"ziglarr", 8668},
+	{"zigrarr", 8669},
+	{"larrb", 8676},
+	{"rarrb", 8677},
+	{"duarr", 8693},
+	{"hoarr", 8703},
+	{"loarr", 8701},
+	{"roarr", 8702},
+	{"xlarr", 10229},
+	{"xrarr", 10230},
+	{"xharr", 10231},
+	{"xlArr", 10232},
+	{"xrArr", 10233},
+	{"xhArr", 10234},
+	{"dzigrarr", 10239},
+	{"xmap", 10236},
+	{"nvlArr", 10498},
+	{"nvrArr", 10499},
+	{"nvHarr", 10500},
+	{"Map", 10501},
+	{"lbarr", 10508},
+	{"rbarr", 10509},
+	{"lBarr", 10510},
+	{"rBarr", 10511},
+	{"RBarr", 10512},
+	{"DDotrahd", 10513},
+	{"UpArrowBar", 10514},
+	{"DownArrowBar", 10515},
+	{"Rarrtl", 10518},
+	{"latail", 10521},
+	{"ratail", 10522},
+	{"lAtail", 10523},
+	{"rAtail", 10524},
+	{"larrfs", 10525},
+	{"rarrfs", 10526},
+	{"larrbfs", 10527},
+	{"rarrbfs", 10528},
+	{"nwarhk", 10531},
+	{"nearhk", 10532},
+	{"searhk", 10533},
+	{"swarhk", 10534},
+	{"nwnear", 10535},
+	{"nesear", 10536},
+	{"seswar", 10537},
+	{"swnwar", 10538},
+	{"cudarrr", 10549},
+	{"ldca", 10550},
+	{"rdca", 10551},
+	{"cudarrl", 10552},
+	{"larrpl", 10553},
+	{"curarrm", 10556},
+	{"cularrp", 10557},
+	{"rarrpl", 10565},
+	{"harrcir", 10568},
+	{"Uarrocir", 10569},
+	{"lurdshar", 10570},
+	{"ldrushar", 10571},
+	{"RightUpDownVector", 10575},
+	{"DownLeftRightVector", 10576},
+	{"LeftUpDownVector", 10577},
+	{"LeftVectorBar", 10578},
+	{"RightVectorBar", 10579},
+	{"RightUpVectorBar", 10580},
+	{"RightDownVectorBar", 10581},
+	{"DownLeftVectorBar", 10582},
+	{"DownRightVectorBar", 10583},
+	{"LeftUpVectorBar", 10584},
+	{"LeftDownVectorBar", 10585},
+	{"LeftTeeVector", 10586},
+	{"RightTeeVector", 10587},
+	{"RightUpTeeVector", 10588},
+	{"RightDownTeeVector", 10589},
+	{"DownLeftTeeVector", 10590},
+	{"DownRightTeeVector", 10591},
+	{"LeftUpTeeVector", 10592},
+	{"LeftDownTeeVector", 10593},
+	{"lHar", 10594},
+	{"uHar", 10595},
+	{"rHar", 10596},
+	{"dHar", 10597},
+	{"luruhar", 10598},
+	{"ldrdhar", 10599},
+	{"ruluhar", 10600},
+	{"rdldhar", 10601},
+	{"lharul", 10602},
+	{"llhard", 10603},
+	{"rharul", 10604},
+	{"lrhard", 10605},
+	{"udhar", 10606},
+	{"duhar", 10607},
+	{"RoundImplies", 10608},
+	{"erarr", 10609},
+	{"simrarr", 10610},
+	{"larrsim", 10611},
+	{"rarrsim", 10612},
+	{"rarrap", 10613},
+	{"ltlarr", 10614},
+	{"gtrarr", 10616},
+	{"subrarr", 10617},
+	{"suplarr", 10619},
+	{"lfisht", 10620},
+	{"rfisht", 10621},
+	{"ufisht", 10622},
+	{"dfisht", 10623},
+};// end static const std::map<string, unsigned>   entMap
@@ -1,8 +1,11 @@
+#include <chrono>
 #include <cstdio>
+#include <iterator>
 #include <sstream>
 
 #include "deps.hpp"
 #include "utils.hpp"
+#include "byte_buffer.hpp"
 #include "document.hpp"
 #include "document_text.hpp"
 
@@ -31,25 +34,49 @@ DocumentText::DocumentText(
     from_string(text, cols);
 }// end DocumentText(const string& text, const size_t cols)
 
+DocumentText::DocumentText(
+    const Document::Config& cfg,
+    const ByteBuffer& data,
+    const size_t cols
+) : DocumentText(cfg)
+{
+    from_buffer(data, cols);
+}// end DocumentText(const ByteBuffer& data, const size_t cols)
+
 // === public mutator(s) ==========================================
 void        DocumentText::from_stream(std::istream& ins, const size_t cols)
 {
-    std::getline(ins, m_data, static_cast<char>(EOF));
-    redraw(cols);
+    using namespace std;
+
+    ByteBuffer::container   data(
+                                (istreambuf_iterator<char>(ins)),
+                                istreambuf_iterator<char>()
+                            );
+
+    from_buffer(std::move(data), cols);
 }// end DocumentText::from_stream(std::istream& ins, const size_t cols)
 
 void        DocumentText::from_string(const string& text, const size_t cols)
 {
-    m_data = text;
-    redraw(cols);
+    from_buffer(text, cols);
 }// end DocumentText::from_string(const string& text, const size_t cols)
 
+// Shares the given buffer, rather than copying it.
+void        DocumentText::from_buffer(const ByteBuffer& data, const size_t cols)
+{
+    const auto      start   = std::chrono::steady_clock::now();
+
+    m_data = data;
+    redraw(cols);
+    m_stats.layoutTime = std::chrono::steady_clock::now() - start;
+}// end DocumentText::from_buffer(const ByteBuffer& data, const size_t cols)
+
 // ------ override(s) ---------------------------------------------
 void        DocumentText::redraw(size_t cols)
 {
     using namespace std;
 
-    istringstream       inBuf(m_data);
+    ByteBuffer::Reader  inBuf(m_data);
     wstring             currLine        = wstring();
 
     m_buffer.clear();
@@ -118,3 +145,14 @@ void        DocumentText::redraw(size_t cols)
         }// end switch (inBuf.peek())
     }// end while (inBuf)
 }// end DocumentText::redraw(size_t cols)
+
+// Returns a copy of the document, laid out to <cols> columns, which
+// shares only the (immutable) source.
+auto        DocumentText::clone(size_t cols) const -> s_ptr<Document>
+{
+    s_ptr<DocumentText>     out(new DocumentText(m_config, m_data, cols));
+
+    out->m_title = m_title;
+
+    return out;
+}// end DocumentText::clone(size_t cols) const -> s_ptr<Document>
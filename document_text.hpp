@@ -2,6 +2,7 @@
 #define __DOCUMENT_TEXT_HPP__
 
 #include "deps.hpp"
+#include "byte_buffer.hpp"
 #include "document.hpp"
 
 // === class DocumentText =================================================
@@ -22,6 +23,11 @@ class   DocumentText : public Document
             const string& text,
             const size_t cols
         );// type 2
+        DocumentText(
+            const Document::Config& cfg,
+            const ByteBuffer& data,
+            const size_t cols
+        );// type 3
 
         // === public mutator(s) ==========================================
         void    from_stream(
@@ -32,11 +38,17 @@ class   DocumentText : public Document
             const string& text,
             const size_t cols
         );
+        void    from_buffer(
+            const ByteBuffer& data,
+            const size_t cols
+        );
         // ------ override(s) ---------------------------------------------
         void        redraw(size_t cols) override;
+        auto        clone(size_t cols) const
+            -> s_ptr<Document> override;
     protected:
         // === protected member variable(s) ===============================
-        string      m_data      = "";
+        ByteBuffer  m_data      = {};
 };// end class DocumentText : public Document
 
 #endif
@@ -161,6 +161,7 @@ void        DomTree::destruct(void)
 NODE_T::node(const string& identifier, const string& text)
 {
     m_identifier = identifier;
+    m_atom = html_atom::intern(identifier);
     m_text = text;
 }// end NODE_T::node(const string& identifier, const string& text)
 
@@ -238,6 +239,16 @@ auto        NODE_T::identifier(void) const -> const string&
     return m_identifier;
 }// end NODE_T::identifier(void) const -> const string&
 
+// === NODE_T::atom(void) const -> HtmlAtom ===============================
+//
+// The interned identifier (HtmlAtom::none if it isn't a known html tag).
+//
+// ========================================================================
+auto        NODE_T::atom(void) const -> HtmlAtom
+{
+    return m_atom;
+}// end NODE_T::atom(void) const -> HtmlAtom
+
 // === NODE_T::text(void) const -> const string& ==========================
 //
 // ========================================================================
@@ -564,8 +575,8 @@ std::ostream& operator<<(std::ostream& outs, const NODE_T& nd)
         outs << "<" << nd.m_identifier;
         if (!nd.attributes.empty())
         {
-            for (auto p : nd.attributes)
-                outs << ' ' << p.first << "=\"" << p.second << '"';
+            for (const auto& attr : nd.attributes)
+                outs << ' ' << attr.name << "=\"" << attr.value << '"';
         }
         outs << "> (" << nd.m_children.size() << ' '
             << (nd.m_children.size() == 1 ? "child" : "children")
@@ -595,6 +606,7 @@ void        NODE_T::copy_from(const node& other)
     }
     attributes = other.attributes;
     m_identifier = other.m_identifier;
+    m_atom = other.m_atom;
     m_text = other.m_text;
     m_nDescendants = other.m_nDescendants;
 }// end NODE_T::copy_from(const node& other)
@@ -613,6 +625,7 @@ void        NODE_T::move_from(node& other)
     }
     attributes = other.attributes;
     m_identifier = other.m_identifier;
+    m_atom = other.m_atom;
     m_text = other.m_text;
     m_nDescendants = other.m_nDescendants;
 }// end NODE_T::move_from(node&& other)
@@ -22,9 +22,10 @@
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 #include <list>
-#include <map>
 
 #include "deps.hpp"
+#include "html_atom.hpp"
+#include "html_attributes.hpp"
 
 class   DomTree
 {
@@ -102,7 +103,7 @@ class   DomTree::node
         class   text_node_childless;
 
         // === public member variable(s) ==================================
-        std::map<string,string>     attributes;
+        HtmlAttributes              attributes;
 
         // === public constructor(s) ======================================
         node(const string& identifier, const string& text = "");// type
@@ -118,6 +119,7 @@ class   DomTree::node
         size_t      size(void) const;
         bool        is_text(void) const;
         auto        identifier(void) const -> const string&;
+        auto        atom(void) const -> HtmlAtom;
         auto        text(void) const -> const string&;
         auto        parent(void) const -> const node*;
         auto        child_front(void) const -> const node&;
@@ -171,6 +173,7 @@ class   DomTree::node
         node                        *m_parent           = nullptr;
         std::list<node>             m_children;
         string                      m_identifier        = "";
+        HtmlAtom                    m_atom              = HtmlAtom::none;
         string                      m_text              = "";
         size_t                      m_nDescendants      = 0;
 
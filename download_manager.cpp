@@ -0,0 +1,580 @@
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <sstream>
+#include <iomanip>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+
+#include "deps.hpp"
+#include "uri.hpp"
+#include "http_fetcher.hpp"
+#include "fetch_scheduler.hpp"
+
+#include "download_manager.hpp"
+
+// === struct DownloadManager::Download Implementation ====================
+//
+// ========================================================================
+
+// return: true if the download is waiting to start or in progress
+auto DownloadManager::Download::active(void) const
+    -> bool
+{
+    return (State::queued == state) or (State::running == state);
+}// end DownloadManager::Download::active
+
+// return: bytes per second saved since the download was last (re)started,
+//  or 0 if it isn't running
+auto DownloadManager::Download::rate(clock_type::time_point now) const
+    -> double
+{
+    const double    secs    = std::chrono::duration<double>(now - runStart)
+                                .count();
+
+    if ((State::running != state) or (secs <= 0) or (bytes < runBytes))
+    {
+        return 0;
+    }
+
+    return (bytes - runBytes) / secs;
+}// end DownloadManager::Download::rate
+
+// return: estimated seconds until the download is complete, or -1 if its
+//  size or rate is unknown
+auto DownloadManager::Download::eta(clock_type::time_point now) const
+    -> double
+{
+    const double    bps     = rate(now);
+
+    if ((not total) or (bps <= 0) or (bytes > total))
+    {
+        return -1;
+    }
+
+    return (total - bytes) / bps;
+}// end DownloadManager::Download::eta
+
+// === class DownloadManager Implementation ===============================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+DownloadManager::DownloadManager(void)
+{
+    // do nothing
+}// end DownloadManager::DownloadManager
+
+DownloadManager::~DownloadManager(void)
+{
+    clear();
+}// end DownloadManager::~DownloadManager
+
+// --- public accessors ---------------------------------------------------
+auto DownloadManager::downloads(void) const
+    -> const download_container&
+{
+    return m_downloads;
+}// end DownloadManager::downloads
+
+// return: download with the given id, or nullptr if there is none
+auto DownloadManager::find(size_t id) const
+    -> const Download*
+{
+    for (const auto& dl : m_downloads)
+    {
+        if (dl.id == id)
+        {
+            return &dl;
+        }
+    }// end for dl
+
+    return nullptr;
+}// end DownloadManager::find
+
+// return: number of downloads waiting to start or in progress
+auto DownloadManager::running(void) const
+    -> size_t
+{
+    return std::count_if(
+        m_downloads.begin(),
+        m_downloads.end(),
+        [](const Download& dl) { return dl.active(); }
+    );
+}// end DownloadManager::running
+
+// Adds the file descriptors of running downloads to a poll set.
+void DownloadManager::get_pollfds(std::vector<struct pollfd>& fds) const
+{
+    for (const auto& dl : m_downloads)
+    {
+        const auto      *transfer   = dl.job ? dl.job->transfer.get()
+                                                : nullptr;
+
+        if ((not transfer) or transfer->finished())
+        {
+            continue;
+        }
+
+        fds.push_back({ transfer->fd(), POLLIN, 0 });
+        if (transfer->write_fd() >= 0)
+        {
+            fds.push_back({ transfer->write_fd(), POLLOUT, 0 });
+        }
+    }// end for dl
+}// end DownloadManager::get_pollfds
+
+// Formats the downloads as a plain text list, one entry per download:
+//
+//  [<id>] <state> <path>
+//      <url>
+//      <saved> / <size> (<percent>%) <rate>/s, <eta> left
+//
+//  return: the list, or a note that there are no downloads
+auto DownloadManager::format_list(clock_type::time_point now) const
+    -> string
+{
+    std::stringstream   fmt;
+
+    if (m_downloads.empty())
+    {
+        return "No downloads.\n";
+    }
+
+    for (const auto& dl : m_downloads)
+    {
+        const double    eta     = dl.eta(now);
+
+        fmt << "[" << dl.id << "] " << state_name(dl.state) << " "
+            << dl.path << "\n";
+        fmt << "    " << dl.url.str() << "\n";
+        fmt << "    " << format_size(dl.bytes);
+        if (dl.total)
+        {
+            fmt << " / " << format_size(dl.total)
+                << " (" << (100 * dl.bytes / dl.total) << "%)";
+        }
+        if (State::running == dl.state)
+        {
+            fmt << " " << format_size(dl.rate(now)) << "/s";
+            if (eta >= 0)
+            {
+                const long  secs    = eta + 0.5;
+
+                fmt << ", " << (secs / 3600) << ":"
+                    << std::setw(2) << std::setfill('0') << (secs / 60 % 60)
+                    << ":"
+                    << std::setw(2) << std::setfill('0') << (secs % 60)
+                    << std::setfill(' ') << " left";
+            }
+        }
+        if (not dl.error.empty())
+        {
+            fmt << " (" << dl.error << ")";
+        }
+        fmt << "\n\n";
+    }// end for dl
+
+    return fmt.str();
+}// end DownloadManager::format_list
+
+// --- public mutators ----------------------------------------------------
+
+// Starts saving a url to a file; whatever is at <path> is replaced.
+//  return: id of the new download
+auto DownloadManager::add(
+    FetchScheduler& scheduler,
+    const HttpFetcher& fetcher,
+    const Uri& url,
+    const string& path
+) -> size_t
+{
+    Download        dl      = {};
+
+    dl.id = m_nextId++;
+    dl.url = url;
+    dl.path = path;
+    dl.fetcher = &fetcher;
+
+    m_downloads.push_back(std::move(dl));
+    start(scheduler, m_downloads.back());
+
+    return m_downloads.back().id;
+}// end DownloadManager::add
+
+// Stops a download, keeping what has been saved so far.
+//  return: false if there is no such download, or it isn't in progress
+auto DownloadManager::pause(size_t id)
+    -> bool
+{
+    auto    iter    = find_iter(id);
+
+    if ((iter == m_downloads.end()) or (not iter->active()))
+    {
+        return false;
+    }
+
+    stop(*iter, State::paused);
+
+    return true;
+}// end DownloadManager::pause
+
+// Restarts a paused or failed download: from where it left off, if the
+// handler can send part of it, otherwise from the start.
+//  return: false if there is no such download, or it is already running
+//  or done
+auto DownloadManager::resume(FetchScheduler& scheduler, size_t id)
+    -> bool
+{
+    auto    iter    = find_iter(id);
+
+    if (
+        (iter == m_downloads.end())
+        or iter->active()
+        or (State::done == iter->state)
+    )
+    {
+        return false;
+    }
+
+    iter->error.clear();
+    start(scheduler, *iter);
+
+    return true;
+}// end DownloadManager::resume
+
+// Forgets a download, stopping it if it is in progress. The file is kept.
+//  return: false if there is no such download
+auto DownloadManager::remove(size_t id)
+    -> bool
+{
+    auto    iter    = find_iter(id);
+
+    if (iter == m_downloads.end())
+    {
+        return false;
+    }
+
+    stop(*iter, State::paused);
+    m_downloads.erase(iter);
+
+    return true;
+}// end DownloadManager::remove
+
+// Reads pending output from running downloads without blocking, saving
+// it to their files, and follows any redirects.
+//  return: ids of downloads that finished (or failed) during the call
+auto DownloadManager::update(FetchScheduler& scheduler)
+    -> std::vector<size_t>
+{
+    std::vector<size_t>     finished    = {};
+
+    for (auto& dl : m_downloads)
+    {
+        HttpFetcher::Transfer   *transfer;
+
+        if (not dl.active())
+        {
+            continue;
+        }
+
+        if (not dl.job->error.empty())
+        {
+            stop(dl, State::failed, dl.job->error);
+            finished.push_back(dl.id);
+            continue;
+        }
+
+        if (not (transfer = dl.job->transfer.get()))
+        {
+            continue;
+        }
+
+        if (State::queued == dl.state)
+        {
+            dl.state = State::running;
+            dl.runStart = clock_type::now();
+            dl.runBytes = dl.bytes;
+        }
+
+        transfer->update();
+
+        if ((dl.fd < 0) and transfer->headers_ready())
+        {
+            if (not begin_body(scheduler, dl))
+            {
+                if (not dl.active())
+                {
+                    finished.push_back(dl.id);
+                }
+                continue;
+            }
+        }
+
+        if (dl.fd >= 0)
+        {
+            const off_t     pos     = lseek(dl.fd, 0, SEEK_CUR);
+
+            dl.bytes = (pos > 0) ? pos : 0;
+        }
+
+        if (not transfer->finished())
+        {
+            continue;
+        }
+
+        if (HttpFetcher::Transfer::State::done != transfer->state())
+        {
+            stop(dl, State::failed, "transfer interrupted");
+        }
+        else if (dl.total and (dl.bytes < dl.total))
+        {
+            stop(dl, State::failed, "incomplete");
+        }
+        else
+        {
+            stop(dl, State::done);
+        }
+        finished.push_back(dl.id);
+    }// end for dl
+
+    return finished;
+}// end DownloadManager::update
+
+// Stops all downloads and forgets them.
+void DownloadManager::clear(void)
+{
+    for (auto& dl : m_downloads)
+    {
+        stop(dl, dl.active() ? State::paused : dl.state);
+    }// end for dl
+
+    m_downloads.clear();
+}// end DownloadManager::clear
+
+// --- public static functions --------------------------------------------
+
+// return: a byte count in human-readable units (i.e. "1.5 MiB")
+auto DownloadManager::format_size(double bytes)
+    -> string
+{
+    static const char   *units[]    = { "B", "KiB", "MiB", "GiB", "TiB" };
+    size_t              unit        = 0;
+    char                buf[32];
+
+    while ((bytes >= 1024) and (unit + 1 < sizeof(units) / sizeof(*units)))
+    {
+        bytes /= 1024;
+        ++unit;
+    }// end while
+
+    snprintf(
+        buf,
+        sizeof(buf),
+        unit ? "%.1f %s" : "%.0f %s",
+        bytes,
+        units[unit]
+    );
+
+    return buf;
+}// end DownloadManager::format_size
+
+auto DownloadManager::state_name(State state)
+    -> const char*
+{
+    switch (state)
+    {
+        case State::queued:
+            return "queued";
+        case State::running:
+            return "running";
+        case State::paused:
+            return "paused";
+        case State::done:
+            return "done";
+        case State::failed:
+            return "failed";
+    }// end switch
+
+    return "unknown";
+}// end DownloadManager::state_name
+
+// --- private accessors --------------------------------------------------
+auto DownloadManager::find_iter(size_t id)
+    -> download_container::iterator
+{
+    return std::find_if(
+        m_downloads.begin(),
+        m_downloads.end(),
+        [id](const Download& dl) { return dl.id == id; }
+    );
+}// end DownloadManager::find_iter
+
+// --- private mutators ---------------------------------------------------
+
+// Submits a request for a download: for the rest of it, from the end of
+// what is already saved, if the handler has said it can send only part of
+// it; otherwise for all of it. The file is left as it is until a response
+// arrives (see begin_body). The body is always asked for unencoded, so
+// that its size is known and it can be resumed.
+void DownloadManager::start(FetchScheduler& scheduler, Download& dl)
+{
+    HttpFetcher::env_map    env     = {
+        { "W3M_REQUEST_METHOD", "GET" },
+        { "W3M_ACCEPT_ENCODING", "identity" },
+    };
+    struct stat             st;
+
+    dl.bytes = 0;
+    if (
+        dl.resumable
+        and (0 == stat(dl.path.c_str(), &st))
+        and (st.st_size > 0)
+    )
+    {
+        dl.bytes = st.st_size;
+        env["W3M_RANGE"] = "bytes=" + std::to_string(dl.bytes) + "-";
+    }
+
+    dl.state = State::queued;
+    dl.job = scheduler.submit(
+        FetchScheduler::Priority::download,
+        *dl.fetcher,
+        dl.url,
+        {},
+        env
+    );
+}// end DownloadManager::start
+
+// Decides what to do with a response once its headers are in: follow a
+// redirect, or open the file and send the body to it, appending to what is
+// saved if the handler sent only the rest.
+//  return: true if the body is being saved
+auto DownloadManager::begin_body(FetchScheduler& scheduler, Download& dl)
+    -> bool
+{
+    auto&           transfer    = *dl.job->transfer;
+    const auto&     headers     = transfer.headers();
+    const int       code        = transfer.status().code;
+    size_t          offset      = 0;
+    size_t          length      = 0;
+
+    if ((code >= 300) and (code < 400) and (not headers.location().empty()))
+    {
+        if (++dl.redirects > MAX_REDIRECTS)
+        {
+            stop(dl, State::failed, "too many redirects");
+            return false;
+        }
+
+        dl.url = Uri::from_relative(dl.url, string(headers.location()));
+        start(scheduler, dl);
+        return false;
+    }
+
+    // already saved in full
+    if ((416 == code) and dl.bytes)
+    {
+        dl.total = dl.bytes;
+        stop(dl, State::done);
+        return false;
+    }
+
+    if (206 == code)
+    {
+        const string    range(headers.get("content-range"));
+        unsigned long   first;
+        unsigned long   last;
+        unsigned long   size;
+
+        if (
+            sscanf(range.c_str(), " bytes %lu-%lu/%lu", &first, &last, &size)
+            == 3
+        )
+        {
+            dl.total = size;
+        }
+        else if (
+            sscanf(range.c_str(), " bytes %lu-%lu", &first, &last) != 2
+        )
+        {
+            stop(dl, State::failed, "bad content-range");
+            return false;
+        }
+
+        // a part that can't be decoded on its own, or leaves a gap
+        if (transfer.decoding() or (first > dl.bytes))
+        {
+            dl.resumable = false;
+            stop(dl, State::failed, "range does not match");
+            return false;
+        }
+
+        offset = first;
+        dl.resumable = true;
+    }
+    else if ((code) and ((code < 200) or (code >= 300)))
+    {
+        stop(dl, State::failed, "status " + std::to_string(code));
+        return false;
+    }
+    else
+    {
+        // the length of a decompressed body isn't known in advance, and the
+        // handler can't be asked for part of it
+        dl.total = (not transfer.decoding())
+                    and headers.content_length(length) ? length : 0;
+        dl.resumable = (not transfer.decoding())
+                        and ("bytes" == headers.get("accept-ranges"));
+    }
+
+    dl.fd = ::open(
+        dl.path.c_str(),
+        O_WRONLY | O_CREAT | O_CLOEXEC,
+        0644
+    );
+    if (
+        (dl.fd < 0)
+        or (ftruncate(dl.fd, offset) < 0)
+        or (lseek(dl.fd, offset, SEEK_SET) < 0)
+    )
+    {
+        stop(dl, State::failed, "could not write " + dl.path);
+        return false;
+    }
+
+    dl.bytes = offset;
+    dl.runBytes = std::min(dl.runBytes, offset);
+
+    if (not transfer.set_sink(dl.fd))
+    {
+        stop(dl, State::failed, "could not write " + dl.path);
+        return false;
+    }
+
+    return true;
+}// end DownloadManager::begin_body
+
+// Ends a download's current run, killing its transfer if it is still
+// going and closing its file.
+void DownloadManager::stop(Download& dl, State state, const string& error)
+{
+    dl.job = nullptr;
+    if (dl.fd >= 0)
+    {
+        const off_t     pos     = lseek(dl.fd, 0, SEEK_CUR);
+
+        dl.bytes = (pos > 0) ? pos : dl.bytes;
+        close(dl.fd);
+        dl.fd = -1;
+    }
+
+    dl.state = state;
+    if (not error.empty())
+    {
+        dl.error = error;
+    }
+}// end DownloadManager::stop
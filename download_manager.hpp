@@ -0,0 +1,133 @@
+#ifndef __DOWNLOAD_MANAGER_HPP__
+#define __DOWNLOAD_MANAGER_HPP__
+
+#include <chrono>
+#include <list>
+
+#include <poll.h>
+
+#include "deps.hpp"
+#include "uri.hpp"
+#include "http_fetcher.hpp"
+#include "fetch_scheduler.hpp"
+
+// === class DownloadManager ==============================================
+//
+// Saves urls to files in the background, while the user keeps browsing.
+// Downloads are submitted to the FetchScheduler in the download class, and
+// driven alongside navigations; once a response's headers are in, its body
+// is sent straight to the destination file (see
+// HttpFetcher::Transfer::set_sink) rather than held in memory. Redirects
+// are followed.
+//
+// A paused (or failed) download keeps what it has saved. Resuming it asks
+// the handler for the rest through W3M_RANGE ("bytes=<offset>-"); a
+// handler that answers "206 Partial Content" has its response appended to
+// the file, and one that answers with the whole body has it saved from the
+// start again. Nothing saved is touched until a response arrives, so a
+// download that fails outright leaves the file as it was. Bodies are asked
+// for unencoded (through W3M_ACCEPT_ENCODING), so that their size is known
+// and they can be resumed.
+//
+// Each download tracks its size, how much of it has been saved and the
+// rate at which it is arriving, from which the list shown to the user is
+// formatted (see format_list).
+//
+// ========================================================================
+class DownloadManager
+{
+    public:
+        // --- public member types ----------------------------------------
+        typedef     std::chrono::steady_clock   clock_type;
+        enum class  State
+        {
+            queued      = 0,
+            running     = 1,
+            paused      = 2,
+            done        = 3,
+            failed      = 4,
+        };// end enum class State
+        struct      Download
+        {
+            size_t                          id          = 0;
+            Uri                             url         = {};
+            string                          path        = "";
+            const HttpFetcher               *fetcher    = nullptr;
+            State                           state       = State::queued;
+            size_t                          bytes       = 0;
+            size_t                          total       = 0;
+            bool                            resumable   = false;
+            string                          error       = "";
+            FetchScheduler::job_pointer     job         = nullptr;
+            int                             fd          = -1;
+            size_t                          redirects   = 0;
+            clock_type::time_point          runStart    = {};
+            size_t                          runBytes    = 0;
+
+            auto active(void) const
+                -> bool;
+            auto rate(clock_type::time_point now) const
+                -> double;
+            auto eta(clock_type::time_point now) const
+                -> double;
+        };// end struct Download
+        typedef     std::list<Download>         download_container;
+
+        // --- public constructors ----------------------------------------
+        DownloadManager(void);
+        DownloadManager(const DownloadManager& other) = delete;
+        ~DownloadManager(void);
+
+        // --- public accessors -------------------------------------------
+        auto downloads(void) const
+            -> const download_container&;
+        auto find(size_t id) const
+            -> const Download*;
+        auto running(void) const
+            -> size_t;
+        void get_pollfds(std::vector<struct pollfd>& fds) const;
+        auto format_list(clock_type::time_point now) const
+            -> string;
+
+        // --- public mutators --------------------------------------------
+        auto add(
+            FetchScheduler& scheduler,
+            const HttpFetcher& fetcher,
+            const Uri& url,
+            const string& path
+        ) -> size_t;
+        auto pause(size_t id)
+            -> bool;
+        auto resume(FetchScheduler& scheduler, size_t id)
+            -> bool;
+        auto remove(size_t id)
+            -> bool;
+        auto update(FetchScheduler& scheduler)
+            -> std::vector<size_t>;
+        void clear(void);
+
+        // --- public static functions ------------------------------------
+        static auto format_size(double bytes)
+            -> string;
+        static auto state_name(State state)
+            -> const char*;
+
+        // --- public static constants ------------------------------------
+        static const size_t     MAX_REDIRECTS           = 10;
+    private:
+        // --- private member variables -----------------------------------
+        download_container      m_downloads     = {};
+        size_t                  m_nextId        = 1;
+
+        // --- private accessors ------------------------------------------
+        auto find_iter(size_t id)
+            -> download_container::iterator;
+
+        // --- private mutators -------------------------------------------
+        void start(FetchScheduler& scheduler, Download& dl);
+        auto begin_body(FetchScheduler& scheduler, Download& dl)
+            -> bool;
+        void stop(Download& dl, State state, const string& error = "");
+};// end class DownloadManager
+
+#endif
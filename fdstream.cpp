@@ -1,8 +1,11 @@
 #include <unistd.h>
+#include <poll.h>
+#include <sys/uio.h>
+#include <cerrno>
 #include <climits>
 #include <cctype>
+#include <cstring>
 #include <streambuf>
-#include <stack>
 #include <sstream>
 
 #include "deps.hpp"
@@ -12,6 +15,11 @@
 //
 // ========================================================================
 
+// --- protected static constant(s) ---------------------------------------
+const size_t    fdstream_streambuf::C_BUFFER_SIZE;
+const size_t    fdstream_streambuf::C_PUTBACK_SIZE;
+const size_t    fdstream_streambuf::C_GATHER_MIN;
+
 // --- public constructor(s) ----------------------------------------------
 fdstream_streambuf::fdstream_streambuf(const int fd)
     : m_fd(fd), m_buffer(0)
@@ -19,41 +27,319 @@ fdstream_streambuf::fdstream_streambuf(const int fd)
     // do nothing
 }// end fdstream_streambuf::fdstream_streambuf
 
+fdstream_streambuf::~fdstream_streambuf(void)
+{
+    sync();
+}// end fdstream_streambuf::~fdstream_streambuf
+
+// --- public mutator(s) --------------------------------------------------
+
+// Writes several chunks at once, along with any buffered output, in as few
+// system calls as possible: small chunks are copied into the buffer, and
+// runs of larger ones are written out together with it.
+//  return: number of bytes of <iov> written; less than their total length
+//      on error
+auto fdstream_streambuf::writev(const struct iovec *iov, size_t iovcnt)
+    -> std::streamsize
+{
+    std::streamsize     nWritten    = 0;
+    size_t              runStart    = 0;
+
+    for (size_t i = 0; i <= iovcnt; ++i)
+    {
+        std::streamsize     runLen      = 0;
+
+        if ((i < iovcnt) and (iov[i].iov_len >= C_GATHER_MIN))
+        {
+            continue;
+        }
+
+        // write out the preceding run of large chunks
+        if (i > runStart)
+        {
+            for (size_t k = runStart; k < i; ++k)
+            {
+                runLen += iov[k].iov_len;
+            }// end for k
+            if (not flush_output(iov + runStart, i - runStart))
+            {
+                return nWritten;
+            }
+            nWritten += runLen;
+        }
+        runStart = i + 1;
+
+        if (i < iovcnt)
+        {
+            const std::streamsize   len     = iov[i].iov_len;
+
+            if (xsputn((const char*)(iov[i].iov_base), len) != len)
+            {
+                return nWritten;
+            }
+            nWritten += len;
+        }
+    }// end for i
+
+    return nWritten;
+}// end fdstream_streambuf::writev
+
+// --- protected member function(s) ---------------------------------------
+
+// Reads from the file descriptor, retrying if interrupted.
+//  return: number of bytes read; 0 at end of file or on error
+auto fdstream_streambuf::read_some(char *dest, size_t len)
+    -> ssize_t
+{
+    ssize_t     nRead;
+
+    do
+    {
+        nRead = ::read(m_fd, dest, len);
+    } while ((nRead < 0) and (EINTR == errno));
+
+    return std::max<ssize_t>(nRead, 0);
+}// end fdstream_streambuf::read_some
+
+// Copies the last characters read (up to C_PUTBACK_SIZE of them, ending at
+// <end>) into the putback area at the front of the buffer, and leaves the
+// get area empty just after them.
+void fdstream_streambuf::keep_putback(const char *end, size_t len)
+{
+    char        *const start    = &m_buffer.at(C_PUTBACK_SIZE);
+
+    len = std::min(len, C_PUTBACK_SIZE);
+    memmove(start - len, end - len, len);
+    setg(start - len, start, start);
+}// end fdstream_streambuf::keep_putback
+
+// Writes out all of the given chunks, retrying after partial writes,
+// interruptions and (on non-blocking descriptors) full pipes. <iov> is
+// consumed in the process.
+//  return: false on error (i.e. the reader has gone away)
+auto fdstream_streambuf::write_all(struct iovec *iov, size_t iovcnt)
+    -> bool
+{
+    while (iovcnt)
+    {
+        ssize_t     nWritten;
+
+        if (not iov->iov_len)
+        {
+            ++iov;
+            --iovcnt;
+            continue;
+        }
+
+        nWritten = ::writev(m_fd, iov, std::min<size_t>(iovcnt, IOV_MAX));
+
+        if (nWritten < 0)
+        {
+            struct pollfd   pfd     = { m_fd, POLLOUT, 0 };
+
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            if ((EAGAIN != errno) and (EWOULDBLOCK != errno))
+            {
+                return false;
+            }
+
+            poll(&pfd, 1, -1);
+            continue;
+        }
+
+        // skip past what was written
+        while (nWritten and ((size_t)nWritten >= iov->iov_len))
+        {
+            nWritten -= iov->iov_len;
+            ++iov;
+            --iovcnt;
+        }// end while
+        if (nWritten)
+        {
+            iov->iov_base = (char*)(iov->iov_base) + nWritten;
+            iov->iov_len -= nWritten;
+        }
+    }// end while
+
+    return true;
+}// end fdstream_streambuf::write_all
+
+// Writes out the output buffer, followed by the given chunks (if any).
+// The output buffer is emptied either way.
+//  return: false on error
+auto fdstream_streambuf::flush_output(const struct iovec *iov, size_t iovcnt)
+    -> bool
+{
+    std::vector<struct iovec>   chunks      = {};
+    bool                        success;
+
+    chunks.reserve(iovcnt + 1);
+    chunks.push_back({ pbase(), (size_t)(pptr() - pbase()) });
+    chunks.insert(chunks.end(), iov, iov + iovcnt);
+
+    success = write_all(chunks.data(), chunks.size());
+    setp(pbase(), epptr());
+
+    return success;
+}// end fdstream_streambuf::flush_output
+
 // --- protected virtual member function(s) -------------------------------
 int fdstream_streambuf::underflow(void)
 {
-    const size_t        oldBufSize      = m_buffer.size();
+    ssize_t     nRead;
 
-    m_buffer.resize(oldBufSize + C_BUFFER_INCREMENT);
-    m_buffer.resize(oldBufSize +
-        ::read(m_fd, &m_buffer.at(oldBufSize), C_BUFFER_INCREMENT));
+    if (gptr() < egptr())
+    {
+        return traits_type::to_int_type(*gptr());
+    }
 
-    if (m_buffer.size() == oldBufSize)
+    if (m_buffer.empty())
+    {
+        m_buffer.resize(C_BUFFER_SIZE);
+        setg(&m_buffer.at(0), &m_buffer.at(0), &m_buffer.at(0));
+    }
+
+    keep_putback(gptr(), gptr() - eback());
+
+    nRead = read_some(gptr(), C_BUFFER_SIZE - C_PUTBACK_SIZE);
+
+    if (not nRead)
     {
         return traits_type::eof();
     }
 
-    setg(&m_buffer.front(), &m_buffer.at(oldBufSize), &m_buffer.back() + 1);
+    setg(eback(), gptr(), gptr() + nRead);
 
-    return traits_type::to_int_type(m_buffer.at(oldBufSize));
+    return traits_type::to_int_type(*gptr());
 }// end fdstream_streambuf::underflow
 
+// Puts back a character other than the one last read (putting back the
+// same character, or up to C_PUTBACK_SIZE characters once the buffer has
+// been refilled, never reaches this).
+int fdstream_streambuf::pbackfail(int c)
+{
+    if (gptr() == eback())
+    {
+        return traits_type::eof();
+    }
+
+    gbump(-1);
+    if (not traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        *gptr() = traits_type::to_char_type(c);
+    }
+
+    return traits_type::not_eof(c);
+}// end fdstream_streambuf::pbackfail
+
+// Reads buffered characters first; requests at least as large as the
+// buffer are then read straight into <s>.
+std::streamsize fdstream_streambuf::xsgetn(char *s, std::streamsize n)
+{
+    std::streamsize     nCopied     = 0;
+
+    while (nCopied < n)
+    {
+        const std::streamsize   nAvail      = egptr() - gptr();
+        const std::streamsize   nLeft       = n - nCopied;
+
+        if (nAvail)
+        {
+            const std::streamsize   nCopy   = std::min(nAvail, nLeft);
+
+            memcpy(s + nCopied, gptr(), nCopy);
+            gbump(nCopy);
+            nCopied += nCopy;
+        }
+        else if (nLeft >= (std::streamsize)C_BUFFER_SIZE)
+        {
+            const ssize_t   nRead   = read_some(s + nCopied, nLeft);
+
+            if (not nRead)
+            {
+                break;
+            }
+            nCopied += nRead;
+
+            if (m_buffer.empty())
+            {
+                m_buffer.resize(C_BUFFER_SIZE);
+            }
+            keep_putback(s + nCopied, nCopied);
+        }
+        else if (traits_type::eq_int_type(underflow(), traits_type::eof()))
+        {
+            break;
+        }
+    }// end while
+
+    return nCopied;
+}// end fdstream_streambuf::xsgetn
+
 int fdstream_streambuf::overflow(int c)
 {
-    if (c != EOF)
+    if (m_outBuffer.empty())
     {
-        char        ch      = c;
+        m_outBuffer.resize(C_BUFFER_SIZE);
+        setp(&m_outBuffer.front(), &m_outBuffer.back() + 1);
+    }
+    else if (not flush_output())
+    {
+        return traits_type::eof();
+    }
 
-        ::write(m_fd, &ch, 1);
+    if (not traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
     }
-    return c;
+
+    return traits_type::not_eof(c);
 }// end fdstream_streambuf::overflow
 
+// Buffers small writes; larger ones are written out right away, together
+// with whatever was already buffered.
 std::streamsize fdstream_streambuf::xsputn(const char *s, std::streamsize n)
 {
-    return ::write(m_fd, s, n);
+    if (n <= 0)
+    {
+        return 0;
+    }
+
+    if (n > epptr() - pptr())
+    {
+        if (n >= (std::streamsize)C_BUFFER_SIZE)
+        {
+            const struct iovec      chunk   = { (void*)(s), (size_t)(n) };
+
+            return writev(&chunk, 1);
+        }
+
+        if (traits_type::eq_int_type(overflow(), traits_type::eof()))
+        {
+            return 0;
+        }
+    }
+
+    memcpy(pptr(), s, n);
+    pbump(n);
+
+    return n;
 }// end fdstream_streambuf::xsputn
 
+int fdstream_streambuf::sync(void)
+{
+    if (pptr() == pbase())
+    {
+        return 0;
+    }
+
+    return flush_output() ? 0 : -1;
+}// end fdstream_streambuf::sync
+
 // === class ifdstream Implementation =====================================
 //
 // ========================================================================
@@ -100,8 +386,28 @@ auto ofdstream::fd(void) const
 }// end ofdstream::fd
 
 // --- public mutator(s) --------------------------------------------------
+// Writes several chunks at once (see fdstream_streambuf::writev).
+auto ofdstream::writev(const struct iovec *iov, size_t iovcnt)
+    -> ofdstream&
+{
+    std::streamsize     len     = 0;
+
+    for (size_t i = 0; i < iovcnt; ++i)
+    {
+        len += iov[i].iov_len;
+    }// end for i
+
+    if (m_bufPtr->writev(iov, iovcnt) != len)
+    {
+        setstate(badbit);
+    }
+
+    return *this;
+}// end ofdstream::writev
+
 void ofdstream::close(void)
 {
+    flush();
     ::close(m_fd);
     setstate(eofbit);
 }// end ofdstream::close
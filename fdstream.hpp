@@ -6,10 +6,30 @@
 #include <streambuf>
 #include <ios>
 #include <sstream>
-#include <stack>
+
+#include <sys/types.h>
+#include <sys/uio.h>
 
 #include "deps.hpp"
 
+// === class fdstream_streambuf ===========================================
+//
+// Buffered input from, and output to, a file descriptor.
+//
+// Input is read into a fixed-size buffer in large reads; once the buffer
+// has been consumed, it is refilled from the start, keeping only the last
+// few characters read so that they can still be put back. Memory use is
+// therefore constant, however long the stream. Large reads (i.e.
+// istream::read) bypass the buffer altogether.
+//
+// Output is collected in a buffer of the same size, and written out when
+// it fills up or the stream is flushed (sync). Writes are retried until
+// complete: on partial writes, when interrupted, and (for non-blocking
+// descriptors) once the descriptor is writable again. Writes at least as
+// large as the buffer, and the larger chunks passed to writev, are sent
+// together with any buffered output in a single gathered write.
+//
+// ========================================================================
 class   fdstream_streambuf : public std::streambuf
 {
     public:
@@ -27,18 +47,41 @@ class   fdstream_streambuf : public std::streambuf
         //
         // ================================================================
         fdstream_streambuf(const int fd);// type
+        fdstream_streambuf(const fdstream_streambuf& other) = delete;
+        ~fdstream_streambuf(void);
+
+        // === public mutator(s) ==========================================
+        auto writev(const struct iovec *iov, size_t iovcnt)
+            -> std::streamsize;
     protected:
         // === protected member variable(s) ===============================
         const int           m_fd            = -1;
-        std::stack<int>     m_charStack     = {};
         std::vector<char>   m_buffer        = {};
+        std::vector<char>   m_outBuffer     = {};
 
         // === protected static constant(s) ===============================
-        const size_t        C_BUFFER_INCREMENT   = 256;
+        static const size_t     C_BUFFER_SIZE       = 0x10000;
+        static const size_t     C_PUTBACK_SIZE      = 0x10;
+        static const size_t     C_GATHER_MIN        = 0x400;
+
+        // === protected member function(s) ===============================
+        auto read_some(char *dest, size_t len)
+            -> ssize_t;
+        void keep_putback(const char *end, size_t len);
+        auto write_all(struct iovec *iov, size_t iovcnt)
+            -> bool;
+        auto flush_output(const struct iovec *iov = nullptr, size_t iovcnt = 0)
+            -> bool;
 
         // === protected virtual member function(s) =======================
         virtual int underflow(void)
             override;
+        virtual int pbackfail(int c = EOF)
+            override;
+        virtual std::streamsize xsgetn(char *s, std::streamsize n)
+            override;
+        virtual int sync(void)
+            override;
         virtual int overflow(int c = EOF)
             override;
         virtual std::streamsize xsputn(const char *s, std::streamsize n)
@@ -96,11 +139,13 @@ class   ofdstream : public std::ostream
             -> int;
 
         // === public mutator(s) ==========================================
+        auto writev(const struct iovec *iov, size_t iovcnt)
+            -> ofdstream&;
         void close(void);
     protected:
         // === protected member variable(s) ===============================
-        int                         m_fd        = -1;
-        u_ptr<std::streambuf>       m_bufPtr    = nullptr;
+        int                             m_fd        = -1;
+        u_ptr<fdstream_streambuf>       m_bufPtr    = nullptr;
 };// end class ofdstream
 
 #endif
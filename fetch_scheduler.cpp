@@ -0,0 +1,303 @@
+#include <cctype>
+#include <list>
+#include <map>
+#include <memory>
+
+#include "deps.hpp"
+#include "uri.hpp"
+#include "http_fetcher.hpp"
+
+#include "fetch_scheduler.hpp"
+
+// === struct FetchScheduler::Job Implementation ==========================
+//
+// ========================================================================
+
+// return: true once the transfer has been started (or failed to start)
+auto FetchScheduler::Job::started(void) const
+    -> bool
+{
+    return transfer or (not error.empty());
+}// end FetchScheduler::Job::started
+
+auto FetchScheduler::Job::finished(void) const
+    -> bool
+{
+    return (not error.empty()) or (transfer and transfer->finished());
+}// end FetchScheduler::Job::finished
+
+auto FetchScheduler::Job::bytes_received(void) const
+    -> size_t
+{
+    return transfer ? transfer->bytes_received() : 0;
+}// end FetchScheduler::Job::bytes_received
+
+// === class FetchScheduler Implementation ================================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+FetchScheduler::FetchScheduler(void)
+{
+    // do nothing
+}// end FetchScheduler::FetchScheduler
+
+FetchScheduler::FetchScheduler(const Config& cfg)
+{
+    m_cfg = cfg;
+}// end FetchScheduler::FetchScheduler
+
+// --- public accessors ---------------------------------------------------
+auto FetchScheduler::config(void) const
+    -> const Config&
+{
+    return m_cfg;
+}// end FetchScheduler::config
+
+// return: number of transfers started by the scheduler and still running
+auto FetchScheduler::running(void) const
+    -> size_t
+{
+    size_t      count   = 0;
+
+    for (const auto& slot : m_slots)
+    {
+        const auto      job     = slot.job.lock();
+
+        if (job and (not job->finished()))
+        {
+            ++count;
+        }
+    }// end for slot
+
+    return count;
+}// end FetchScheduler::running
+
+// return: number of jobs waiting for a slot
+auto FetchScheduler::queued(void) const
+    -> size_t
+{
+    size_t      count   = 0;
+
+    for (const auto& kv : m_queues)
+    {
+        for (const auto& hostQueue : kv.second)
+        {
+            count += hostQueue.jobs.size();
+        }// end for hostQueue
+    }// end for kv
+
+    return count;
+}// end FetchScheduler::queued
+
+// --- public mutators ----------------------------------------------------
+
+// Queues a fetch, starting it right away if there is room.
+//  return: the job; its transfer is set once started
+auto FetchScheduler::submit(
+    Priority priority,
+    const HttpFetcher& fetcher,
+    const Uri& url,
+    const HttpFetcher::data_container& input,
+    const HttpFetcher::env_map& env
+) -> job_pointer
+{
+    job_pointer     job(new Job());
+
+    job->priority = priority;
+    job->url = url;
+    job->fetcher = &fetcher;
+    job->input = input;
+    job->env = env;
+
+    enqueue(job);
+    update();
+
+    return job;
+}// end FetchScheduler::submit
+
+// Moves a job to another priority class (i.e. a prefetch that the user has
+// since navigated to). Jobs already started are unaffected.
+void FetchScheduler::promote(const job_pointer& job, Priority priority)
+{
+    if (job->started() or (job->priority == priority))
+    {
+        job->priority = priority;
+        return;
+    }
+
+    for (auto& hostQueue : m_queues[job->priority])
+    {
+        hostQueue.jobs.remove(job);
+    }// end for hostQueue
+
+    job->priority = priority;
+    enqueue(job);
+    update();
+}// end FetchScheduler::promote
+
+// Frees the slots of finished (or abandoned) transfers, then starts waiting
+// jobs for as long as the limits allow.
+void FetchScheduler::update(void)
+{
+    reap();
+
+    while (m_slots.size() < m_cfg.maxConcurrent)
+    {
+        job_pointer     next    = nullptr;
+
+        for (auto& kv : m_queues)
+        {
+            class_queue&    queue   = kv.second;
+            auto            iter    = queue.begin();
+
+            while (iter != queue.end())
+            {
+                auto&       jobs    = iter->jobs;
+
+                // jobs nobody is waiting for anymore
+                jobs.remove_if([](const job_pointer& job)
+                {
+                    return job.use_count() == 1;
+                });
+
+                if (jobs.empty())
+                {
+                    iter = queue.erase(iter);
+                    continue;
+                }
+
+                if (m_hostLoad[iter->host] >= m_cfg.maxPerHost)
+                {
+                    ++iter;
+                    continue;
+                }
+
+                next = jobs.front();
+                jobs.pop_front();
+
+                // give the other hosts in this class a turn
+                queue.splice(queue.end(), queue, iter);
+                break;
+            }// end while
+
+            if (next)
+            {
+                break;
+            }
+        }// end for kv
+
+        if (not next)
+        {
+            break;
+        }
+
+        start(next);
+    }// end while
+}// end FetchScheduler::update
+
+// Drops all waiting jobs. Running transfers are left to their owners.
+void FetchScheduler::clear(void)
+{
+    m_queues.clear();
+}// end FetchScheduler::clear
+
+// --- public static functions --------------------------------------------
+
+// Wraps a transfer that was obtained without the scheduler (i.e. a
+// response served from cache) in a job, so that it can be handled like
+// any other.
+auto FetchScheduler::adopt(u_ptr<HttpFetcher::Transfer>&& transfer)
+    -> job_pointer
+{
+    job_pointer     job(new Job());
+
+    job->url = transfer->url();
+    job->transfer = std::move(transfer);
+
+    return job;
+}// end FetchScheduler::adopt
+
+// --- private mutators ---------------------------------------------------
+void FetchScheduler::enqueue(const job_pointer& job)
+{
+    const string    host    = host_key(job->url);
+    class_queue&    queue   = m_queues[job->priority];
+
+    for (auto& hostQueue : queue)
+    {
+        if (hostQueue.host == host)
+        {
+            hostQueue.jobs.push_back(job);
+            return;
+        }
+    }// end for hostQueue
+
+    queue.push_back({ host, { job } });
+}// end FetchScheduler::enqueue
+
+void FetchScheduler::reap(void)
+{
+    for (auto iter = m_slots.begin(); iter != m_slots.end();)
+    {
+        const auto      job     = iter->job.lock();
+
+        if (job and (not job->finished()))
+        {
+            ++iter;
+            continue;
+        }
+
+        --m_hostLoad[iter->host];
+        iter = m_slots.erase(iter);
+    }// end for iter
+}// end FetchScheduler::reap
+
+// Starts a job's transfer. Failures are recorded in the job rather than
+// thrown, as the job's owner may not be the caller.
+void FetchScheduler::start(const job_pointer& job)
+{
+    const string    host    = host_key(job->url);
+
+    try
+    {
+        job->transfer = job->fetcher->start_fetch(
+            job->url,
+            job->input,
+            job->env
+        );
+    }
+    catch (const StringException& e)
+    {
+        job->error = (string)(e);
+    }
+    catch (const std::exception& e)
+    {
+        job->error = e.what();
+    }
+
+    if (job->error.empty() and (not job->transfer))
+    {
+        job->error = "could not start fetch";
+    }
+
+    if (job->error.empty())
+    {
+        m_slots.push_back({ host, job });
+        ++m_hostLoad[host];
+    }
+}// end FetchScheduler::start
+
+// --- private static functions -------------------------------------------
+auto FetchScheduler::host_key(const Uri& url)
+    -> string
+{
+    string      key     = url.host;
+
+    for (char& ch : key)
+    {
+        ch = tolower(ch);
+    }// end for ch
+
+    return key;
+}// end FetchScheduler::host_key
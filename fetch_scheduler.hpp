@@ -0,0 +1,126 @@
+#ifndef __FETCH_SCHEDULER_HPP__
+#define __FETCH_SCHEDULER_HPP__
+
+#include <list>
+#include <map>
+#include <memory>
+
+#include "deps.hpp"
+#include "uri.hpp"
+#include "http_fetcher.hpp"
+
+// === class FetchScheduler ===============================================
+//
+// Decides when fetches are started, so that many of them (i.e. pages
+// opened in background tabs, prefetches) can be in flight at once without
+// flooding the network or any one host. Requests are submitted as jobs; a
+// job's transfer is started once fewer than maxConcurrent transfers are
+// running overall and fewer than maxPerHost are running for its host.
+// Started transfers are driven by the job's owner, like any other
+// transfer; the scheduler only watches for them to finish.
+//
+// Waiting jobs are started in order of priority class. Within a class,
+// hosts take turns: each host has its own queue, and after one of its jobs
+// is started it moves to the back of the line, so a burst of requests to
+// one host can't hold up the others.
+//
+// Jobs are shared with their owner. Dropping the last reference to a job
+// abandons it: a waiting job is never started, and a running job's
+// transfer is killed along with it, freeing its slot.
+//
+// ========================================================================
+class FetchScheduler
+{
+    public:
+        // --- public member types ----------------------------------------
+        enum class  Priority
+        {
+            navigation      = 0,
+            backgroundTab   = 1,
+            download        = 2,
+            prefetch        = 3,
+            image           = 4,
+        };// end enum class Priority
+        struct      Config
+        {
+            size_t          maxConcurrent;
+            size_t          maxPerHost;
+        };// end struct Config
+        struct      Job
+        {
+            Priority                        priority    = Priority::navigation;
+            Uri                             url         = {};
+            const HttpFetcher               *fetcher    = nullptr;
+            HttpFetcher::data_container     input       = {};
+            HttpFetcher::env_map            env         = {};
+            u_ptr<HttpFetcher::Transfer>    transfer    = nullptr;
+            string                          error       = "";
+
+            auto started(void) const
+                -> bool;
+            auto finished(void) const
+                -> bool;
+            auto bytes_received(void) const
+                -> size_t;
+        };// end struct Job
+        typedef     s_ptr<Job>                  job_pointer;
+
+        // --- public constructors ----------------------------------------
+        FetchScheduler(void);
+        FetchScheduler(const Config& cfg);
+
+        // --- public accessors -------------------------------------------
+        auto config(void) const
+            -> const Config&;
+        auto running(void) const
+            -> size_t;
+        auto queued(void) const
+            -> size_t;
+
+        // --- public mutators --------------------------------------------
+        auto submit(
+            Priority priority,
+            const HttpFetcher& fetcher,
+            const Uri& url,
+            const HttpFetcher::data_container& input = {},
+            const HttpFetcher::env_map& env = {}
+        ) -> job_pointer;
+        void promote(const job_pointer& job, Priority priority);
+        void update(void);
+        void clear(void);
+
+        // --- public static functions ------------------------------------
+        static auto adopt(u_ptr<HttpFetcher::Transfer>&& transfer)
+            -> job_pointer;
+    private:
+        // --- private member types ---------------------------------------
+        struct  HostQueue
+        {
+            string                          host;
+            std::list<job_pointer>          jobs;
+        };// end struct HostQueue
+        struct  Slot
+        {
+            string                          host;
+            std::weak_ptr<Job>              job;
+        };// end struct Slot
+        typedef std::list<HostQueue>                    class_queue;
+        typedef std::map<Priority,class_queue>          queue_map;
+
+        // --- private member variables -----------------------------------
+        Config                          m_cfg           = { 1, 1 };
+        queue_map                       m_queues        = {};
+        std::list<Slot>                 m_slots         = {};
+        std::map<string,size_t>         m_hostLoad      = {};
+
+        // --- private mutators -------------------------------------------
+        void enqueue(const job_pointer& job);
+        void reap(void);
+        void start(const job_pointer& job);
+
+        // --- private static functions -----------------------------------
+        static auto host_key(const Uri& url)
+            -> string;
+};// end class FetchScheduler
+
+#endif
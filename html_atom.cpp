@@ -0,0 +1,57 @@
+#include <unordered_map>
+
+#include "html_atom.hpp"
+
+// === namespace html_atom Implementation =================================
+//
+// ========================================================================
+namespace
+{
+    // the name of each atom, at its index
+    const char      *const NAMES[]      = {
+        "",
+        #include "html_atom_names.gen.hpp"
+    };
+
+    static_assert(
+        sizeof(NAMES) / sizeof(*NAMES) == html_atom::COUNT,
+        "html atom names out of step with enum class HtmlAtom"
+    );
+
+    // return: the atom of each name, built on first use
+    auto atoms(void)
+        -> const std::unordered_map<std::string_view, HtmlAtom>&
+    {
+        static const auto   table   = [](void) {
+            std::unordered_map<std::string_view, HtmlAtom>  out;
+
+            out.reserve(html_atom::COUNT);
+            for (size_t i = 1; i < html_atom::COUNT; ++i)
+            {
+                out.emplace(NAMES[i], HtmlAtom(i));
+            }// end for i
+
+            return out;
+        }();
+
+        return table;
+    }// end atoms
+}// end namespace
+
+// return: the atom of the (lowercase) <name>, or HtmlAtom::none if it
+//  isn't a known name
+auto html_atom::intern(std::string_view name)
+    -> HtmlAtom
+{
+    const auto&     table       = atoms();
+    const auto      found       = table.find(name);
+
+    return (found == table.end()) ? HtmlAtom::none : found->second;
+}// end html_atom::intern
+
+// return: the name <atom> was interned from ("" for HtmlAtom::none)
+auto html_atom::name(HtmlAtom atom)
+    -> const char*
+{
+    return (size_t(atom) < COUNT) ? NAMES[size_t(atom)] : "";
+}// end html_atom::name
@@ -0,0 +1,41 @@
+#ifndef __HTML_ATOM_HPP__
+#define __HTML_ATOM_HPP__
+
+#include <string_view>
+
+#include "deps.hpp"
+
+// === enum class HtmlAtom ================================================
+//
+// The tag and attribute names html documents are laid out by, interned:
+// a name is looked up once, when its node is built, and compared (or
+// used as an array index) as a small integer after that. The names are
+// listed in html_atoms.txt, from which the enumerators are generated;
+// names not in it are HtmlAtom::none. Enumerators are the names with
+// dashes made underscores, and a trailing underscore on C++ keywords
+// (i.e. HtmlAtom::class_).
+//
+// ========================================================================
+enum class  HtmlAtom : unsigned short
+{
+    none = 0,
+    #include "html_atom_enum.gen.hpp"
+    atom_count
+};// end enum class HtmlAtom
+
+// === namespace html_atom ================================================
+//
+// ========================================================================
+namespace html_atom
+{
+    // number of atoms, including HtmlAtom::none (i.e. to size an array
+    // indexed by atom)
+    const size_t    COUNT       = size_t(HtmlAtom::atom_count);
+
+    auto intern(std::string_view name)
+        -> HtmlAtom;
+    auto name(HtmlAtom atom)
+        -> const char*;
+};// end namespace html_atom
+
+#endif
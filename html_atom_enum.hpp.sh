@@ -0,0 +1,27 @@
+#!/bin/bash
+
+# Generates the enumerators of enum class HtmlAtom, one for each of the
+# names read from stdin, in order. Formatted output printed to stdout.
+# Dashes become underscores, and names that are C++ keywords (i.e.
+# "class") get a trailing underscore.
+#
+# Makefile should feed this script appropriate input (i.e. from a .txt
+# file) and output to the appropriate destination (i.e. a .hpp file).
+
+keywords=" class default for template "
+
+cat << _EOF_
+// Does not use include guards, by design.
+// Should be #include'd inside enum class HtmlAtom, in html_atom.hpp.
+
+_EOF_
+
+while read token; do
+    token_cpp="$(sed -e 's/-/_/g' <<< "${token}")"
+    if [[ "${keywords}" == *" ${token_cpp} "* ]]; then
+        token_cpp="${token_cpp}_"
+    fi
+    cat << _EOF_
+${token_cpp},
+_EOF_
+done
@@ -0,0 +1,208 @@
+// Does not use include guards, by design.
+// Should be #include'd inside the array of atom names, in html_atom.cpp.
+
+"a",
+"abbr",
+"accept",
+"accept-charset",
+"accesskey",
+"action",
+"address",
+"align",
+"alt",
+"area",
+"article",
+"aside",
+"async",
+"audio",
+"autocomplete",
+"autofocus",
+"autoplay",
+"b",
+"base",
+"bdi",
+"bdo",
+"bgcolor",
+"blockquote",
+"body",
+"border",
+"br",
+"button",
+"canvas",
+"caption",
+"center",
+"charset",
+"checked",
+"cite",
+"class",
+"code",
+"col",
+"colgroup",
+"color",
+"cols",
+"colspan",
+"content",
+"controls",
+"coords",
+"data",
+"datalist",
+"datetime",
+"dd",
+"default",
+"defer",
+"del",
+"details",
+"dfn",
+"dialog",
+"dir",
+"disabled",
+"div",
+"dl",
+"download",
+"dt",
+"em",
+"embed",
+"enctype",
+"fieldset",
+"figcaption",
+"figure",
+"font",
+"footer",
+"for",
+"form",
+"formaction",
+"frame",
+"frameborder",
+"frameset",
+"h1",
+"h2",
+"h3",
+"h4",
+"h5",
+"h6",
+"head",
+"header",
+"headers",
+"height",
+"hgroup",
+"hidden",
+"high",
+"hr",
+"href",
+"hreflang",
+"html",
+"http-equiv",
+"i",
+"id",
+"iframe",
+"img",
+"input",
+"ins",
+"kbd",
+"label",
+"lang",
+"legend",
+"li",
+"link",
+"list",
+"loop",
+"low",
+"main",
+"map",
+"mark",
+"max",
+"maxlength",
+"media",
+"menu",
+"meta",
+"meter",
+"method",
+"min",
+"minlength",
+"multiple",
+"muted",
+"name",
+"nav",
+"noframes",
+"noscript",
+"nowrap",
+"object",
+"ol",
+"open",
+"optgroup",
+"optimum",
+"option",
+"output",
+"p",
+"param",
+"pattern",
+"picture",
+"placeholder",
+"poster",
+"pre",
+"preload",
+"progress",
+"q",
+"readonly",
+"rel",
+"required",
+"reversed",
+"rows",
+"rowspan",
+"rp",
+"rt",
+"ruby",
+"s",
+"samp",
+"sandbox",
+"scope",
+"script",
+"search",
+"section",
+"select",
+"selected",
+"shape",
+"size",
+"sizes",
+"slot",
+"small",
+"source",
+"span",
+"src",
+"srcdoc",
+"srclang",
+"srcset",
+"start",
+"step",
+"strike",
+"strong",
+"style",
+"sub",
+"summary",
+"sup",
+"tabindex",
+"table",
+"target",
+"tbody",
+"td",
+"template",
+"textarea",
+"tfoot",
+"th",
+"thead",
+"time",
+"title",
+"tr",
+"track",
+"tt",
+"type",
+"u",
+"ul",
+"usemap",
+"valign",
+"value",
+"var",
+"video",
+"wbr",
+"width",
+"wrap",
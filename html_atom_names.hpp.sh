@@ -0,0 +1,20 @@
+#!/bin/bash
+
+# Generates the initializers of an array of the names read from stdin, in
+# order, so that the name of each HtmlAtom is at its index. Formatted
+# output printed to stdout.
+#
+# Makefile should feed this script appropriate input (i.e. from a .txt
+# file) and output to the appropriate destination (i.e. a .hpp file).
+
+cat << _EOF_
+// Does not use include guards, by design.
+// Should be #include'd inside the array of atom names, in html_atom.cpp.
+
+_EOF_
+
+while read token; do
+    cat << _EOF_
+"${token}",
+_EOF_
+done
@@ -0,0 +1,177 @@
+#include "html_attributes.hpp"
+
+// === class HtmlAttributes Implementation ================================
+//
+// ========================================================================
+
+// --- public accessors ---------------------------------------------------
+auto HtmlAttributes::empty(void) const
+    -> bool
+{
+    return m_attributes.empty();
+}// end HtmlAttributes::empty
+
+auto HtmlAttributes::size(void) const
+    -> size_t
+{
+    return m_attributes.size();
+}// end HtmlAttributes::size
+
+auto HtmlAttributes::count(HtmlAtom atom) const
+    -> size_t
+{
+    return (nullptr != find(atom));
+}// end HtmlAttributes::count
+
+auto HtmlAttributes::count(std::string_view name) const
+    -> size_t
+{
+    return (
+        index_of(html_atom::intern(name), name) != m_attributes.size()
+    );
+}// end HtmlAttributes::count
+
+// return: the value of the attribute <atom>, or nullptr if there is none
+auto HtmlAttributes::find(HtmlAtom atom) const
+    -> const string*
+{
+    const size_t    idx     = index_of(atom, html_atom::name(atom));
+
+    return (idx == m_attributes.size()) ? nullptr : &m_attributes[idx].value;
+}// end HtmlAttributes::find
+
+// Throws: std::out_of_range, if there is no attribute <atom>
+auto HtmlAttributes::at(HtmlAtom atom) const
+    -> const string&
+{
+    const string    *value      = find(atom);
+
+    if (not value)
+    {
+        throw std::out_of_range(
+            string("no attribute ") + html_atom::name(atom)
+        );
+    }
+
+    return *value;
+}// end HtmlAttributes::at
+
+// Throws: std::out_of_range, if there is no attribute <name>
+auto HtmlAttributes::at(std::string_view name) const
+    -> const string&
+{
+    const size_t    idx     = index_of(html_atom::intern(name), name);
+
+    if (idx == m_attributes.size())
+    {
+        throw std::out_of_range("no attribute " + string(name));
+    }
+
+    return m_attributes[idx].value;
+}// end HtmlAttributes::at
+
+auto HtmlAttributes::begin(void) const
+    -> const_iterator
+{
+    return m_attributes.cbegin();
+}// end HtmlAttributes::begin
+
+auto HtmlAttributes::end(void) const
+    -> const_iterator
+{
+    return m_attributes.cend();
+}// end HtmlAttributes::end
+
+// --- public mutators ----------------------------------------------------
+
+// return: the value of the attribute <atom>, added (empty) if there is
+//  none
+auto HtmlAttributes::operator[](HtmlAtom atom)
+    -> string&
+{
+    return insert(atom, html_atom::name(atom));
+}// end HtmlAttributes::operator[]
+
+auto HtmlAttributes::operator[](std::string_view name)
+    -> string&
+{
+    return insert(html_atom::intern(name), name);
+}// end HtmlAttributes::operator[]
+
+// return: the number of attributes erased (0 or 1)
+auto HtmlAttributes::erase(HtmlAtom atom)
+    -> size_t
+{
+    return remove(index_of(atom, html_atom::name(atom)));
+}// end HtmlAttributes::erase
+
+auto HtmlAttributes::erase(std::string_view name)
+    -> size_t
+{
+    return remove(index_of(html_atom::intern(name), name));
+}// end HtmlAttributes::erase
+
+void HtmlAttributes::clear(void)
+{
+    m_attributes.clear();
+}// end HtmlAttributes::clear
+
+// --- private member functions -------------------------------------------
+
+// return: the index of the attribute <atom> (compared by <name> if it's
+//  HtmlAtom::none), or size() if there is none
+auto HtmlAttributes::index_of(HtmlAtom atom, std::string_view name) const
+    -> size_t
+{
+    size_t          idx     = 0;
+
+    for (; idx < m_attributes.size(); ++idx)
+    {
+        const attribute&    attr    = m_attributes[idx];
+
+        if (
+            (attr.atom == atom)
+            and (atom != HtmlAtom::none or attr.name == name)
+        )
+        {
+            break;
+        }
+    }// end for idx
+
+    return idx;
+}// end HtmlAttributes::index_of
+
+// return: the value of the attribute <atom> named <name>, added in name
+//  order if there is none
+auto HtmlAttributes::insert(HtmlAtom atom, std::string_view name)
+    -> string&
+{
+    const size_t    idx     = index_of(atom, name);
+    auto            pos     = m_attributes.begin();
+
+    if (idx != m_attributes.size())
+    {
+        return m_attributes[idx].value;
+    }
+
+    while (pos != m_attributes.end() and pos->name < name)
+    {
+        ++pos;
+    }// end while
+
+    return m_attributes.insert(pos, { atom, string(name), "" })->value;
+}// end HtmlAttributes::insert
+
+// Removes the attribute at <idx>, if there is one.
+//  return: the number of attributes removed (0 or 1)
+auto HtmlAttributes::remove(size_t idx)
+    -> size_t
+{
+    if (idx >= m_attributes.size())
+    {
+        return 0;
+    }
+
+    m_attributes.erase(m_attributes.begin() + idx);
+    return 1;
+}// end HtmlAttributes::remove
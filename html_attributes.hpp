@@ -0,0 +1,74 @@
+#ifndef __HTML_ATTRIBUTES_HPP__
+#define __HTML_ATTRIBUTES_HPP__
+
+#include <string_view>
+
+#include "deps.hpp"
+#include "html_atom.hpp"
+
+// === class HtmlAttributes ===============================================
+//
+// The attributes of an element, as a small flat list kept in name order.
+// Each name is interned when it's added, so an attribute can be looked
+// up by atom (i.e. HtmlAttributes::count(HtmlAtom::href)) by comparing
+// small integers, without hashing or allocating. Looking one up by name
+// interns the name first; names that aren't atoms are compared as
+// strings.
+//
+// ========================================================================
+class HtmlAttributes
+{
+    public:
+        // --- public member types ----------------------------------------
+        struct      attribute
+        {
+            HtmlAtom                atom            = HtmlAtom::none;
+            string                  name            = "";
+            string                  value           = "";
+        };
+        typedef     std::vector<attribute>::const_iterator  const_iterator;
+
+        // --- public accessors -------------------------------------------
+        auto empty(void) const
+            -> bool;
+        auto size(void) const
+            -> size_t;
+        auto count(HtmlAtom atom) const
+            -> size_t;
+        auto count(std::string_view name) const
+            -> size_t;
+        auto find(HtmlAtom atom) const
+            -> const string*;
+        auto at(HtmlAtom atom) const
+            -> const string&;
+        auto at(std::string_view name) const
+            -> const string&;
+        auto begin(void) const
+            -> const_iterator;
+        auto end(void) const
+            -> const_iterator;
+
+        // --- public mutators --------------------------------------------
+        auto operator[](HtmlAtom atom)
+            -> string&;
+        auto operator[](std::string_view name)
+            -> string&;
+        auto erase(HtmlAtom atom)
+            -> size_t;
+        auto erase(std::string_view name)
+            -> size_t;
+        void clear(void);
+    private:
+        // --- private member variables -----------------------------------
+        std::vector<attribute>      m_attributes        = {};
+
+        // --- private member functions -----------------------------------
+        auto index_of(HtmlAtom atom, std::string_view name) const
+            -> size_t;
+        auto insert(HtmlAtom atom, std::string_view name)
+            -> string&;
+        auto remove(size_t idx)
+            -> size_t;
+};// end class HtmlAttributes
+
+#endif
@@ -1,10 +1,45 @@
-#include <stack>
+#include <stdexcept>
 
 #include "deps.hpp"
 #include "utils.hpp"
 #include "html_parser_basic.hpp"
+#include "html_push_parser.hpp"
 #include "dom_tree.hpp"
 
+// === HtmlParserBasic static constant(s) =================================
+//
+// Deeper than any sensible page, but shallow enough for the recursive
+// walks over the DomTree (layout, destruction) to stay well within the C
+// stack.
+//
+// ========================================================================
+const size_t    HtmlParserBasic::DEFAULT_MAX_DEPTH      = 512;
+
+// === HtmlParserBasic constructor(s) =====================================
+//
+// ========================================================================
+HtmlParserBasic::HtmlParserBasic(size_t maxDepth)
+{
+    m_maxDepth = maxDepth;
+}// end HtmlParserBasic::HtmlParserBasic
+
+// === HtmlParserBasic accessor(s) ========================================
+//
+// ========================================================================
+auto    HtmlParserBasic::max_depth(void) const
+    -> size_t
+{
+    return m_maxDepth;
+}// end HtmlParserBasic::max_depth
+
+// === HtmlParserBasic mutator(s) =========================================
+//
+// ========================================================================
+void    HtmlParserBasic::set_max_depth(size_t maxDepth)
+{
+    m_maxDepth = maxDepth;
+}// end HtmlParserBasic::set_max_depth
+
 // === HtmlParserBasic::parse_html(std::istream& ins) const ===============
 //
 // Parses an html document read from istream <ins> into a DomTree.
@@ -28,58 +63,82 @@ const
 {
     using namespace std;
 
-    stack<string>               tagStack;
-    stack<DomTree::node*>       nodeStack;
+    open_elements       open;
 
     // initialize node stack
-    nodeStack.push(&root);
+    open.maxDepth = m_maxDepth;
+    open.nodeStack.push_back(&root);
 
-    // while the input stream is not depleted
+    // text outside of any element is dropped
     utils::read_token_until(ins, "<");
-    while (ins)
+    while (ins and ins.peek() == '<')
     {
-        const char      nextChar        = ins.peek();
+        push_node(ins, open);
 
-        switch (nextChar)
+        if (open.tagStack.empty())
         {
-            case '<':
-                push_node(ins, nodeStack, tagStack);
-                break;
-            default:
-                {
-                    string      err     = "";
+            utils::read_token_until(ins, "<");
+        }
+        else
+        {
+            const string    currText    = read_text_token(ins);
 
-                    ins >> err;
-                    err = "\"" + err + "\" (not a valid tag opening)";
-                    throw except_invalid_token(err);
-                }
-        }// end switch (nextChar)
-        utils::read_token_until(ins, "<");
+            if (not currText.empty())
+            {
+                // emplace text node
+                open.nodeStack.back()->emplace_child_back("text", currText);
+            }
+        }
     }// end while (ins)
 }// end HtmlParserBasic::parse_html(...) const
 
+// === HtmlParserBasic::parse_html(const char *begin, ...) const =========
+//
+// Parses an html document held in memory, from <begin> up to <end>, into
+// a DomTree. Builds the same tree as parsing it from a stream would (see
+// HtmlTokenizer for the few exceptions), several times faster.
+//
+// Throws:
+//      HtmlParser::except_invalid_token, if the document contains a start
+//      tag without a name
+//
+// ========================================================================
+void    HtmlParserBasic::parse_html(
+    DomTree::node& root,
+    const char *begin,
+    const char *end)
+const
+{
+    HtmlPushParser      parser(root, m_maxDepth);
+
+    parser.feed(begin, end - begin);
+    parser.finish();
+}// end HtmlParserBasic::parse_html(...) const
+
 // === HtmlParserBasic::push_node =========================================
 //
+// Reads the next tag, adding the element it opens to the innermost open
+// element, or closing the elements its end tag matches.
+//
 // ========================================================================
 void     HtmlParserBasic::push_node(
     std::istream& ins,
-    std::stack<DomTree::node*>& nodeStack,
-    std::stack<string>& tagStack
+    open_elements& open
 )
 {
     using namespace std;
 
     // if we get to any of these cases we have a serious logic error
-    if (nodeStack.empty())
+    if (open.nodeStack.empty())
     {
         throw logic_error("node stack is empty");
     }
-    else if (!nodeStack.top())
+    else if (!open.nodeStack.back())
     {
         throw logic_error("node stack top node is null");
     }
 
-    DomTree::node       *parentNode     = nodeStack.top();
+    DomTree::node       *parentNode     = open.nodeStack.back();
     tag                 currTag         = tag::from_stream(ins);
 
     switch (currTag.kind)
@@ -89,7 +148,10 @@ void     HtmlParserBasic::push_node(
                 // emplace new node
                 DomTree::node&      currNode
                     = parentNode->emplace_child_back(currTag.identifier);
-                currNode.attributes = currTag.attributes;
+                for (const auto& attr : currTag.attributes)
+                {
+                    currNode.attributes[attr.first] = attr.second;
+                }// end for attr
 
                 // check if tag is inherently childless
                 if (is_empty_tag(currTag.identifier))
@@ -105,23 +167,7 @@ void     HtmlParserBasic::push_node(
                     return;
                 }
 
-                // prepare stacks for recursive calls
-                tagStack.push(currTag.identifier);
-                nodeStack.push(&currNode);
-
-                const size_t    stackSize   = nodeStack.size();
-
-                while (ins and nodeStack.size() == stackSize)
-                {
-                    string          currText    = read_text_token(ins);
-                    if (not currText.empty())
-                    {
-                        // emplace text node
-                        currNode.emplace_child_back("text", currText);
-                        currText.clear();
-                    }
-                    push_node(ins, nodeStack, tagStack);
-                }// end while (ins)
+                open.push(currTag.identifier, currNode);
             }
             break;
         case tag::Kind::solo:
@@ -129,18 +175,15 @@ void     HtmlParserBasic::push_node(
                 DomTree::node&      currNode
                     = parentNode->emplace_child_back(currTag.identifier);
 
-                currNode.attributes = currTag.attributes;
+                for (const auto& attr : currTag.attributes)
+                {
+                    currNode.attributes[attr.first] = attr.second;
+                }// end for attr
             }
             break;
         case tag::Kind::terminal:
             {
-                while (currTag.identifier != tagStack.top())
-                {
-                    tagStack.pop();
-                    nodeStack.pop();
-                }
-                tagStack.pop();
-                nodeStack.pop();
+                open.close(currTag.identifier);
             }
             break;
         case tag::Kind::comment:
@@ -419,3 +462,79 @@ retry:
 
     return output;
 }// end HtmlParserBasic::tag::read_attribute(std::istream& ins)
+
+// === HtmlParserBasic::open_elements::push ===============================
+//
+// Opens an element, flattening it into the innermost open element if
+// <maxDepth> elements are already open.
+//
+// ========================================================================
+void    HtmlParserBasic::open_elements::push(
+    const string& identifier,
+    DomTree::node& nd
+)
+{
+    const bool      flatten     = maxDepth and tagStack.size() >= maxDepth;
+
+    nodeStack.push_back(flatten ? nodeStack.back() : &nd);
+    tagStack.push_back(identifier);
+    ++tagCounts[identifier];
+}// end HtmlParserBasic::open_elements::push
+
+// === HtmlParserBasic::open_elements::pop ================================
+//
+// Closes the innermost open element.
+//
+// ========================================================================
+void    HtmlParserBasic::open_elements::pop(void)
+{
+    auto            iter        = tagCounts.find(tagStack.back());
+    DomTree::node   *nd         = nodeStack.back();
+
+    if (not --iter->second)
+    {
+        tagCounts.erase(iter);
+    }
+    tagStack.pop_back();
+    nodeStack.pop_back();
+
+    // a flattened element repeats the node below it
+    if (onClose and nd != nodeStack.back())
+    {
+        onClose(*nd);
+    }
+}// end HtmlParserBasic::open_elements::pop
+
+// === HtmlParserBasic::open_elements::close ==============================
+//
+// Closes the innermost open element named <identifier>, along with any
+// elements opened within it; does nothing if there is none.
+//
+// ========================================================================
+void    HtmlParserBasic::open_elements::close(const string& identifier)
+{
+    if (not tagCounts.count(identifier))
+    {
+        return;
+    }
+
+    while (identifier != tagStack.back())
+    {
+        pop();
+    }
+    pop();
+}// end HtmlParserBasic::open_elements::close
+
+// === HtmlParserBasic::open_elements::close_all ==========================
+//
+// Closes every open element, innermost first (i.e. at the end of the
+// document).
+//
+// ========================================================================
+void    HtmlParserBasic::open_elements::close_all(void)
+{
+    while (not tagStack.empty())
+    {
+        pop();
+    }
+}// end HtmlParserBasic::open_elements::close_all
@@ -1,9 +1,11 @@
 #ifndef __HTML_PARSER_BASIC_HPP__
 #define __HTML_PARSER_BASIC_HPP__
 
-#include <stack>
+#include <functional>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "deps.hpp"
 #include "html_parser.hpp"
@@ -13,21 +15,63 @@
 //
 // Basic implementation of the HtmlParser Abstract Class.
 //
+// The parser is a loop over the tags in the document, driving an explicit
+// stack of open elements rather than recursing once per level of nesting,
+// so that deeply nested (i.e. unclosed) markup can't exhaust the C stack.
+// Elements opened beyond <maxDepth> levels (0 for no limit) are flattened:
+// they are added to the deepest open element, which also receives their
+// contents, keeping the tree shallow enough for the rest of the browser to
+// walk. Elements left open at the end of the document are closed, and end
+// tags matching no open element are ignored.
+//
+// A document already in memory is best parsed in place, from a range of
+// chars, which reads it with an HtmlTokenizer rather than through a
+// stream; one still arriving can be parsed as it does with an
+// HtmlPushParser.
+//
 // ========================================================================
 class   HtmlParserBasic : public HtmlParser
 {
+    // === friend class(es) ===============================================
+    friend class HtmlPushParser;
+
     public:
+        // === public member type(s) ======================================
+        typedef std::function<void(const DomTree::node& nd)>
+                                subtree_listener;
+
+        // === public constructor(s) ======================================
+        HtmlParserBasic(size_t maxDepth = DEFAULT_MAX_DEPTH);
+
+        // === public accessor(s) =========================================
+        auto    max_depth(void) const
+            -> size_t;
+
+        // === public mutator(s) ==========================================
+        void    set_max_depth(size_t maxDepth);
+
         // === public member function(s) ==================================
         void    parse_html(DomTree::node& root, std::istream& ins) const;
+        void    parse_html(
+                    DomTree::node& root,
+                    const char *begin,
+                    const char *end
+                ) const;
+
+        // === public static constant(s) ==================================
+        static const size_t     DEFAULT_MAX_DEPTH;
     private:
         // === private member class(es) ===================================
         struct  tag;
+        struct  open_elements;
+
+        // === private member variable(s) =================================
+        size_t          m_maxDepth      = 0;
 
         // === private static function(s) =================================
         static void     push_node(
                             std::istream& ins,
-                            std::stack<DomTree::node*>& nodeStack,
-                            std::stack<string>& tagStack
+                            open_elements& open
                         );
         static void     extract_literal_node(
                             std::istream& ins,
@@ -65,4 +109,30 @@ struct  HtmlParserBasic::tag
     static std::pair<string,string> read_attribute(std::istream& ins);
 };// end struct HtmlParserBasic::tag
 
+// === struct  HtmlParserBasic::open_elements =============================
+//
+// The elements open at the current point in the document, innermost last.
+// <nodeStack> always holds the root below the elements; a flattened
+// element repeats the node its contents go to. <tagCounts> counts the
+// open elements by tag, so that an end tag can be matched without
+// searching the stack. Closing elements passes each (unflattened) one to
+// <onClose>, if set.
+//
+// ========================================================================
+struct  HtmlParserBasic::open_elements
+{
+    // === public member variable(s) ======================================
+    std::vector<DomTree::node*>         nodeStack;
+    std::vector<string>                 tagStack;
+    std::unordered_map<string,size_t>   tagCounts;
+    size_t                              maxDepth        = 0;
+    subtree_listener                    onClose         = nullptr;
+
+    // === public mutator(s) ==============================================
+    void    push(const string& identifier, DomTree::node& nd);
+    void    pop(void);
+    void    close(const string& identifier);
+    void    close_all(void);
+};// end struct HtmlParserBasic::open_elements
+
 #endif
@@ -0,0 +1,295 @@
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+
+#include "deps.hpp"
+#include "utils.hpp"
+#include "dom_tree.hpp"
+#include "html_tokenizer.hpp"
+#include "html_parser_basic.hpp"
+
+#include "html_push_parser.hpp"
+
+// === class HtmlPushParser Implementation ================================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+HtmlPushParser::HtmlPushParser(
+    DomTree::node& root,
+    size_t maxDepth,
+    listener_type listener
+)
+{
+    m_open.maxDepth = maxDepth;
+    m_open.onClose = listener;
+    m_open.nodeStack.push_back(&root);
+}// end HtmlPushParser::HtmlPushParser
+
+// --- public accessors ---------------------------------------------------
+auto HtmlPushParser::finished(void) const
+    -> bool
+{
+    return m_finished;
+}// end HtmlPushParser::finished
+
+auto HtmlPushParser::bytes_fed(void) const
+    -> size_t
+{
+    return m_fed;
+}// end HtmlPushParser::bytes_fed
+
+// return: number of bytes held back until the token they start is
+//  complete
+auto HtmlPushParser::bytes_pending(void) const
+    -> size_t
+{
+    return m_pending.size();
+}// end HtmlPushParser::bytes_pending
+
+// --- public mutators ----------------------------------------------------
+
+// Parses the next <len> bytes of the document, at <data>.
+void HtmlPushParser::feed(const char *data, size_t len)
+{
+    size_t          consumed        = 0;
+
+    if (m_finished)
+    {
+        throw std::logic_error("html push parser fed after finish");
+    }
+
+    m_fed += len;
+
+    // nothing held back: parse the chunk in place, keeping its tail
+    if (m_pending.empty())
+    {
+        consumed = parse(data, data + len, false);
+        m_pending.assign(data + consumed, data + len);
+        m_scanned = 0;
+        return;
+    }
+
+    m_pending.append(data, len);
+    if (not may_complete())
+    {
+        return;
+    }
+
+    consumed = parse(m_pending.data(), m_pending.data() + m_pending.size(),
+        false);
+    if (consumed)
+    {
+        m_pending.erase(0, consumed);
+        m_scanned = 0;
+    }
+}// end HtmlPushParser::feed
+
+// Parses whatever was held back, as the end of the document, and closes
+// the elements still open.
+void HtmlPushParser::finish(void)
+{
+    if (m_finished)
+    {
+        return;
+    }
+
+    parse(m_pending.data(), m_pending.data() + m_pending.size(), true);
+    m_pending.clear();
+    m_scanned = 0;
+    m_open.close_all();
+    m_finished = true;
+}// end HtmlPushParser::finish
+
+// --- private member functions -------------------------------------------
+
+// Looks for the end of the token held back in m_pending, from where the
+// last look left off (m_scanned), so that each byte held back is scanned
+// about once however many chunks it takes to arrive: text ends at a '<',
+// a comment at "-->", a literal element's contents at its end tag, and
+// any other tag at a '>'. A tag's '>' may turn out to be quoted, but then
+// the one that ends it is still to come.
+//  return: false if the token can't be complete yet
+auto HtmlPushParser::may_complete(void)
+    -> bool
+{
+    typedef HtmlTokenizer::view_type    view_type;
+
+    const view_type         pending(m_pending);
+    size_t                  found       = view_type::npos;
+
+    if (m_literal)
+    {
+        const size_t    tagSize     = m_literalTag.size();
+
+        // "</" and the name, matched as HtmlTokenizer::read_literal does
+        for (
+            found = pending.find("</", m_scanned);
+            view_type::npos != found;
+            found = pending.find("</", found + 1)
+        )
+        {
+            if (pending.size() - found < tagSize + 3)
+            {
+                // the end tag may be cut off
+                m_scanned = found;
+                return false;
+            }
+            if (
+                (not strncasecmp(
+                    &pending[found + 2],
+                    m_literalTag.data(),
+                    tagSize
+                ))
+                and (not isalnum(
+                    (unsigned char)(pending[found + tagSize + 2])
+                ))
+            )
+            {
+                break;
+            }
+        }// end for found
+
+        if (view_type::npos == found)
+        {
+            // a '<' at the very end may start the end tag
+            m_scanned = pending.size() - ('<' == pending.back());
+            return false;
+        }
+
+        // the end tag is complete once its '>' is in
+        m_scanned = found;
+        return (view_type::npos != pending.find('>', found));
+    }
+
+    if ('<' != pending.front())
+    {
+        found = pending.find('<', m_scanned);
+    }
+    else if (0 == pending.compare(0, 4, "<!--"))
+    {
+        // "<!-->" doesn't close the comment
+        found = pending.find("-->", std::max(m_scanned, size_t(6)) - 2);
+    }
+    else
+    {
+        found = pending.find('>', m_scanned);
+    }
+    m_scanned = pending.size();
+
+    return (view_type::npos != found);
+}// end HtmlPushParser::may_complete
+
+// Adds the complete tokens in [begin, end) to the tree.
+//  return: number of bytes consumed
+auto HtmlPushParser::parse(const char *begin, const char *end, bool final)
+    -> size_t
+{
+    HtmlTokenizer       tokenizer(begin, end, final);
+
+    // a literal element started in an earlier chunk
+    if (m_literal and not read_literal(tokenizer))
+    {
+        return tokenizer.position();
+    }
+
+    while (tokenizer.next(m_token))
+    {
+        add_token();
+        if (m_literal and not read_literal(tokenizer))
+        {
+            break;
+        }
+    }// end while
+
+    return tokenizer.position();
+}// end HtmlPushParser::parse
+
+void HtmlPushParser::add_token(void)
+{
+    typedef HtmlTokenizer::Kind         Kind;
+
+    switch (m_token.kind)
+    {
+        case Kind::text:
+            // text outside of any element is dropped
+            if (not m_open.tagStack.empty())
+            {
+                m_open.nodeStack.back()->emplace_child_back(
+                    "text",
+                    string(m_token.text)
+                );
+            }
+            break;
+        case Kind::start:
+        case Kind::solo:
+            {
+                m_identifier.assign(m_token.name);
+                utils::to_lower(m_identifier);
+
+                DomTree::node&      currNode
+                    = m_open.nodeStack.back()->emplace_child_back(
+                        m_identifier
+                    );
+
+                for (const auto& attr : m_token.attributes)
+                {
+                    currNode.attributes[attr.name] = string(attr.value);
+                }// end for attr
+
+                if (
+                    m_token.kind == Kind::solo
+                    or HtmlParserBasic::is_empty_tag(m_identifier)
+                )
+                {
+                    closed(currNode);
+                }
+                // handle scripts specially
+                else if (m_identifier == "script" or m_identifier == "style")
+                {
+                    m_literal = &currNode;
+                    m_literalTag = m_identifier;
+                }
+                else
+                {
+                    m_open.push(m_identifier, currNode);
+                }
+            }
+            break;
+        case Kind::end:
+            m_identifier.assign(m_token.name);
+            utils::to_lower(m_identifier);
+            m_open.close(m_identifier);
+            break;
+        default:
+            // Do nothing
+            break;
+    }// end switch (m_token.kind)
+}// end HtmlPushParser::add_token
+
+// Reads the contents of the current literal element (i.e. <script>).
+//  return: false if its end tag hasn't arrived yet
+auto HtmlPushParser::read_literal(HtmlTokenizer& tokenizer)
+    -> bool
+{
+    HtmlTokenizer::view_type    text;
+
+    if (not tokenizer.read_literal(m_literalTag, text))
+    {
+        return false;
+    }
+
+    m_literal->emplace_child_back("text", string(text));
+    closed(*m_literal);
+    m_literal = nullptr;
+
+    return true;
+}// end HtmlPushParser::read_literal
+
+void HtmlPushParser::closed(const DomTree::node& nd)
+{
+    if (m_open.onClose)
+    {
+        m_open.onClose(nd);
+    }
+}// end HtmlPushParser::closed
@@ -0,0 +1,85 @@
+#ifndef __HTML_PUSH_PARSER_HPP__
+#define __HTML_PUSH_PARSER_HPP__
+
+#include "deps.hpp"
+#include "dom_tree.hpp"
+#include "html_tokenizer.hpp"
+#include "html_parser_basic.hpp"
+
+// === class HtmlPushParser ===============================================
+//
+// Parses an html document as it arrives, a chunk at a time, into a
+// DomTree, so that parsing can overlap the transfer. Each chunk is fed
+// in as it's received, and finish() is called at the end of the document.
+// Elements are appended to the tree as soon as their tags are complete;
+// text, once the tag that follows it has started.
+//
+// Chunks may split the document anywhere (i.e. inside a tag, an attribute
+// value, a comment or a <script>): a token left incomplete at the end of a
+// chunk is kept, and read again whole once the chunks after it complete
+// it. Only the bytes that arrive after it are searched for its end, and
+// it's read again once that end is in, so a long token (i.e. a <script>
+// or a comment) costs time in proportion to its length, however finely it
+// is split. Nothing else is copied; a chunk that doesn't continue a token
+// is tokenized in place. The tree built is the same as HtmlParserBasic would
+// build from the whole document, however it is split.
+//
+// The listener, if any, is passed each element as it closes (along with
+// everything in it), innermost first: when its end tag is read, when it is
+// closed implicitly (i.e. by the end tag of an element it is in), or, for
+// elements without content (i.e. <br>), when it is read. Elements still
+// open are closed by finish().
+//
+// Throws:
+//      HtmlParser::except_invalid_token, if the document contains a start
+//      tag without a name
+//
+// ========================================================================
+class HtmlPushParser
+{
+    public:
+        // --- public member types ----------------------------------------
+        typedef     HtmlParserBasic::subtree_listener   listener_type;
+
+        // --- public constructors ----------------------------------------
+        HtmlPushParser(
+            DomTree::node& root,
+            size_t maxDepth = HtmlParserBasic::DEFAULT_MAX_DEPTH,
+            listener_type listener = nullptr
+        );
+
+        // --- public accessors -------------------------------------------
+        auto finished(void) const
+            -> bool;
+        auto bytes_fed(void) const
+            -> size_t;
+        auto bytes_pending(void) const
+            -> size_t;
+
+        // --- public mutators --------------------------------------------
+        void feed(const char *data, size_t len);
+        void finish(void);
+    private:
+        // --- private member variables -----------------------------------
+        HtmlParserBasic::open_elements  m_open          = {};
+        string                          m_pending       = "";
+        DomTree::node                   *m_literal      = nullptr;
+        string                          m_literalTag    = "";
+        string                          m_identifier    = "";
+        HtmlTokenizer::Token            m_token         = {};
+        size_t                          m_scanned       = 0;
+        size_t                          m_fed           = 0;
+        bool                            m_finished      = false;
+
+        // --- private member functions -----------------------------------
+        auto parse(const char *begin, const char *end, bool final)
+            -> size_t;
+        auto may_complete(void)
+            -> bool;
+        void add_token(void);
+        auto read_literal(HtmlTokenizer& tokenizer)
+            -> bool;
+        void closed(const DomTree::node& nd);
+};// end class HtmlPushParser
+
+#endif
@@ -0,0 +1,351 @@
+#include <cctype>
+#include <cstring>
+#include <string_view>
+
+#include "deps.hpp"
+#include "byte_set.hpp"
+#include "html_parser.hpp"
+
+#include "html_tokenizer.hpp"
+
+// === Delimiter Sets =====================================================
+//
+// ========================================================================
+namespace
+{
+    // ends text
+    const ByteSet       TEXT_DELIMS("<");
+    // ends a tag name
+    const ByteSet       NAME_DELIMS(" \t\r\n<>/");
+    // ends an attribute name, or an unquoted attribute value
+    const ByteSet       ATTR_DELIMS(" \t\r\n<>=");
+}// end namespace
+
+// === class HtmlTokenizer Implementation =================================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+HtmlTokenizer::HtmlTokenizer(void)
+{
+    // do nothing
+}// end HtmlTokenizer::HtmlTokenizer
+
+HtmlTokenizer::HtmlTokenizer(const char *begin, const char *end, bool final)
+{
+    m_begin = begin;
+    m_curr = begin;
+    m_end = end;
+    m_final = final;
+}// end HtmlTokenizer::HtmlTokenizer
+
+// --- public accessors ---------------------------------------------------
+
+// return: offset of the next token from the start of the block (i.e. the
+//  number of bytes consumed)
+auto HtmlTokenizer::position(void) const
+    -> size_t
+{
+    return m_curr - m_begin;
+}// end HtmlTokenizer::position
+
+auto HtmlTokenizer::at_end(void) const
+    -> bool
+{
+    return m_curr == m_end;
+}// end HtmlTokenizer::at_end
+
+// --- public mutators ----------------------------------------------------
+
+// Reads the next token into <token>, reusing its storage.
+//  return: false (with token.kind set to eof) if there are no more tokens,
+//  or, if the block isn't final, no more complete ones
+auto HtmlTokenizer::next(Token& token)
+    -> bool
+{
+    const char      *start      = m_curr;
+
+    token.name = {};
+    token.text = {};
+    token.attributes.clear();
+
+    if (m_curr == m_end)
+    {
+        token.kind = Kind::eof;
+        return false;
+    }
+
+    // Case 1: text
+    if (*m_curr != '<')
+    {
+        m_curr = TEXT_DELIMS.find_first(m_curr, m_end);
+        if (m_curr == m_end and need_more(token, start))
+        {
+            return false;
+        }
+        token.kind = Kind::text;
+        token.text = view_type(start, m_curr - start);
+        return true;
+    }
+
+    ++m_curr;// initial <
+    skip_whitespace();
+    if (m_curr == m_end and need_more(token, start))
+    {
+        return false;
+    }
+
+    // Case 2: end tag
+    if (m_curr != m_end and *m_curr == '/')
+    {
+        ++m_curr;
+        skip_whitespace();
+        token.kind = Kind::end;
+        token.name = scan_until(NAME_DELIMS);
+        if (not skip_past(">") and need_more(token, start))
+        {
+            return false;
+        }
+        return true;
+    }
+    // Case 3: comment, or declaration (i.e. <!DOCTYPE ...>)
+    else if (m_curr != m_end and *m_curr == '!')
+    {
+        const view_type     rest(m_curr + 1, m_end - m_curr - 1);
+        bool                found       = false;
+
+        ++m_curr;
+        token.kind = Kind::comment;
+        if (rest.size() < 2 and need_more(token, start))
+        {
+            return false;
+        }
+        else if (rest.substr(0, 2) == "--")
+        {
+            m_curr += 2;
+            found = skip_past("-->");
+        }
+        else
+        {
+            found = skip_past(">");
+        }
+        if (not found and need_more(token, start))
+        {
+            return false;
+        }
+        return true;
+    }
+    // Case 4: processing instruction (i.e. <?xml ...?>)
+    else if (m_curr != m_end and *m_curr == '?')
+    {
+        ++m_curr;
+        token.kind = Kind::version;
+        if (not skip_past("?>") and need_more(token, start))
+        {
+            return false;
+        }
+        return true;
+    }
+
+    // Case 5: start tag
+    token.name = scan_until(NAME_DELIMS);
+    if (m_curr == m_end and need_more(token, start))
+    {
+        return false;
+    }
+    else if (token.name.empty())
+    {
+        const char      *eol        = (const char*)(
+                                        memchr(m_curr, '\n', m_end - m_curr)
+                                    );
+
+        throw HtmlParser::except_invalid_token(
+            string(m_curr, eol ? eol : m_end)
+        );
+    }
+    if (not read_attributes(token) and need_more(token, start))
+    {
+        return false;
+    }
+
+    return true;
+}// end HtmlTokenizer::next
+
+// Reads the contents of a literal element (i.e. <script>), which aren't
+// markup, up to and including the end tag named <tagName> (matched
+// case-insensitively), into <text>: up to the end tag, or the end of the
+// block.
+//  return: false, consuming nothing, if the block isn't final and the end
+//  tag isn't in it
+auto HtmlTokenizer::read_literal(view_type tagName, view_type& text)
+    -> bool
+{
+    const char      *start      = m_curr;
+
+    while (m_curr != m_end)
+    {
+        const char      *lt     = TEXT_DELIMS.find_first(m_curr, m_end);
+        view_type       rest;
+
+        if (lt == m_end)
+        {
+            break;
+        }
+
+        m_curr = lt + 1;
+        rest = view_type(m_curr, m_end - m_curr);
+        if (
+            (rest.size() > tagName.size() + 1)
+            and ('/' == rest[0])
+            and (not strncasecmp(&rest[1], tagName.data(), tagName.size()))
+            and (not isalnum((unsigned char)(rest[tagName.size() + 1])))
+        )
+        {
+            if (not skip_past(">") and not m_final)
+            {
+                break;
+            }
+            text = view_type(start, lt - start);
+            return true;
+        }
+    }// end while
+
+    if (not m_final)
+    {
+        m_curr = start;
+        return false;
+    }
+
+    m_curr = m_end;
+    text = view_type(start, m_end - start);
+    return true;
+}// end HtmlTokenizer::read_literal
+
+// --- private member functions -------------------------------------------
+void HtmlTokenizer::skip_whitespace(void)
+{
+    while (m_curr != m_end and isspace((unsigned char)(*m_curr)))
+    {
+        ++m_curr;
+    }// end while
+}// end HtmlTokenizer::skip_whitespace
+
+// Moves the cursor past the next occurrence of <sentinel>, or to the end
+// of the block if there is none.
+//  return: true if <sentinel> was found
+auto HtmlTokenizer::skip_past(view_type sentinel)
+    -> bool
+{
+    const auto      idx     = view_type(m_curr, m_end - m_curr).find(sentinel);
+
+    if (view_type::npos == idx)
+    {
+        m_curr = m_end;
+        return false;
+    }
+
+    m_curr += idx + sentinel.size();
+    return true;
+}// end HtmlTokenizer::skip_past
+
+// return: the text up to the first delimiter in <delims>, which the cursor
+//  is left on
+auto HtmlTokenizer::scan_until(const ByteSet& delims)
+    -> view_type
+{
+    const char      *start      = m_curr;
+
+    m_curr = delims.find_first(m_curr, m_end);
+
+    return view_type(start, m_curr - start);
+}// end HtmlTokenizer::scan_until
+
+// Reads the attributes of a start tag, up to and including its closing
+// '>'. A '/' makes the tag solo, unless attributes follow it.
+//  return: true if the closing '>' was found
+auto HtmlTokenizer::read_attributes(Token& token)
+    -> bool
+{
+    token.kind = Kind::start;
+
+    skip_whitespace();
+    while (m_curr != m_end and *m_curr != '>')
+    {
+        Attribute       attr        = {};
+
+        if (*m_curr == '/')
+        {
+            ++m_curr;
+            token.kind = Kind::solo;
+            skip_whitespace();
+            continue;
+        }
+
+        attr.name = scan_until(ATTR_DELIMS);
+        if (m_curr != m_end and *m_curr == '=')
+        {
+            ++m_curr;
+            skip_whitespace();
+            if (m_curr != m_end and (*m_curr == '"' or *m_curr == '\''))
+            {
+                const char      quote       = *m_curr++;
+                const char      *close      = (const char*)(
+                                                memchr(
+                                                    m_curr,
+                                                    quote,
+                                                    m_end - m_curr
+                                                )
+                                            );
+
+                if (not close)
+                {
+                    close = m_end;
+                }
+                attr.value = view_type(m_curr, close - m_curr);
+                m_curr = (close == m_end) ? m_end : close + 1;
+            }
+            else if (m_curr != m_end and *m_curr != '/' and *m_curr != '>')
+            {
+                attr.value = scan_until(ATTR_DELIMS);
+            }
+        }
+        else if (attr.name.empty())
+        {
+            // stray '<'
+            ++m_curr;
+            skip_whitespace();
+            continue;
+        }
+
+        token.attributes.push_back(attr);
+        token.kind = Kind::start;
+        skip_whitespace();
+    }// end while
+
+    if (m_curr == m_end)
+    {
+        return false;
+    }
+
+    ++m_curr;// closing >
+    return true;
+}// end HtmlTokenizer::read_attributes
+
+// Ends a token that runs off the end of a block that isn't final, which
+// is left to be read again, whole, once more of the document has arrived.
+//  return: false if the block is final, and the token ends with it
+auto HtmlTokenizer::need_more(Token& token, const char *start)
+    -> bool
+{
+    if (m_final)
+    {
+        return false;
+    }
+
+    m_curr = start;
+    token.kind = Kind::eof;
+    token.name = {};
+    token.text = {};
+    token.attributes.clear();
+    return true;
+}// end HtmlTokenizer::need_more
@@ -0,0 +1,104 @@
+#ifndef __HTML_TOKENIZER_HPP__
+#define __HTML_TOKENIZER_HPP__
+
+#include <string_view>
+
+#include "deps.hpp"
+#include "byte_set.hpp"
+
+// === class HtmlTokenizer ================================================
+//
+// Splits an html document held in one contiguous block of memory (i.e. a
+// ByteBuffer) into text, tags, comments and processing instructions. The
+// cursor is a plain pointer into the block, so scanning costs no stream
+// calls; delimiters are found with ByteSet's vector kernels. Tokens hand
+// out views into the block rather than copies: names keep the case they
+// were written in, and text is raw (entities are left for the document to
+// decode). Views are valid as long as the block is.
+//
+// Tags are read as HtmlParserBasic reads them from a stream, with these
+// exceptions:
+//  - a comment ends at the first "-->"; other <!...> declarations end at
+//    the first '>'
+//  - a processing instruction ends at the first "?>"
+//  - a stray '<' inside a tag is skipped, rather than read as an
+//    attribute name
+//  - the end tag of a literal element is matched case-insensitively, and
+//    other end tags within it are kept whole
+//
+// The contents of <script> and <style> elements aren't markup; once their
+// start tag is read, read_literal() takes everything up to their end tag.
+//
+// A block that isn't <final> is the start of a document whose rest hasn't
+// arrived yet (see HtmlPushParser). A token that runs off its end (i.e. a
+// tag without its '>', or text that may go on) isn't returned; position()
+// then tells how much of the block was consumed, and the rest is to be
+// tokenized again with the next part of the document appended.
+//
+// Throws:
+//      HtmlParser::except_invalid_token, if a start tag has no name
+//
+// ========================================================================
+class HtmlTokenizer
+{
+    public:
+        // --- public member types ----------------------------------------
+        typedef     std::string_view            view_type;
+        enum class  Kind
+        {
+            eof         = 0,
+            text,
+            start,
+            end,
+            solo,
+            comment,
+            version,
+        };// end enum class Kind
+        struct      Attribute
+        {
+            view_type       name;
+            view_type       value;
+        };// end struct Attribute
+        struct      Token
+        {
+            Kind                        kind            = Kind::eof;
+            view_type                   name            = {};
+            view_type                   text            = {};
+            std::vector<Attribute>      attributes      = {};
+        };// end struct Token
+
+        // --- public constructors ----------------------------------------
+        HtmlTokenizer(void);
+        HtmlTokenizer(const char *begin, const char *end, bool final = true);
+
+        // --- public accessors -------------------------------------------
+        auto position(void) const
+            -> size_t;
+        auto at_end(void) const
+            -> bool;
+
+        // --- public mutators --------------------------------------------
+        auto next(Token& token)
+            -> bool;
+        auto read_literal(view_type tagName, view_type& text)
+            -> bool;
+    private:
+        // --- private member variables -----------------------------------
+        const char      *m_begin        = nullptr;
+        const char      *m_curr         = nullptr;
+        const char      *m_end          = nullptr;
+        bool            m_final         = true;
+
+        // --- private member functions -----------------------------------
+        void skip_whitespace(void);
+        auto skip_past(view_type sentinel)
+            -> bool;
+        auto scan_until(const ByteSet& delims)
+            -> view_type;
+        auto read_attributes(Token& token)
+            -> bool;
+        auto need_more(Token& token, const char *start)
+            -> bool;
+};// end class HtmlTokenizer
+
+#endif
@@ -0,0 +1,588 @@
+#include <cstdio>
+#include <cstdint>
+#include <cctype>
+#include <cerrno>
+#include <ctime>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "deps.hpp"
+#include "uri.hpp"
+#include "http_fetcher.hpp"
+
+#include "http_cache.hpp"
+
+// === class HttpCache Implementation =====================================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+HttpCache::HttpCache(void)
+{
+    // do nothing
+}// end HttpCache::HttpCache
+
+HttpCache::HttpCache(const Config& cfg)
+{
+    m_dir = cfg.dir;
+    m_maxSize = cfg.maxSize;
+}// end HttpCache::HttpCache
+
+// --- public accessors ---------------------------------------------------
+auto HttpCache::enabled(void) const
+    -> bool
+{
+    return (not m_dir.empty()) and m_maxSize;
+}// end HttpCache::enabled
+
+auto HttpCache::dir(void) const
+    -> const string&
+{
+    return m_dir;
+}// end HttpCache::dir
+
+auto HttpCache::max_size(void) const
+    -> size_t
+{
+    return m_maxSize;
+}// end HttpCache::max_size
+
+// --- public mutators ----------------------------------------------------
+
+// Reads the stored response for a url, if any, and marks it as recently
+// used. Whether it may be served as-is is up to the caller (see is_fresh).
+//  return: true if an entry was found
+auto HttpCache::lookup(const Uri& url, Entry& entry)
+    -> bool
+{
+    using namespace std;
+
+    const string    fname       = path(url);
+    ifstream        ins;
+    string          line        = "";
+
+    if (not enabled())
+    {
+        return false;
+    }
+
+    ins.open(fname, ios::binary);
+    if (not ins)
+    {
+        return false;
+    }
+
+    // guard against hash collisions
+    if ((not getline(ins, line)) or (line != key(url)))
+    {
+        return false;
+    }
+
+    if (
+        (not getline(ins, line))
+        or (1 != sscanf(line.c_str(), " %ld", &entry.storedAt))
+    )
+    {
+        return false;
+    }
+
+    entry.status = {};
+    entry.headers = {};
+    if (
+        (not getline(ins, line))
+        or (not HttpFetcher::parse_status_line(entry.status, line))
+    )
+    {
+        return false;
+    }
+
+    while (getline(ins, line) and (not line.empty()))
+    {
+        entry.headers.add_line(line);
+    }// end while
+
+    entry.body.assign(
+        istreambuf_iterator<char>(ins),
+        istreambuf_iterator<char>()
+    );
+
+    // bump to most recently used
+    utimensat(AT_FDCWD, fname.c_str(), nullptr, 0);
+
+    return true;
+}// end HttpCache::lookup
+
+// Stores a response, if it is cacheable.
+//  return: true if the response was stored
+auto HttpCache::store(
+    const Uri& url,
+    const HttpFetcher::Status& status,
+    const HttpFetcher::header_type& headers,
+    const HttpFetcher::data_container& body
+) -> bool
+{
+    Entry       entry       = {};
+
+    if ((not enabled()) or (200 != status.code) or (body.size() > m_maxSize))
+    {
+        return false;
+    }
+
+    // don't keep a truncated body
+    {
+        size_t      length;
+
+        if (headers.content_length(length) and (length != body.size()))
+        {
+            return false;
+        }
+    }
+
+    for (const auto& directive : cache_directives(headers))
+    {
+        if ("no-store" == directive)
+        {
+            remove(url);
+            return false;
+        }
+    }// end for directive
+
+    entry.status = status;
+    entry.headers = headers;
+    entry.body = body;
+    entry.storedAt = time(nullptr);
+
+    // neither servable nor revalidatable
+    if (
+        (freshness_lifetime(entry) <= 0)
+        and (not headers.count("etag"))
+        and (not headers.count("last-modified"))
+    )
+    {
+        remove(url);
+        return false;
+    }
+
+    if (not write_entry(url, entry))
+    {
+        return false;
+    }
+
+    evict();
+
+    return true;
+}// end HttpCache::store
+
+// Updates a stale entry with the headers of a "304 Not Modified" response,
+// which makes it fresh again.
+void HttpCache::refresh(
+    const Uri& url,
+    Entry& entry,
+    const HttpFetcher::header_type& headers
+)
+{
+    for (const auto field : headers)
+    {
+        // these describe the (empty) 304 response, not the stored body
+        if (
+            ("content-length" == field.name)
+            or ("transfer-encoding" == field.name)
+        )
+        {
+            continue;
+        }
+
+        entry.headers.set(field.name, field.value);
+    }// end for field
+
+    entry.storedAt = time(nullptr);
+
+    if (enabled())
+    {
+        write_entry(url, entry);
+    }
+}// end HttpCache::refresh
+
+void HttpCache::remove(const Uri& url)
+{
+    if (enabled())
+    {
+        ::unlink(path(url).c_str());
+    }
+}// end HttpCache::remove
+
+// --- public static functions --------------------------------------------
+
+// Normalizes a url for use as a cache key: scheme and host are
+// case-insensitive, and fragments are never sent to the server.
+auto HttpCache::key(const Uri& url)
+    -> string
+{
+    Uri         norm    = url;
+
+    for (char& ch : norm.scheme)
+    {
+        ch = tolower(ch);
+    }// end for ch
+    for (char& ch : norm.host)
+    {
+        ch = tolower(ch);
+    }// end for ch
+
+    norm.fragment.clear();
+    if (norm.path.empty())
+    {
+        norm.path = "/";
+    }
+
+    return norm.str();
+}// end HttpCache::key
+
+// return: true if an entry may be served without asking the server
+auto HttpCache::is_fresh(const Entry& entry, time_t now)
+    -> bool
+{
+    return freshness_lifetime(entry) > (now - entry.storedAt);
+}// end HttpCache::is_fresh
+
+// return: how long (in seconds) after being stored an entry may be served
+//  without revalidation; 0 if it must always be revalidated
+auto HttpCache::freshness_lifetime(const Entry& entry)
+    -> time_t
+{
+    const auto&     headers     = entry.headers;
+    time_t          expires;
+    time_t          date;
+
+    for (const auto& directive : cache_directives(headers))
+    {
+        long        maxAge;
+
+        if ("no-cache" == directive)
+        {
+            return 0;
+        }
+        else if (1 == sscanf(directive.c_str(), "max-age=%ld", &maxAge))
+        {
+            return std::max(maxAge, 0L);
+        }
+    }// end for directive
+
+    if (not headers.get("expires").empty())
+    {
+        expires = parse_http_date(string(headers.get("expires")));
+        date = entry.storedAt;
+
+        if (not headers.get("date").empty())
+        {
+            const time_t    sent    = parse_http_date(
+                                        string(headers.get("date"))
+                                    );
+
+            if (sent >= 0)
+            {
+                date = sent;
+            }
+        }
+
+        return (expires >= date) ? (expires - date) : 0;
+    }
+
+    return 0;
+}// end HttpCache::freshness_lifetime
+
+// return: true if the Cache-Control of a response has <directive> (i.e.
+//  "no-store")
+auto HttpCache::has_directive(
+    const HttpFetcher::header_type& headers,
+    const string& directive
+) -> bool
+{
+    const auto      directives  = cache_directives(headers);
+
+    return (
+        std::find(directives.cbegin(), directives.cend(), directive)
+        != directives.cend()
+    );
+}// end HttpCache::has_directive
+
+// return: true if a response says how long it is fresh (with max-age or
+//  Expires), rather than leaving it to the cache
+auto HttpCache::has_explicit_freshness(
+    const HttpFetcher::header_type& headers
+) -> bool
+{
+    for (const auto& directive : cache_directives(headers))
+    {
+        if (0 == directive.compare(0, 8, "max-age="))
+        {
+            return true;
+        }
+    }// end for directive
+
+    return not headers.get("expires").empty();
+}// end HttpCache::has_explicit_freshness
+
+// return: request variables asking the handler to fetch a url only if it
+//  has changed since the entry was stored
+auto HttpCache::revalidation_env(const Entry& entry)
+    -> HttpFetcher::env_map
+{
+    HttpFetcher::env_map    env     = {};
+
+    if (not entry.headers.get("etag").empty())
+    {
+        env["W3M_IF_NONE_MATCH"] = entry.headers.get("etag");
+    }
+    if (not entry.headers.get("last-modified").empty())
+    {
+        env["W3M_IF_MODIFIED_SINCE"] = entry.headers.get("last-modified");
+    }
+
+    return env;
+}// end HttpCache::revalidation_env
+
+// --- private accessors --------------------------------------------------
+
+// return: cache file for a url, named by the 64-bit FNV-1a hash of its key
+auto HttpCache::path(const Uri& url) const
+    -> string
+{
+    const string    str         = key(url);
+    uint64_t        hash        = 0xcbf29ce484222325;
+    char            name[17];
+
+    for (const char ch : str)
+    {
+        hash ^= static_cast<unsigned char>(ch);
+        hash *= 0x100000001b3;
+    }// end for ch
+
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long)hash);
+
+    return m_dir + "/" + name;
+}// end HttpCache::path
+
+// Writes an entry to a temporary file, then moves it into place, so that a
+// partially written entry is never read back.
+auto HttpCache::write_entry(const Uri& url, const Entry& entry) const
+    -> bool
+{
+    using namespace std;
+
+    const string    fname       = path(url);
+    const string    tmpName     = fname + ".tmp" + to_string(getpid());
+    ofstream        outs;
+
+    // create cache directory (and its parents) as needed
+    for (size_t idx = 1; idx != string::npos; idx = m_dir.find('/', idx + 1))
+    {
+        mkdir(m_dir.substr(0, idx).c_str(), 0700);
+    }// end for idx
+    mkdir(m_dir.c_str(), 0700);
+
+    outs.open(tmpName, ios::binary | ios::trunc);
+    if (not outs)
+    {
+        return false;
+    }
+
+    outs << key(url) << '\n';
+    outs << entry.storedAt << '\n';
+    outs << (entry.status.version.empty() ? "HTTP/1.1" : entry.status.version)
+        << ' ' << entry.status.code << ' ' << entry.status.reason << '\n';
+    for (const auto field : entry.headers)
+    {
+        outs << field.name << ": " << field.value << '\n';
+    }// end for field
+    outs << '\n';
+    outs.write(entry.body.data(), entry.body.size());
+    outs.close();
+
+    if ((not outs) or rename(tmpName.c_str(), fname.c_str()))
+    {
+        ::unlink(tmpName.c_str());
+        return false;
+    }
+
+    return true;
+}// end HttpCache::write_entry
+
+// --- private mutators ---------------------------------------------------
+
+// Removes least recently used entries until the cache fits its budget.
+void HttpCache::evict(void)
+{
+    struct  CacheFile
+    {
+        string      name;
+        off_t       size;
+        timespec    mtime;
+    };
+
+    std::vector<CacheFile>  files       = {};
+    size_t                  total       = 0;
+    DIR                     *dirp       = opendir(m_dir.c_str());
+
+    if (not dirp)
+    {
+        return;
+    }
+
+    while (struct dirent *ent = readdir(dirp))
+    {
+        const string    name    = m_dir + "/" + ent->d_name;
+        struct stat     st;
+
+        // entries only; skip temporary files and anything else
+        if (
+            (16 != strlen(ent->d_name))
+            or (strspn(ent->d_name, "0123456789abcdef") != 16)
+            or stat(name.c_str(), &st)
+            or (not S_ISREG(st.st_mode))
+        )
+        {
+            continue;
+        }
+
+        files.push_back({ name, st.st_size, st.st_mtim });
+        total += st.st_size;
+    }// end while
+    closedir(dirp);
+
+    if (total <= m_maxSize)
+    {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(),
+        [](const CacheFile& a, const CacheFile& b)
+        {
+            return (a.mtime.tv_sec < b.mtime.tv_sec)
+                or (
+                    (a.mtime.tv_sec == b.mtime.tv_sec)
+                    and (a.mtime.tv_nsec < b.mtime.tv_nsec)
+                );
+        });
+
+    for (const auto& file : files)
+    {
+        if (total <= m_maxSize)
+        {
+            break;
+        }
+
+        if (0 == ::unlink(file.name.c_str()))
+        {
+            total -= file.size;
+        }
+    }// end for file
+}// end HttpCache::evict
+
+// --- private static functions -------------------------------------------
+
+// return: lower-case Cache-Control directives (i.e. "no-cache",
+//  "max-age=60")
+auto HttpCache::cache_directives(const HttpFetcher::header_type& headers)
+    -> std::vector<string>
+{
+    std::vector<string>     directives  = {};
+
+    for (const auto field : headers)
+    {
+        const auto&     value   = field.value;
+        size_t          beg     = 0;
+
+        if ("cache-control" != field.name)
+        {
+            continue;
+        }
+
+        while (beg <= value.size())
+        {
+            size_t      end     = value.find(',', beg);
+            string      token   = "";
+
+            if (value.npos == end)
+            {
+                end = value.size();
+            }
+
+            for (size_t i = beg; i < end; ++i)
+            {
+                if (not isspace(value[i]))
+                {
+                    token += tolower(value[i]);
+                }
+            }// end for i
+
+            if (not token.empty())
+            {
+                directives.push_back(token);
+            }
+
+            beg = end + 1;
+        }// end while
+    }// end for field
+
+    return directives;
+}// end HttpCache::cache_directives
+
+// Parses an HTTP date (i.e. "Sun, 06 Nov 1994 08:49:37 GMT"). The day
+// and month names are always English, so they're matched against fixed
+// tables rather than with strptime, which follows the locale (LC_TIME).
+//  return: the time, or -1 if the date is invalid
+auto HttpCache::parse_http_date(const string& str)
+    -> time_t
+{
+    static const char   *const DAYS[]       = {
+        "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat",
+    };
+    static const char   *const MONTHS[]     = {
+        "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+        "Jul", "Aug", "Sep", "Oct", "Nov", "Dec",
+    };
+    struct tm           tm          = {};
+    char                day[4]      = "";
+    char                month[4]    = "";
+    int                 end         = 0;
+
+    if (
+        7 != sscanf(
+            str.c_str(),
+            " %3[A-Za-z], %2d %3[A-Za-z] %4d %2d:%2d:%2d GMT%n",
+            day, &tm.tm_mday, month, &tm.tm_year,
+            &tm.tm_hour, &tm.tm_min, &tm.tm_sec, &end
+        )
+        or not end
+        or std::none_of(
+            std::begin(DAYS), std::end(DAYS),
+            [&day](const char *name) { return 0 == strcmp(name, day); }
+        )
+    )
+    {
+        return -1;
+    }
+
+    tm.tm_mon = -1;
+    for (int i = 0; i < 12; ++i)
+    {
+        if (0 == strcmp(MONTHS[i], month))
+        {
+            tm.tm_mon = i;
+        }
+    }// end for i
+    if (tm.tm_mon < 0)
+    {
+        return -1;
+    }
+    tm.tm_year -= 1900;
+
+    return timegm(&tm);
+}// end HttpCache::parse_http_date
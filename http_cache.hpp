@@ -0,0 +1,111 @@
+#ifndef __HTTP_CACHE_HPP__
+#define __HTTP_CACHE_HPP__
+
+#include <ctime>
+
+#include "deps.hpp"
+#include "uri.hpp"
+#include "http_fetcher.hpp"
+
+// === class HttpCache ====================================================
+//
+// Persistent cache of fetched responses, stored one file per url in a
+// cache directory. Files are named by a hash of the normalized url (see
+// HttpCache::key) and hold the url, the time the response was stored, and
+// the response itself (status line, headers, blank line, body).
+//
+// Only complete 200 responses to GET requests are stored, and only if they
+// can either be served fresh (Cache-Control max-age, or Expires) or be
+// revalidated (ETag, Last-Modified). Responses marked no-store are never
+// stored. Stale entries are revalidated by passing the handler
+// W3M_IF_NONE_MATCH and W3M_IF_MODIFIED_SINCE (see revalidation_env); a
+// "304 Not Modified" answer refreshes the stored entry.
+//
+// Once the directory grows past its size budget, the least recently used
+// entries (by file modification time, which is bumped on every hit) are
+// removed.
+//
+// ========================================================================
+class HttpCache
+{
+    public:
+        // --- public member types ----------------------------------------
+        struct  Config
+        {
+            string      dir;
+            size_t      maxSize;
+        };// end struct Config
+        struct  Entry
+        {
+            HttpFetcher::Status             status      = {};
+            HttpFetcher::header_type        headers     = {};
+            HttpFetcher::data_container     body        = {};
+            time_t                          storedAt    = 0;
+        };// end struct Entry
+
+        // --- public constructors ----------------------------------------
+        HttpCache(void);
+        HttpCache(const Config& cfg);
+
+        // --- public accessors -------------------------------------------
+        auto enabled(void) const
+            -> bool;
+        auto dir(void) const
+            -> const string&;
+        auto max_size(void) const
+            -> size_t;
+
+        // --- public mutators --------------------------------------------
+        auto lookup(const Uri& url, Entry& entry)
+            -> bool;
+        auto store(
+            const Uri& url,
+            const HttpFetcher::Status& status,
+            const HttpFetcher::header_type& headers,
+            const HttpFetcher::data_container& body
+        ) -> bool;
+        void refresh(
+            const Uri& url,
+            Entry& entry,
+            const HttpFetcher::header_type& headers
+        );
+        void remove(const Uri& url);
+
+        // --- public static functions ------------------------------------
+        static auto key(const Uri& url)
+            -> string;
+        static auto is_fresh(const Entry& entry, time_t now)
+            -> bool;
+        static auto freshness_lifetime(const Entry& entry)
+            -> time_t;
+        static auto has_directive(
+            const HttpFetcher::header_type& headers,
+            const string& directive
+        ) -> bool;
+        static auto has_explicit_freshness(
+            const HttpFetcher::header_type& headers
+        ) -> bool;
+        static auto revalidation_env(const Entry& entry)
+            -> HttpFetcher::env_map;
+    private:
+        // --- private member variables -----------------------------------
+        string      m_dir           = "";
+        size_t      m_maxSize       = 0;
+
+        // --- private accessors ------------------------------------------
+        auto path(const Uri& url) const
+            -> string;
+        auto write_entry(const Uri& url, const Entry& entry) const
+            -> bool;
+
+        // --- private mutators -------------------------------------------
+        void evict(void);
+
+        // --- private static functions -----------------------------------
+        static auto cache_directives(const HttpFetcher::header_type& headers)
+            -> std::vector<string>;
+        static auto parse_http_date(const string& str)
+            -> time_t;
+};// end class HttpCache
+
+#endif
@@ -1,31 +1,49 @@
 #include <cstdio>
+#include <cstring>
 #include <cctype>
+#include <cerrno>
+#include <algorithm>
 #include <map>
 
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <netdb.h>
+#include <sys/socket.h>
+
 #include "deps.hpp"
 #include "command.hpp"
 #include "uri.hpp"
 
 #include "http_fetcher.hpp"
 
-#define     READ_LEN    0x1000
+#define     READ_LEN            0x1000
+#define     DIRECT_READ_LEN     0x40000
+#define     UPDATE_LEN          0x40000
+#define     MAX_RESERVE_LEN     0x4000000
 
 // === class HttpFetcher Implementation ===================================
 //
 // ========================================================================
 
+// --- public static constants --------------------------------------------
+const string HttpFetcher::NATIVE_HANDLER = "w3m-native-http";
+
 // --- public constructors ------------------------------------------------
 
 HttpFetcher::HttpFetcher(
     const string& shellCommand,
     const string& urlEnv,
-    const env_map& env
+    const env_map& env,
+    const Mode mode
 )
 {
     m_cmd = Command(shellCommand)
         .set_stdout_piped(true)
         .set_stdin_piped(true);
     m_urlEnv = urlEnv;
+    m_mode = (NATIVE_HANDLER == shellCommand) ? Mode::native : mode;
 
     for (const auto& kv : env)
     {
@@ -33,7 +51,32 @@ HttpFetcher::HttpFetcher(
     }// end for
 }// end type constructor
 
+HttpFetcher::~HttpFetcher(void)
+{
+    // idle coprocesses exit on EOF; make sure of it
+    for (auto& sproc : m_coprocesses)
+    {
+        sproc.stdin().close();
+        sproc.stdout().close();
+        sproc.kill(SIGTERM);
+        sproc.wait();
+    }// end for
+
+    for (const auto& kv : m_connections)
+    {
+        for (int sock : kv.second)
+        {
+            ::close(sock);
+        }// end for sock
+    }// end for kv
+}// end destructor
+
 // --- public accessors ---------------------------------------------------
+auto HttpFetcher::mode(void) const
+    -> Mode
+{
+    return m_mode;
+}// end HttpFetcher::mode
 
 auto HttpFetcher::fetch_url(
     Status& status,
@@ -43,163 +86,1422 @@ auto HttpFetcher::fetch_url(
     const env_map& env
 ) const -> data_container
 {
-    using namespace std;
+    auto        transfer    = start_fetch(url, input, env);
 
-    std::vector<char>       body            = {};
-    Command                 cmd             = m_cmd;
-    string                  currLine        = {};
-    size_t                  idx             = 0;
-    char                    version[0x100]  = {};
-    char                    reason[0x100]   = {};
+    transfer->wait();
 
-    // set up command
-    for (const auto& kv : env)
-    {
-        cmd.set_env(kv.first, kv.second);
-    }// end for
-    cmd.set_env(m_urlEnv, url.str());
+    status = transfer->status();
+    headers = transfer->headers();
 
-    auto        sproc       = cmd.spawn();
+    return transfer->release_body();
+}// end HttpFetcher::fetch_url
 
-    // write request body, if applicable
-    if (not input.empty())
+// Spawns the handler for a given url and returns a Transfer through which
+// its response can be read incrementally. The request body, if any, is
+// written as the handler consumes it.
+auto HttpFetcher::start_fetch(
+    const Uri& url,
+    const data_container& input,
+    const env_map& env
+) const -> u_ptr<Transfer>
+{
+    const auto      started     = Transfer::clock_type::now();
+    u_ptr<Transfer> transfer    = nullptr;
+
+    if (Mode::native == m_mode)
+    {
+        string          method      = "";
+        const auto      request     = format_request(url, input, env, method);
+        bool            reused      = false;
+        const int       sock        = acquire_connection(url, reused);
+
+        transfer.reset(new Transfer(this, sock, reused, url, request, method));
+    }
+    else if (Mode::coprocess == m_mode)
     {
-        sproc.stdin().write(input.data(), input.size());
+        transfer.reset(new Transfer(
+            this,
+            acquire_coprocess(),
+            url,
+            frame_request(url, input, env),
+            true
+        ));
     }
+    else
+    {
+        Command     cmd     = m_cmd;
+
+        // set up command
+        for (const auto& kv : env)
+        {
+            cmd.set_env(kv.first, kv.second);
+        }// end for
+        cmd.set_env(m_urlEnv, url.str());
+
+        transfer.reset(new Transfer(this, cmd.spawn(), url, input));
+    }
+
+    transfer->m_timing.started = started;
+    transfer->m_timing.spawned = Transfer::clock_type::now();
 
-    // close stdin
-    sproc.stdin().close();
+    return transfer;
+}// end HttpFetcher::start_fetch
 
-    // read first line
-    //     if it is a valid HTTP status line, parse it
-    //     otherwise, treat it as first header
-    getline(sproc.stdout(), currLine);
-    if (sscanf(currLine.c_str(), " %s %d %s", version, &status.code, reason) >= 2)
+// --- public static functions --------------------------------------------
+
+// Attempts to parse an HTTP status line (i.e. "HTTP/1.1 200 OK").
+//  return: true if the line was a status line, false otherwise
+auto HttpFetcher::parse_status_line(Status& status, const string& line)
+    -> bool
+{
+    char        version[0x100]  = {};
+    char        reason[0x100]   = {};
+
+    if (sscanf(line.c_str(), " %255s %d %255s", version, &status.code, reason) >= 2)
     {
         status.version = version;
         status.reason = reason;
-        currLine.clear();
+        return true;
     }
 
-    // read headers
-    while ((not currLine.empty()) or getline(sproc.stdout(), currLine))
+    return false;
+}// end HttpFetcher::parse_status_line
+
+// --- private accessors --------------------------------------------------
+
+// Builds a coprocess request frame (see class HttpFetcher).
+auto HttpFetcher::frame_request(
+    const Uri& url,
+    const data_container& input,
+    const env_map& env
+) const -> data_container
+{
+    env_map         vars        = env;
+    string          head        = "";
+
+    vars[m_urlEnv] = url.str();
+
+    head += "W3M-REQUEST " + std::to_string(input.size()) + "\n";
+    for (const auto& kv : vars)
     {
-        header_key_type             key         = {};
-        header_value_type           value       = {};
-        size_t                      idx         = 0;
-        string::const_iterator      iter;
+        string      line    = kv.first + "=" + kv.second;
+
+        // variables are newline-delimited
+        for (char& ch : line)
+        {
+            if (('\n' == ch) or ('\r' == ch))
+            {
+                ch = ' ';
+            }
+        }// end for ch
+
+        head += line + "\n";
+    }// end for kv
+    head += "\n";
+
+    data_container  frame(head.cbegin(), head.cend());
 
+    frame.insert(frame.end(), input.cbegin(), input.cend());
 
-        // remove terminal carriage return
-        if ((not currLine.empty()) and (currLine.back() == '\r'))
+    return frame;
+}// end HttpFetcher::frame_request
+
+// Takes an idle coprocess from the pool, spawning a new one if none is
+// available. Idle coprocesses that have exited (or written anything
+// unsolicited) are discarded.
+auto HttpFetcher::acquire_coprocess(void) const
+    -> Command::Subprocess
+{
+    while (not m_coprocesses.empty())
+    {
+        Command::Subprocess     sproc       = std::move(m_coprocesses.back());
+        struct pollfd           pfd         = {
+                                                sproc.stdout().fd(),
+                                                POLLIN,
+                                                0
+                                            };
+
+        m_coprocesses.pop_back();
+
+        if (0 == poll(&pfd, 1, 0))
         {
-            currLine.pop_back();
+            return sproc;
         }
 
-        // if line is empty, break, start reading body
-        if (currLine.empty())
+        sproc.stdin().close();
+        sproc.stdout().close();
+        sproc.kill(SIGTERM);
+        sproc.wait();
+    }// end while
+
+    return m_cmd.spawn();
+}// end HttpFetcher::acquire_coprocess
+
+// Returns a coprocess that has completed a request to the idle pool.
+void HttpFetcher::release_coprocess(Command::Subprocess&& sproc) const
+{
+    if (m_coprocesses.size() >= MAX_IDLE_COPROCESSES)
+    {
+        sproc.stdin().close();
+        sproc.stdout().close();
+        sproc.kill(SIGTERM);
+        sproc.wait();
+        return;
+    }
+
+    m_coprocesses.push_back(std::move(sproc));
+}// end HttpFetcher::release_coprocess
+
+// Builds a native HTTP/1.1 request for a given url.
+//  method: set to the request method used
+auto HttpFetcher::format_request(
+    const Uri& url,
+    const data_container& input,
+    const env_map& env,
+    string& method
+) const -> data_container
+{
+    const char  *userAgent  = getenv("W3M_USER_AGENT");
+    string      head        = "";
+
+    method = env.count("W3M_REQUEST_METHOD")
+        ? env.at("W3M_REQUEST_METHOD") : "";
+    if (method.empty())
+    {
+        method = "GET";
+    }
+
+    if (env.count("W3M_USER_AGENT"))
+    {
+        userAgent = env.at("W3M_USER_AGENT").c_str();
+    }
+
+    head += method + " ";
+    if (url.path.empty() or (url.path.front() != '/'))
+    {
+        head += "/";
+    }
+    head += url.path;
+    if (not url.query.empty())
+    {
+        head += "?" + url.query;
+    }
+    head += " HTTP/1.1\r\n";
+
+    head += "Host: " + url.host;
+    if (not url.port.empty())
+    {
+        head += ":" + url.port;
+    }
+    head += "\r\n";
+
+    if (userAgent and *userAgent)
+    {
+        head += string("User-Agent: ") + userAgent + "\r\n";
+    }
+    head += "Accept: */*\r\n";
+
+    if (env.count("W3M_RANGE"))
+    {
+        head += "Range: " + env.at("W3M_RANGE") + "\r\n";
+    }
+    if (env.count("W3M_ACCEPT_ENCODING"))
+    {
+        head += "Accept-Encoding: " + env.at("W3M_ACCEPT_ENCODING")
+            + "\r\n";
+    }
+    // part of a compressed body couldn't be decoded on its own
+    else if (env.count("W3M_RANGE"))
+    {
+        head += "Accept-Encoding: identity\r\n";
+    }
+    else
+    {
+        head += "Accept-Encoding: " + ContentDecoder::accept_encoding()
+            + "\r\n";
+    }
+    head += "Connection: keep-alive\r\n";
+
+    // cache revalidation (see HttpCache)
+    if (env.count("W3M_IF_NONE_MATCH"))
+    {
+        head += "If-None-Match: " + env.at("W3M_IF_NONE_MATCH") + "\r\n";
+    }
+    if (env.count("W3M_IF_MODIFIED_SINCE"))
+    {
+        head += "If-Modified-Since: " + env.at("W3M_IF_MODIFIED_SINCE")
+            + "\r\n";
+    }
+
+    if (not input.empty())
+    {
+        head += "Content-Type: application/x-www-form-urlencoded\r\n";
+        head += "Content-Length: " + std::to_string(input.size()) + "\r\n";
+    }
+    head += "\r\n";
+
+    data_container  request(head.cbegin(), head.cend());
+
+    request.insert(request.end(), input.cbegin(), input.cend());
+
+    return request;
+}// end HttpFetcher::format_request
+
+// Takes an idle connection to the url's host from the pool. Idle
+// connections that have become readable (i.e. closed by the server) are
+// discarded.
+//  reused: set to true if the connection came from the pool
+//  return: the socket, or -1 if none is available, and the transfer is to
+//      open a new one (see Transfer::connect_next)
+auto HttpFetcher::acquire_connection(const Uri& url, bool& reused) const
+    -> int
+{
+    auto        iter    = m_connections.find(connection_key(url));
+
+    while ((iter != m_connections.end()) and (not iter->second.empty()))
+    {
+        const int       sock    = iter->second.back();
+        struct pollfd   pfd     = { sock, POLLIN, 0 };
+
+        iter->second.pop_back();
+
+        if (0 == poll(&pfd, 1, 0))
         {
+            reused = true;
+            return sock;
+        }
+
+        ::close(sock);
+    }// end while
+
+    reused = false;
+    return -1;
+}// end HttpFetcher::acquire_connection
+
+// Returns a connection whose last response was read in full to the pool.
+void HttpFetcher::release_connection(const Uri& url, int sock) const
+{
+    auto&       idle    = m_connections[connection_key(url)];
+
+    if (idle.size() >= MAX_IDLE_CONNECTIONS)
+    {
+        ::close(sock);
+        return;
+    }
+
+    idle.push_back(sock);
+}// end HttpFetcher::release_connection
+
+// --- private static functions -------------------------------------------
+auto HttpFetcher::connection_key(const Uri& url)
+    -> string
+{
+    string      key     = url.host;
+
+    for (char& ch : key)
+    {
+        ch = tolower(ch);
+    }// end for ch
+
+    return key + ":" + (url.port.empty() ? "80" : url.port);
+}// end HttpFetcher::connection_key
+
+// Resolves the url's host. The lookup blocks.
+//  return: the host's addresses, in the order they are to be tried, or
+//      nullptr if it could not be resolved
+auto HttpFetcher::resolve(const Uri& url)
+    -> s_ptr<struct addrinfo>
+{
+    const string        port        = url.port.empty() ? "80" : url.port;
+    struct addrinfo     hints       = {};
+    struct addrinfo     *addrs      = nullptr;
+
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    if (getaddrinfo(url.host.c_str(), port.c_str(), &hints, &addrs))
+    {
+        return nullptr;
+    }
+
+    return s_ptr<struct addrinfo>(addrs, freeaddrinfo);
+}// end HttpFetcher::resolve
+
+// === class HttpFetcher::Transfer Implementation =========================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+HttpFetcher::Transfer::~Transfer(void)
+{
+    if (not finished())
+    {
+        cancel();
+    }
+}// end HttpFetcher::Transfer::~Transfer
+
+// --- public accessors ---------------------------------------------------
+auto HttpFetcher::Transfer::url(void) const
+    -> const Uri&
+{
+    return m_url;
+}// end HttpFetcher::Transfer::url
+
+auto HttpFetcher::Transfer::state(void) const
+    -> State
+{
+    return m_state;
+}// end HttpFetcher::Transfer::state
+
+auto HttpFetcher::Transfer::finished(void) const
+    -> bool
+{
+    return (State::done == m_state) or (State::cancelled == m_state);
+}// end HttpFetcher::Transfer::finished
+
+auto HttpFetcher::Transfer::headers_ready(void) const
+    -> bool
+{
+    return State::headers != m_state;
+}// end HttpFetcher::Transfer::headers_ready
+
+auto HttpFetcher::Transfer::status(void) const
+    -> const Status&
+{
+    return m_status;
+}// end HttpFetcher::Transfer::status
+
+auto HttpFetcher::Transfer::headers(void) const
+    -> const header_type&
+{
+    return m_headers;
+}// end HttpFetcher::Transfer::headers
+
+auto HttpFetcher::Transfer::body(void) const
+    -> const data_container&
+{
+    return m_body;
+}// end HttpFetcher::Transfer::body
+
+auto HttpFetcher::Transfer::bytes_received(void) const
+    -> size_t
+{
+    return m_bytesReceived;
+}// end HttpFetcher::Transfer::bytes_received
+
+// return: file descriptor to poll for readability, or -1 if finished
+auto HttpFetcher::Transfer::fd(void) const
+    -> int
+{
+    if (finished())
+    {
+        return -1;
+    }
+
+    return m_fd;
+}// end HttpFetcher::Transfer::fd
+
+// return: file descriptor to poll for writability while the request body
+//  is being sent, or -1 if there is nothing left to send
+auto HttpFetcher::Transfer::write_fd(void) const
+    -> int
+{
+    return m_inFd;
+}// end HttpFetcher::Transfer::write_fd
+
+auto HttpFetcher::Transfer::bytes_sent(void) const
+    -> size_t
+{
+    return m_bytesSent;
+}// end HttpFetcher::Transfer::bytes_sent
+
+// return: true if the body is being decompressed as it arrives, in which
+//  case its Content-Length (if any) is that of the compressed body
+auto HttpFetcher::Transfer::decoding(void) const
+    -> bool
+{
+    return (bool)(m_decoder);
+}// end HttpFetcher::Transfer::decoding
+
+auto HttpFetcher::Transfer::timing(void) const
+    -> const Timing&
+{
+    return m_timing;
+}// end HttpFetcher::Transfer::timing
+
+// --- public mutators ----------------------------------------------------
+
+// Sends as much of the request body as the handler will accept and reads
+// whatever output it has produced so far, without blocking. At most about
+// UPDATE_LEN bytes are read per call, so that a handler that writes as
+// fast as it is read can't hold up the caller until the whole response is
+// in; the rest is left for the next call (its fd stays readable).
+//  return: true if any data was sent or read, or the transfer finished
+auto HttpFetcher::Transfer::update(void)
+    -> bool
+{
+    char        buf[READ_LEN];
+    bool        progress        = send_input();
+    size_t      nTotal          = 0;
+
+    // nothing to read until the connection is up; if it fails, the next
+    // address is tried (see send_input)
+    if (m_connecting)
+    {
+        return progress;
+    }
+
+    while (not finished())
+    {
+        const bool      direct  = reads_direct();
+        const ssize_t   nRead   = direct
+                                    ? read_direct()
+                                    : ::read(fd(), buf, sizeof(buf));
+
+        if ((nRead > 0) and (clock_type::time_point() == m_timing.firstByte))
+        {
+            m_timing.firstByte = clock_type::now();
+        }
+
+        // a body of known length was read to its end, or its sink failed
+        if (direct and finished())
+        {
+            progress = true;
             break;
         }
+        else if (nRead > 0)
+        {
+            // the server has answered; too late to retry elsewhere
+            m_reusedConnection = false;
 
-        if (currLine.find(':') == string::npos)
+            if (direct)
+            {
+                // already stored
+            }
+            else if (m_framed)
+            {
+                deframe(buf, nRead);
+            }
+            else
+            {
+                consume(buf, nRead);
+            }
+            progress = true;
+
+            nTotal += nRead;
+            if (nTotal >= UPDATE_LEN)
+            {
+                break;
+            }
+        }
+        else if (0 == nRead)
+        {
+            if (not retry())
+            {
+                finish(State::done);
+            }
+            progress = true;
+            break;
+        }
+        else if (EINTR == errno)
         {
-            currLine.clear();
             continue;
         }
+        else if ((EAGAIN == errno) or (EWOULDBLOCK == errno))
+        {
+            break;
+        }
+        else
+        {
+            if (not retry())
+            {
+                finish(State::done);
+            }
+            progress = true;
+            break;
+        }
+    }// end while
+
+    return progress;
+}// end HttpFetcher::Transfer::update
 
-        #define     BREAK_IF_NPOS(VAR) \
-                    if ((VAR) >= string::npos) { break; }
-        #define     WS      " \t"
+// Blocks until the handler has written its complete response.
+void HttpFetcher::Transfer::wait(void)
+{
+    while (not finished())
+    {
+        struct pollfd   pfd[2]  = {
+                            { fd(), POLLIN, 0 },
+                            { write_fd(), POLLOUT, 0 },
+                        };
 
-        // parse key
+        if ((poll(pfd, 2, -1) < 0) and (EINTR != errno))
         {
-            size_t  beg     = 0;
-            size_t  end;
+            finish(State::done);
+            break;
+        }
 
-            beg = currLine.find_first_not_of(WS);
-            idx = currLine.find(':', beg);
-            BREAK_IF_NPOS(idx);
-            end = currLine.find_last_not_of(WS, idx - 1);
+        update();
+    }// end while
+}// end HttpFetcher::Transfer::wait
 
-            if (string::npos == end)
-            {
-                end = beg;
-            }
-            else
+// Aborts the transfer, killing the handler process (or dropping the
+// connection).
+void HttpFetcher::Transfer::cancel(void)
+{
+    if (finished())
+    {
+        return;
+    }
+
+    if (m_sproc)
+    {
+        m_sproc->kill(SIGTERM);
+    }
+    finish(State::cancelled);
+}// end HttpFetcher::Transfer::cancel
+
+auto HttpFetcher::Transfer::release_body(void)
+    -> data_container
+{
+    return std::move(m_body);
+}// end HttpFetcher::Transfer::release_body
+
+// Sends the rest of the body to file <fd> instead of keeping it, for a
+// body that is only being saved; whatever has arrived so far is written
+// out first. The file must stay open until the transfer is finished. A
+// transfer that can't write to its file is cancelled.
+//  return: false if writing to the file failed
+auto HttpFetcher::Transfer::set_sink(int fd)
+    -> bool
+{
+    m_sinkFd = fd;
+    if (not flush_sink())
+    {
+        cancel();
+        return false;
+    }
+
+    return true;
+}// end HttpFetcher::Transfer::set_sink
+
+// --- public static functions --------------------------------------------
+
+// Wraps a response obtained elsewhere (i.e. from a cache) in a transfer
+// that has already finished, so that it can be handled like any other.
+auto HttpFetcher::Transfer::completed(
+    const Uri& url,
+    const Status& status,
+    const header_type& headers,
+    const data_container& body
+) -> u_ptr<Transfer>
+{
+    u_ptr<Transfer>     transfer(new Transfer(url));
+
+    transfer->m_state = State::done;
+    transfer->m_status = status;
+    transfer->m_headers = headers;
+    transfer->m_body = body;
+    transfer->m_bytesReceived = body.size();
+
+    return transfer;
+}// end HttpFetcher::Transfer::completed
+
+// --- private constructors -----------------------------------------------
+HttpFetcher::Transfer::Transfer(const Uri& url) : m_url(url)
+{
+    // do nothing
+}// end HttpFetcher::Transfer::Transfer
+
+HttpFetcher::Transfer::Transfer(
+    const HttpFetcher *fetcher,
+    Command::Subprocess&& sproc,
+    const Uri& url,
+    const data_container& input,
+    bool framed
+) : m_sproc(new Command::Subprocess(std::move(sproc))), m_url(url),
+    m_input(input), m_fetcher(fetcher), m_framed(framed)
+{
+    m_fd = m_sproc->stdout().fd();
+    fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL) | O_NONBLOCK);
+    m_canSplice = true;
+
+    // let each read take in more; not an error if the system won't
+    #ifdef F_SETPIPE_SZ
+    fcntl(m_fd, F_SETPIPE_SZ, DIRECT_READ_LEN);
+    #endif
+
+    m_inFd = m_sproc->stdin().fd();
+    send_input();
+}// end HttpFetcher::Transfer::Transfer
+
+// Native transfer over a socket from HttpFetcher::acquire_connection.
+//  request: the complete request, as formatted by
+//      HttpFetcher::format_request
+HttpFetcher::Transfer::Transfer(
+    const HttpFetcher *fetcher,
+    int sock,
+    bool reused,
+    const Uri& url,
+    const data_container& request,
+    const string& method
+) : m_url(url), m_input(request), m_fetcher(fetcher), m_sock(sock),
+    m_reusedConnection(reused), m_method(method)
+{
+    if (not reused)
+    {
+        m_addrs = resolve(url);
+        m_nextAddr = m_addrs.get();
+        connect_next();
+    }
+
+    // couldn't connect; as if a handler exited without output
+    if (m_sock < 0)
+    {
+        finish(State::done);
+        return;
+    }
+
+    m_fd = m_sock;
+    m_inFd = m_sock;
+    send_input();
+}// end HttpFetcher::Transfer::Transfer
+
+// --- private accessors --------------------------------------------------
+
+// return: true if what comes next is body data that needs no de-framing
+//  or decoding, so can be read straight into place
+auto HttpFetcher::Transfer::reads_direct(void) const
+    -> bool
+{
+    return (State::body == m_state) and (not m_framed) and (not m_decoder)
+        and (Framing::chunked != m_framing);
+}// end HttpFetcher::Transfer::reads_direct
+
+// --- private mutators ---------------------------------------------------
+
+// Reads body data straight into the end of the body, growing it as needed,
+// or splices it into the sink. Never reads past the end of a body of known
+// length, which may be followed by the next response on the connection.
+//  return: as for read(2)
+auto HttpFetcher::Transfer::read_direct(void)
+    -> ssize_t
+{
+    const size_t    oldSize     = m_body.size();
+    size_t          len         = DIRECT_READ_LEN;
+    ssize_t         nRead       = -1;
+
+    if (Framing::length == m_framing)
+    {
+        len = std::min(len, m_bodyRemaining);
+    }
+
+    if ((m_sinkFd >= 0) and m_canSplice)
+    {
+        nRead = splice(
+            m_fd,
+            nullptr,
+            m_sinkFd,
+            nullptr,
+            len,
+            SPLICE_F_MOVE | SPLICE_F_NONBLOCK
+        );
+
+        // not supported by the file; copy instead
+        if ((nRead < 0) and (EINVAL == errno))
+        {
+            m_canSplice = false;
+        }
+        else if ((nRead < 0) and (EAGAIN != errno) and (EINTR != errno))
+        {
+            cancel();
+            return nRead;
+        }
+    }
+
+    if ((m_sinkFd < 0) or (not m_canSplice))
+    {
+        // past the reserved capacity, the body grows geometrically
+        m_body.resize(oldSize + len);
+        nRead = ::read(m_fd, m_body.data() + oldSize, len);
+        m_body.resize(oldSize + std::max(nRead, (ssize_t)(0)));
+
+        if ((nRead > 0) and (not flush_sink()))
+        {
+            cancel();
+            return nRead;
+        }
+    }
+
+    if (nRead > 0)
+    {
+        m_bytesReceived += nRead;
+
+        if (Framing::length == m_framing)
+        {
+            m_bodyRemaining -= nRead;
+            if (0 == m_bodyRemaining)
             {
-                ++end;
+                end_body();
             }
+        }
+    }
 
-            ++idx;
-            key = currLine.substr(beg, end - beg);
+    return nRead;
+}// end HttpFetcher::Transfer::read_direct
 
-            // header names are case-insensitive; make lower-case
-            for (char& ch : key)
+// Writes out the body received so far to the sink, if any, and empties it.
+//  return: false if the sink could not take it all
+auto HttpFetcher::Transfer::flush_sink(void)
+    -> bool
+{
+    const char  *data   = m_body.data();
+    size_t      len     = m_body.size();
+
+    if (m_sinkFd < 0)
+    {
+        return true;
+    }
+
+    while (len)
+    {
+        const ssize_t   nWritten    = ::write(m_sinkFd, data, len);
+
+        if (nWritten < 0)
+        {
+            if (EINTR == errno)
             {
-                ch = tolower(ch);
-            }// end for
+                continue;
+            }
+            return false;
         }
+        data += nWritten;
+        len -= nWritten;
+    }// end while
+
+    // keeps its capacity for the next read
+    m_body.clear();
+
+    return true;
+}// end HttpFetcher::Transfer::flush_sink
+
+// Writes as much of the remaining request body as the handler's stdin will
+// take, closing stdin once all of it has been sent (or the handler has
+// stopped reading).
+//  return: true if any data was sent or stdin was closed
+auto HttpFetcher::Transfer::send_input(void)
+    -> bool
+{
+    bool        progress        = false;
 
-        // parse values
-        while (idx < currLine.size())
+    while (m_inFd >= 0)
+    {
+        // wait for a new connection to be established
+        if (m_connecting)
         {
-            size_t      beg     = idx;
-            size_t      end;
+            struct pollfd   pfd     = { m_sock, POLLOUT, 0 };
+            int             err     = 0;
+            socklen_t       errLen  = sizeof(err);
 
-            // find first non-whitespace character
-            idx = currLine.find_first_not_of(WS, beg);
-            BREAK_IF_NPOS(idx);
-            beg = idx;
+            if (0 == poll(&pfd, 1, 0))
+            {
+                break;
+            }
 
-            // find terminating ';'
-            // if none, end set to end of currLine
-            idx = currLine.find(';', beg);
-            if (string::npos == idx)
+            m_connecting = false;
+            getsockopt(m_sock, SOL_SOCKET, SO_ERROR, &err, &errLen);
+            if (err and connect_next())
             {
-                end = currLine.size();
+                // refused or unreachable; try the host's next address
+                progress = true;
+                continue;
             }
-            else
+            else if (err)
             {
-                end = currLine.find_last_not_of(WS, idx - 1);
-                ++idx;
+                // the failure is picked up when reading
+                close_input();
+                return true;
             }
+        }
 
-            if (string::npos == end)
+        const ssize_t   nWritten    = write_input(
+                                        m_input.data() + m_bytesSent,
+                                        m_input.size() - m_bytesSent
+                                    );
+
+        if (nWritten < 0)
+        {
+            if (not retry())
             {
-                end = beg;
+                close_input();
             }
-            else
+            progress = true;
+            continue;
+        }
+        else if (nWritten > 0)
+        {
+            m_bytesSent += nWritten;
+            progress = true;
+        }
+        else if (m_bytesSent < m_input.size())
+        {
+            break;
+        }
+
+        if (m_bytesSent >= m_input.size())
+        {
+            end_input();
+            progress = true;
+        }
+    }// end while
+
+    return progress;
+}// end HttpFetcher::Transfer::send_input
+
+// Writes request data to the handler's stdin, or the socket.
+//  return: bytes written, 0 if the write would block, or -1 on error
+auto HttpFetcher::Transfer::write_input(const char *data, size_t len)
+    -> ssize_t
+{
+    if (m_sproc)
+    {
+        return m_sproc->write_stdin(data, len);
+    }
+
+    while (true)
+    {
+        const ssize_t   nWritten    = send(m_sock, data, len, MSG_NOSIGNAL);
+
+        if (nWritten >= 0)
+        {
+            return nWritten;
+        }
+        else if (EINTR == errno)
+        {
+            continue;
+        }
+        else if ((EAGAIN == errno) or (EWOULDBLOCK == errno))
+        {
+            return 0;
+        }
+
+        return -1;
+    }// end while
+}// end HttpFetcher::Transfer::write_input
+
+// Stops sending. A socket is only closed once the response has been read,
+// and the request is kept in case it has to be resent.
+void HttpFetcher::Transfer::close_input(void)
+{
+    if (m_inFd < 0)
+    {
+        return;
+    }
+
+    m_inFd = -1;
+    if (m_sproc)
+    {
+        m_sproc->stdin().close();
+        m_input = {};
+    }
+}// end HttpFetcher::Transfer::close_input
+
+// Stops sending once the whole request has been written. A coprocess's
+// stdin stays open for its next request.
+void HttpFetcher::Transfer::end_input(void)
+{
+    if (m_sproc and (not m_framed))
+    {
+        close_input();
+        return;
+    }
+
+    m_inFd = -1;
+    if (m_sproc)
+    {
+        m_input = {};
+    }
+}// end HttpFetcher::Transfer::end_input
+
+// Resends the request on a new connection, if the pooled connection it was
+// sent on turns out to have been closed by the server before answering.
+//  return: true if the request is being retried
+auto HttpFetcher::Transfer::retry(void)
+    -> bool
+{
+    if (m_sproc or (not m_reusedConnection) or m_bytesReceived)
+    {
+        return false;
+    }
+
+    m_reusedConnection = false;
+    m_addrs = resolve(m_url);
+    m_nextAddr = m_addrs.get();
+
+    return connect_next();
+}// end HttpFetcher::Transfer::retry
+
+// Closes the current socket, if any, and starts a non-blocking connect to
+// the next of the host's addresses that takes one, so that a host whose
+// first address is refused or unreachable (i.e. IPv6 on a host that only
+// listens on IPv4) is reached on another. The request is sent again from
+// the start.
+//  return: false if no address is left to try
+auto HttpFetcher::Transfer::connect_next(void)
+    -> bool
+{
+    if (m_sock >= 0)
+    {
+        ::close(m_sock);
+        m_sock = -1;
+    }
+
+    while (m_nextAddr and (m_sock < 0))
+    {
+        const struct addrinfo   *addr   = m_nextAddr;
+
+        m_nextAddr = addr->ai_next;
+        m_sock = socket(
+            addr->ai_family,
+            SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+            addr->ai_protocol
+        );
+
+        if (
+            (m_sock >= 0)
+            and (0 != connect(m_sock, addr->ai_addr, addr->ai_addrlen))
+            and (EINPROGRESS != errno)
+        )
+        {
+            ::close(m_sock);
+            m_sock = -1;
+        }
+    }// end while
+
+    m_fd = m_sock;
+    m_inFd = m_sock;
+    m_connecting = (m_sock >= 0);
+    m_bytesSent = 0;
+
+    return m_sock >= 0;
+}// end HttpFetcher::Transfer::connect_next
+
+// Strips coprocess response framing, passing chunk contents on to
+// consume(). The transfer is finished by the terminating empty chunk.
+void HttpFetcher::Transfer::deframe(const char *data, size_t len)
+{
+    const char  *end    = data + len;
+
+    while ((data < end) and (not finished()))
+    {
+        if (m_chunkRemaining)
+        {
+            const size_t    n   = std::min(
+                                    m_chunkRemaining,
+                                    static_cast<size_t>(end - data)
+                                );
+
+            consume(data, n);
+            data += n;
+            m_chunkRemaining -= n;
+            continue;
+        }
+
+        const char  *nl     = static_cast<const char*>(
+                                memchr(data, '\n', end - data)
+                            );
+
+        if (not nl)
+        {
+            m_chunkHeader.append(data, end);
+            return;
+        }
+
+        m_chunkHeader.append(data, nl);
+        data = nl + 1;
+
+        if (1 != sscanf(m_chunkHeader.c_str(), " %zu", &m_chunkRemaining))
+        {
+            // out of sync; don't trust this handler again
+            m_chunkRemaining = 0;
+            finish(State::done);
+        }
+        else if (0 == m_chunkRemaining)
+        {
+            // a response that arrives before the request has been fully
+            // read leaves the handler's input out of sync
+            m_reusable = (m_inFd < 0);
+            finish(State::done);
+        }
+
+        m_chunkHeader.clear();
+    }// end while
+}// end HttpFetcher::Transfer::deframe
+
+// Feeds raw handler output through the header parser; anything after the
+// blank line ending the headers is appended to the body.
+void HttpFetcher::Transfer::consume(const char *data, size_t len)
+{
+    const char  *end    = data + len;
+
+    m_bytesReceived += len;
+
+    while ((State::headers == m_state) and (data < end))
+    {
+        const char  *nl     = static_cast<const char*>(
+                                memchr(data, '\n', end - data)
+                            );
+
+        if (not nl)
+        {
+            m_currLine.append(data, end);
+            return;
+        }
+
+        m_currLine.append(data, nl);
+        data = nl + 1;
+
+        // first line may be an HTTP status line; otherwise, treat it as the
+        // first header
+        if (m_firstLine)
+        {
+            m_firstLine = false;
+
+            // a leading blank line does not end the header block
+            if (
+                parse_status_line(m_status, m_currLine)
+                or m_currLine.empty()
+                or ("\r" == m_currLine)
+            )
             {
-                ++end;
+                m_currLine.clear();
+                continue;
             }
+        }
+
+        if ((not m_currLine.empty()) and (m_currLine.back() == '\r'))
+        {
+            m_currLine.pop_back();
+        }
 
-            value.push_back(currLine.substr(beg, end - beg));
-        }// end while
+        // if line is empty, start reading body
+        if (m_currLine.empty())
+        {
+            begin_body();
+        }
+        else
+        {
+            m_headers.add_line(m_currLine);
+        }
 
-        #undef      WS
-        #undef      BREAK_IF_NPOS
-        headers[key] = value;
-        currLine.clear();
+        m_currLine.clear();
     }// end while
 
-    // next, read body
-    while (sproc.stdout())
+    append_body(data, end - data);
+}// end HttpFetcher::Transfer::consume
+
+// Called at the blank line ending a header block. For native transfers,
+// works out how the body is delimited from the status and headers.
+void HttpFetcher::Transfer::begin_body(void)
+{
+    m_state = State::body;
+    m_timing.headersReady = clock_type::now();
+
+    if (m_sproc)
     {
-        char    *buf;
+        start_decoding();
+        reserve_body();
+        return;
+    }
 
-        body.resize(body.size() + READ_LEN);
-        buf = &body.back() + 1 - READ_LEN;
+    // interim (1xx) responses are followed by the final one
+    if ((m_status.code >= 100) and (m_status.code < 200))
+    {
+        m_state = State::headers;
+        m_firstLine = true;
+        m_headers.clear();
+        return;
+    }
+
+    if (
+        ("HEAD" == m_method)
+        or (204 == m_status.code)
+        or (304 == m_status.code)
+    )
+    {
+        end_body();
+        return;
+    }
+
+    const auto  encoding    = m_headers.get("transfer-encoding");
+    // chunked must be the last encoding applied
+    const bool  chunked     = (encoding.size() >= 7)
+                                and HttpHeaders::equals_ci(
+                                    encoding.substr(encoding.size() - 7),
+                                    "chunked"
+                                );
+    // the framing length is of the encoded body, which decoding drops
+    const bool  hasLength   = (not chunked)
+                                and m_headers.content_length(m_bodyRemaining);
+
+    start_decoding();
+    reserve_body();
+
+    if (chunked)
+    {
+        m_framing = Framing::chunked;
+        m_chunkState = ChunkState::size;
+        return;
+    }
+
+    if (hasLength)
+    {
+        m_framing = Framing::length;
+        if (0 == m_bodyRemaining)
+        {
+            end_body();
+        }
+        return;
+    }
+
+    m_framing = Framing::eof;
+}// end HttpFetcher::Transfer::begin_body
+
+// Sets up decoding of the body, if it has a Content-Encoding we can
+// decode. Bodies in other codings are left as they are. The headers are
+// made to describe the decoded body: its Content-Length is that of the
+// encoded body, so it's dropped (i.e. so that the cache doesn't take the
+// decoded body for a truncated one).
+void HttpFetcher::Transfer::start_decoding(void)
+{
+    switch (ContentDecoder::parse_coding(m_headers.get("content-encoding")))
+    {
+        case ContentDecoder::Coding::gzip:
+            m_decoder.reset(new ContentDecoder(ContentDecoder::Coding::gzip));
+            break;
+        case ContentDecoder::Coding::deflate:
+            m_decoder.reset(
+                new ContentDecoder(ContentDecoder::Coding::deflate)
+            );
+            break;
+        default:
+            return;
+    }// end switch
+
+    m_headers.erase("content-encoding");
+    m_headers.erase("content-length");
+}// end HttpFetcher::Transfer::start_decoding
+
+// Makes room for the whole body up front, if the headers give its length
+// (up to a limit, in case they are wrong) and it will be stored as it
+// arrives.
+void HttpFetcher::Transfer::reserve_body(void)
+{
+    size_t      length;
+
+    if (
+        (not m_decoder) and (m_sinkFd < 0)
+        and m_headers.content_length(length)
+    )
+    {
+        m_body.reserve(
+            m_body.size() + std::min(length, (size_t)(MAX_RESERVE_LEN))
+        );
+    }
+}// end HttpFetcher::Transfer::reserve_body
+
+// Appends (de-framed) response data to the body.
+void HttpFetcher::Transfer::append_body(const char *data, size_t len)
+{
+    if (finished() or (0 == len))
+    {
+        return;
+    }
 
-        sproc.stdout().read(buf, READ_LEN);
+    switch (m_framing)
+    {
+        case Framing::eof:
+            store_body(data, len);
+            break;
+        case Framing::length:
+            len = std::min(len, m_bodyRemaining);
+            store_body(data, len);
+            m_bodyRemaining -= len;
+            if (0 == m_bodyRemaining)
+            {
+                end_body();
+            }
+            break;
+        case Framing::chunked:
+            decode_chunked(data, len);
+            break;
+    }// end switch
+}// end HttpFetcher::Transfer::append_body
+
+// Adds de-framed body data to the body, decoding it if need be. Once the
+// data turns out to be corrupt, the rest of it is dropped, keeping what
+// was decoded.
+void HttpFetcher::Transfer::store_body(const char *data, size_t len)
+{
+    if (m_decoder)
+    {
+        m_decoder->decode(data, len, m_body);
+    }
+    else
+    {
+        m_body.insert(m_body.end(), data, data + len);
+    }
+
+    if (not flush_sink())
+    {
+        cancel();
+    }
+}// end HttpFetcher::Transfer::store_body
+
+// Decodes a chunked transfer encoding: "<hex size>[;ext]\r\n<data>\r\n"
+// repeated, then a zero size, optional trailers and a blank line.
+void HttpFetcher::Transfer::decode_chunked(const char *data, size_t len)
+{
+    const char  *end    = data + len;
+
+    while ((data < end) and (not finished()))
+    {
+        if (ChunkState::data == m_chunkState)
+        {
+            const size_t    n   = std::min(
+                                    m_bodyRemaining,
+                                    static_cast<size_t>(end - data)
+                                );
+
+            store_body(data, n);
+            data += n;
+            m_bodyRemaining -= n;
+            if (0 == m_bodyRemaining)
+            {
+                m_chunkState = ChunkState::dataEnd;
+            }
+            continue;
+        }
+
+        const char  *nl     = static_cast<const char*>(
+                                memchr(data, '\n', end - data)
+                            );
+
+        if (not nl)
+        {
+            m_chunkHeader.append(data, end);
+            return;
+        }
+
+        m_chunkHeader.append(data, nl);
+        data = nl + 1;
+
+        if ((not m_chunkHeader.empty()) and (m_chunkHeader.back() == '\r'))
+        {
+            m_chunkHeader.pop_back();
+        }
+
+        switch (m_chunkState)
+        {
+            case ChunkState::size:
+                if (1 != sscanf(m_chunkHeader.c_str(), " %zx",
+                        &m_bodyRemaining))
+                {
+                    // malformed; keep what we have
+                    finish(State::done);
+                }
+                else
+                {
+                    m_chunkState = m_bodyRemaining
+                        ? ChunkState::data : ChunkState::trailer;
+                }
+                break;
+            case ChunkState::dataEnd:
+                m_chunkState = ChunkState::size;
+                break;
+            case ChunkState::trailer:
+                if (m_chunkHeader.empty())
+                {
+                    end_body();
+                }
+                break;
+            case ChunkState::data:
+                break;
+        }// end switch
+
+        m_chunkHeader.clear();
     }// end while
+}// end HttpFetcher::Transfer::decode_chunked
+
+// Finishes a native transfer whose body has been read in full, keeping the
+// connection for reuse unless the server asked to close it.
+void HttpFetcher::Transfer::end_body(void)
+{
+    const auto  value       = m_headers.get("connection");
+
+    m_reusable = (m_inFd < 0) and (
+        ("HTTP/1.0" == m_status.version)
+            ? HttpHeaders::equals_ci("keep-alive", value)
+            : (not HttpHeaders::equals_ci("close", value))
+    );
+    finish(State::done);
+}// end HttpFetcher::Transfer::end_body
 
-    if (not body.empty())
+void HttpFetcher::Transfer::finish(State state)
+{
+    // handler closed its output without ending the header block
+    if ((State::headers == m_state) and (not m_currLine.empty()))
     {
-        body.resize(body.size() + sproc.stdout().gcount() - READ_LEN);
+        if (m_firstLine)
+        {
+            m_firstLine = false;
+            if (not parse_status_line(m_status, m_currLine))
+            {
+                m_headers.add_line(m_currLine);
+            }
+        }
+        else
+        {
+            m_headers.add_line(m_currLine);
+        }
+        m_currLine.clear();
     }
 
-    sproc.stdout().close();
-    sproc.wait();
-    return body;
-}// end HttpFetcher::fetch_url
+    m_state = state;
+    m_timing.finished = clock_type::now();
+
+    if (not m_sproc)
+    {
+        if (m_reusable)
+        {
+            m_fetcher->release_connection(m_url, m_sock);
+        }
+        else if (m_sock >= 0)
+        {
+            ::close(m_sock);
+        }
+
+        m_sock = -1;
+        m_fd = -1;
+        m_inFd = -1;
+        m_input = {};
+        return;
+    }
+
+    if (m_reusable)
+    {
+        m_fetcher->release_coprocess(std::move(*m_sproc));
+        return;
+    }
+
+    // a coprocess that can't be reused (interrupted, out of sync, or
+    // exited) is shut down
+    if (m_framed)
+    {
+        m_sproc->kill(SIGTERM);
+    }
+
+    close_input();
+    m_sproc->stdout().close();
+    m_sproc->wait();
+}// end HttpFetcher::Transfer::finish
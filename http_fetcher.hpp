@@ -1,20 +1,61 @@
 #ifndef __HTTP_FETCHER_HPP__
 #define __HTTP_FETCHER_HPP__
 
+#include <chrono>
 #include <map>
 
+#include <netdb.h>
+
 #include "deps.hpp"
 #include "command.hpp"
+#include "content_decoder.hpp"
+#include "http_headers.hpp"
 #include "uri.hpp"
 
+// === class HttpFetcher ==================================================
+//
+// Fetches urls by running a handler command, which writes an HTTP-style
+// response (optional status line, headers, blank line, body) to stdout.
+//
+// By default (Mode::command), a new handler process is spawned for every
+// request; the url and request variables are passed through the
+// environment, and the request body through stdin.
+//
+// In Mode::coprocess, handler processes are long-lived and serve one
+// request after another over their stdin/stdout, so that they can keep
+// connections open between requests. Each request is framed as:
+//
+//      W3M-REQUEST <body length>\n
+//      <NAME>=<value>\n            (W3M_URL, W3M_REQUEST_METHOD, ...)
+//      \n
+//      <body>
+//
+// and the handler replies with its usual output, split into chunks of the
+// form "<length>\n<data>" (length in decimal), terminated by a zero-length
+// chunk ("0\n"). Idle handlers are kept for reuse; a handler that is
+// interrupted mid-response is killed.
+//
+// In Mode::native (selected by passing NATIVE_HANDLER as the shell
+// command), no handler is run at all: plain HTTP/1.1 requests are written
+// directly to a socket. The request method, user agent, conditional
+// headers, byte range and accepted encodings are taken from the
+// W3M_REQUEST_METHOD, W3M_USER_AGENT, W3M_IF_NONE_MATCH,
+// W3M_IF_MODIFIED_SINCE, W3M_RANGE and W3M_ACCEPT_ENCODING variables (a
+// ranged request asks for an unencoded body by default). Connections are
+// kept alive and pooled per host:port; chunked responses are decoded. TLS
+// is not supported, so only http:// urls can be fetched this way.
+//
+// Whatever the mode, a body with a gzip or deflate Content-Encoding is
+// decompressed as it arrives (see ContentDecoder), so handlers may ask for
+// compressed responses and pass them through as they are; native requests
+// do so. The content-encoding header of a decoded response is removed.
+//
+// ========================================================================
 class HttpFetcher
 {
     public:
         // --- public member types ----------------------------------------
-        typedef     string                      header_key_type;
-        typedef     std::vector<string>         header_value_type;
-        typedef     std::map<header_key_type, header_value_type>
-                                                header_type;
+        typedef     HttpHeaders                 header_type;
         typedef     std::vector<char>           data_container;
         typedef     std::map<string,string>     env_map;
         struct      Status
@@ -23,15 +64,28 @@ class HttpFetcher
             int         code;
             string      reason;
         };// end struct Protocol
+        enum class  Mode
+        {
+            command     = 0,
+            coprocess   = 1,
+            native      = 2,
+        };// end enum class Mode
+        class       Transfer;
 
         // --- public constructors ----------------------------------------
         HttpFetcher(
             const string& shellCommand,
             const string& urlEnv,
-            const env_map& env = {}
+            const env_map& env = {},
+            const Mode mode = Mode::command
         );
+        HttpFetcher(const HttpFetcher& other) = delete;
+        HttpFetcher(HttpFetcher&& other) = default;
+        ~HttpFetcher(void);
 
         // --- public accessors -------------------------------------------
+        auto mode(void) const
+            -> Mode;
         auto fetch_url(
             Status& status,
             header_type& headers,
@@ -39,11 +93,260 @@ class HttpFetcher
             const data_container& input = {},
             const env_map& env = {}
         ) const -> data_container;
+        auto start_fetch(
+            const Uri& url,
+            const data_container& input = {},
+            const env_map& env = {}
+        ) const -> u_ptr<Transfer>;
+
+        // --- public static functions ------------------------------------
+        static auto parse_status_line(Status& status, const string& line)
+            -> bool;
 
+        // --- public static constants ------------------------------------
+        static const string     NATIVE_HANDLER;
     private:
         // --- private member variables -----------------------------------
-        Command     m_cmd;
-        string      m_urlEnv;
+        Command                                     m_cmd;
+        string                                      m_urlEnv;
+        Mode                                        m_mode
+                                                    = Mode::command;
+        mutable std::vector<Command::Subprocess>    m_coprocesses   = {};
+        mutable std::map<string,std::vector<int>>   m_connections   = {};
+
+        // --- private static constants -----------------------------------
+        static const size_t     MAX_IDLE_COPROCESSES    = 4;
+        static const size_t     MAX_IDLE_CONNECTIONS    = 4;
+
+        // --- private accessors ------------------------------------------
+        auto frame_request(
+            const Uri& url,
+            const data_container& input,
+            const env_map& env
+        ) const -> data_container;
+        auto acquire_coprocess(void) const
+            -> Command::Subprocess;
+        void release_coprocess(Command::Subprocess&& sproc) const;
+        auto format_request(
+            const Uri& url,
+            const data_container& input,
+            const env_map& env,
+            string& method
+        ) const -> data_container;
+        auto acquire_connection(const Uri& url, bool& reused) const
+            -> int;
+        void release_connection(const Uri& url, int sock) const;
+
+        // --- private static functions -----------------------------------
+        static auto connection_key(const Uri& url)
+            -> string;
+        static auto resolve(const Uri& url)
+            -> s_ptr<struct addrinfo>;
 };// end class HttpFetcher
 
+// === class HttpFetcher::Transfer ========================================
+//
+// A single fetch in progress. Reads the handler's response without
+// blocking, so that the caller can keep servicing user input between calls
+// to update(). Status and headers become available once the blank line
+// ending the header block has been read; the body grows as more data
+// arrives.
+//
+// The request body is fed to the handler as its stdin drains, interleaved
+// with reading its output, so a handler that streams its response before
+// consuming all of its input can't deadlock the transfer.
+//
+// For coprocess handlers, the response is de-framed as it is read; once
+// the final chunk arrives, the handler is handed back to its HttpFetcher.
+//
+// Native transfers read from a socket instead, delimiting the body by
+// Content-Length, chunked encoding or end of stream; a connection whose
+// response was read to the end is handed back to its HttpFetcher. A new
+// connection is tried on each of the host's addresses in turn, until one
+// is accepted. A request that fails on a pooled connection before any
+// response arrives is retried once on a new one.
+//
+// The time at which each stage of the fetch was reached (request made,
+// handler spawned or connection opened, first byte, headers, end) is kept
+// (see timing), for telling a slow handler from a slow transfer. Responses
+// that didn't come from a handler (see completed) have no timing.
+//
+// Once the headers are in, an unencoded body is read straight into the
+// body container, in large reads, rather than through the header parser;
+// the container is sized up front from the Content-Length, if any. A body
+// that is only being saved can be sent to a file instead (see set_sink),
+// in which case it is spliced from the handler's pipe, without passing
+// through user space at all.
+//
+// ========================================================================
+class HttpFetcher::Transfer
+{
+    friend class HttpFetcher;
+
+    public:
+        // --- public member types ----------------------------------------
+        typedef     std::chrono::steady_clock   clock_type;
+        enum class  State
+        {
+            headers     = 0,
+            body        = 1,
+            done        = 2,
+            cancelled   = 3,
+        };// end enum class State
+        struct      Timing
+        {
+            clock_type::time_point      started;
+            clock_type::time_point      spawned;
+            clock_type::time_point      firstByte;
+            clock_type::time_point      headersReady;
+            clock_type::time_point      finished;
+        };// end struct Timing
+
+        // --- public constructors ----------------------------------------
+        Transfer(const Transfer& other) = delete;
+        ~Transfer(void);
+
+        // --- public accessors -------------------------------------------
+        auto url(void) const
+            -> const Uri&;
+        auto state(void) const
+            -> State;
+        auto finished(void) const
+            -> bool;
+        auto headers_ready(void) const
+            -> bool;
+        auto status(void) const
+            -> const Status&;
+        auto headers(void) const
+            -> const header_type&;
+        auto body(void) const
+            -> const data_container&;
+        auto bytes_received(void) const
+            -> size_t;
+        auto fd(void) const
+            -> int;
+        auto write_fd(void) const
+            -> int;
+        auto bytes_sent(void) const
+            -> size_t;
+        auto decoding(void) const
+            -> bool;
+        auto timing(void) const
+            -> const Timing&;
+
+        // --- public mutators --------------------------------------------
+        auto update(void)
+            -> bool;
+        void wait(void);
+        void cancel(void);
+        auto release_body(void)
+            -> data_container;
+        auto set_sink(int fd)
+            -> bool;
+
+        // --- public static functions ------------------------------------
+        static auto completed(
+            const Uri& url,
+            const Status& status,
+            const header_type& headers,
+            const data_container& body
+        ) -> u_ptr<Transfer>;
+    private:
+        // --- private member types ---------------------------------------
+        enum class  Framing
+        {
+            eof         = 0,
+            length      = 1,
+            chunked     = 2,
+        };// end enum class Framing
+        enum class  ChunkState
+        {
+            size        = 0,
+            data        = 1,
+            dataEnd     = 2,
+            trailer     = 3,
+        };// end enum class ChunkState
+
+        // --- private member variables -----------------------------------
+        u_ptr<Command::Subprocess>  m_sproc;
+        Uri                     m_url               = {};
+        int                     m_fd                = -1;
+        State                   m_state             = State::headers;
+        Status                  m_status            = {};
+        header_type             m_headers           = {};
+        data_container          m_body              = {};
+        string                  m_currLine          = {};
+        bool                    m_firstLine         = true;
+        size_t                  m_bytesReceived     = 0;
+        data_container          m_input             = {};
+        size_t                  m_bytesSent         = 0;
+        int                     m_inFd              = -1;
+        const HttpFetcher       *m_fetcher          = nullptr;
+        bool                    m_framed            = false;
+        bool                    m_reusable          = false;
+        size_t                  m_chunkRemaining    = 0;
+        string                  m_chunkHeader       = {};
+        int                     m_sock              = -1;
+        bool                    m_connecting        = false;
+        bool                    m_reusedConnection  = false;
+        s_ptr<struct addrinfo>  m_addrs             = nullptr;
+        const struct addrinfo   *m_nextAddr         = nullptr;
+        string                  m_method            = {};
+        Framing                 m_framing           = Framing::eof;
+        size_t                  m_bodyRemaining     = 0;
+        ChunkState              m_chunkState        = ChunkState::size;
+        u_ptr<ContentDecoder>   m_decoder           = nullptr;
+        int                     m_sinkFd            = -1;
+        bool                    m_canSplice         = false;
+        Timing                  m_timing            = {};
+
+        // --- private constructors ---------------------------------------
+        Transfer(const Uri& url);
+        Transfer(
+            const HttpFetcher *fetcher,
+            Command::Subprocess&& sproc,
+            const Uri& url,
+            const data_container& input,
+            bool framed = false
+        );
+        Transfer(
+            const HttpFetcher *fetcher,
+            int sock,
+            bool reused,
+            const Uri& url,
+            const data_container& request,
+            const string& method
+        );
+
+        // --- private accessors ------------------------------------------
+        auto reads_direct(void) const
+            -> bool;
+
+        // --- private mutators -------------------------------------------
+        auto send_input(void)
+            -> bool;
+        auto write_input(const char *data, size_t len)
+            -> ssize_t;
+        void close_input(void);
+        void end_input(void);
+        auto retry(void)
+            -> bool;
+        auto connect_next(void)
+            -> bool;
+        auto read_direct(void)
+            -> ssize_t;
+        auto flush_sink(void)
+            -> bool;
+        void deframe(const char *data, size_t len);
+        void consume(const char *data, size_t len);
+        void begin_body(void);
+        void start_decoding(void);
+        void reserve_body(void);
+        void append_body(const char *data, size_t len);
+        void store_body(const char *data, size_t len);
+        void decode_chunked(const char *data, size_t len);
+        void end_body(void);
+        void finish(State state);
+};// end class HttpFetcher::Transfer
+
 #endif
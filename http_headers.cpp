@@ -0,0 +1,362 @@
+#include <initializer_list>
+#include <string_view>
+
+#include "deps.hpp"
+
+#include "http_headers.hpp"
+
+// === class HttpHeaders Implementation ===================================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+HttpHeaders::HttpHeaders(void)
+{
+    // do nothing
+}// end HttpHeaders::HttpHeaders
+
+HttpHeaders::HttpHeaders(
+    std::initializer_list<std::pair<view_type,view_type>> fields
+)
+{
+    for (const auto& kv : fields)
+    {
+        add(kv.first, kv.second);
+    }// end for kv
+}// end HttpHeaders::HttpHeaders
+
+// --- public accessors ---------------------------------------------------
+auto HttpHeaders::size(void) const
+    -> size_t
+{
+    return m_fields.size();
+}// end HttpHeaders::size
+
+auto HttpHeaders::empty(void) const
+    -> bool
+{
+    return m_fields.empty();
+}// end HttpHeaders::empty
+
+auto HttpHeaders::begin(void) const
+    -> const_iterator
+{
+    return const_iterator(this, 0);
+}// end HttpHeaders::begin
+
+auto HttpHeaders::end(void) const
+    -> const_iterator
+{
+    return const_iterator(this, m_fields.size());
+}// end HttpHeaders::end
+
+// return: the number of fields named <name>
+auto HttpHeaders::count(view_type name) const
+    -> size_t
+{
+    size_t      n       = 0;
+
+    for (size_t i = 0; i < m_fields.size(); ++i)
+    {
+        n += equals_ci(field(i).name, name);
+    }// end for i
+
+    return n;
+}// end HttpHeaders::count
+
+// return: the whole value of the last field named <name>, or an empty view
+//  if there is none
+auto HttpHeaders::get(view_type name) const
+    -> view_type
+{
+    const Span      *span       = find_last(name);
+
+    return span
+        ? view_type(m_block.data() + span->valueBeg, span->valueLen)
+        : view_type();
+}// end HttpHeaders::get
+
+// return: the value of field <name>, without its parameters (i.e.
+//  "text/html" for "text/html; charset=utf-8")
+auto HttpHeaders::value(view_type name) const
+    -> view_type
+{
+    const view_type     full    = get(name);
+
+    return trim(full.substr(0, full.find(';')));
+}// end HttpHeaders::value
+
+// Splits the parameters of field <name> until one named <param> turns up.
+//  return: the parameter's value, unquoted, or an empty view if it has none
+auto HttpHeaders::param(view_type name, view_type param) const
+    -> view_type
+{
+    const view_type     full    = get(name);
+    size_t              beg     = full.find(';');
+
+    while (beg < full.size())
+    {
+        bool            quoted  = false;
+        size_t          end     = ++beg;
+        size_t          eq;
+        view_type       item;
+
+        // a quoted value may contain ';'
+        while ((end < full.size()) and (quoted or (';' != full[end])))
+        {
+            quoted ^= ('"' == full[end]);
+            ++end;
+        }// end while
+
+        item = full.substr(beg, end - beg);
+        eq = item.find('=');
+        if (
+            (view_type::npos != eq)
+            and equals_ci(trim(item.substr(0, eq)), param)
+        )
+        {
+            item = trim(item.substr(eq + 1));
+            if ((item.size() >= 2) and ('"' == item.front())
+                and ('"' == item.back()))
+            {
+                item = item.substr(1, item.size() - 2);
+            }
+            return item;
+        }
+
+        beg = end;
+    }// end while
+
+    return view_type();
+}// end HttpHeaders::param
+
+// return: the media type of the body (i.e. "text/html")
+auto HttpHeaders::content_type(void) const
+    -> view_type
+{
+    return value("content-type");
+}// end HttpHeaders::content_type
+
+auto HttpHeaders::charset(void) const
+    -> view_type
+{
+    return param("content-type", "charset");
+}// end HttpHeaders::charset
+
+auto HttpHeaders::location(void) const
+    -> view_type
+{
+    return get("location");
+}// end HttpHeaders::location
+
+// return: true if there is a valid Content-Length, which is stored in
+//  <length>
+auto HttpHeaders::content_length(size_t& length) const
+    -> bool
+{
+    const view_type     text    = get("content-length");
+    size_t              n       = 0;
+
+    if (text.empty())
+    {
+        return false;
+    }
+
+    for (const char ch : text)
+    {
+        if (
+            (not isdigit(ch))
+            or (n > (std::numeric_limits<size_t>::max() - (ch - '0')) / 10)
+        )
+        {
+            return false;
+        }
+        n = n * 10 + (ch - '0');
+    }// end for ch
+
+    length = n;
+    return true;
+}// end HttpHeaders::content_length
+
+// --- public mutators ----------------------------------------------------
+
+// Appends a field. <name> and <value> must not be views into these headers.
+void HttpHeaders::add(view_type name, view_type value)
+{
+    Span        span;
+
+    name = trim(name);
+    value = trim(value);
+
+    span.nameBeg = m_block.size();
+    span.nameLen = name.size();
+    for (const char ch : name)
+    {
+        m_block.push_back(tolower(ch));
+    }// end for ch
+    m_block.push_back(':');
+
+    span.valueBeg = m_block.size();
+    span.valueLen = value.size();
+    m_block.append(value.data(), value.size());
+    m_block.push_back('\n');
+
+    m_fields.push_back(span);
+}// end HttpHeaders::add
+
+// Parses a single "name: value" header line. Lines without a name are
+// ignored.
+//  return: true if a field was added
+auto HttpHeaders::add_line(view_type line)
+    -> bool
+{
+    const size_t    colon   = line.find(':');
+
+    if ((view_type::npos == colon) or trim(line.substr(0, colon)).empty())
+    {
+        return false;
+    }
+
+    add(line.substr(0, colon), line.substr(colon + 1));
+    return true;
+}// end HttpHeaders::add_line
+
+// Replaces any fields named <name> with a single one.
+void HttpHeaders::set(view_type name, view_type value)
+{
+    erase(name);
+    add(name, value);
+}// end HttpHeaders::set
+
+// return: the number of fields removed
+auto HttpHeaders::erase(view_type name)
+    -> size_t
+{
+    const size_t    oldSize     = m_fields.size();
+
+    m_fields.erase(
+        std::remove_if(
+            m_fields.begin(),
+            m_fields.end(),
+            [&](const Span& span) -> bool
+            {
+                return equals_ci(
+                    view_type(m_block.data() + span.nameBeg, span.nameLen),
+                    name
+                );
+            }
+        ),
+        m_fields.end()
+    );
+
+    return oldSize - m_fields.size();
+}// end HttpHeaders::erase
+
+void HttpHeaders::clear(void)
+{
+    m_block.clear();
+    m_fields.clear();
+}// end HttpHeaders::clear
+
+// --- public static functions --------------------------------------------
+auto HttpHeaders::equals_ci(view_type a, view_type b)
+    -> bool
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (tolower(a[i]) != tolower(b[i]))
+        {
+            return false;
+        }
+    }// end for i
+
+    return true;
+}// end HttpHeaders::equals_ci
+
+// return: <text>, without leading and trailing spaces, tabs and carriage
+//  returns
+auto HttpHeaders::trim(view_type text)
+    -> view_type
+{
+    static const char   *WS     = " \t\r";
+    const size_t        beg     = text.find_first_not_of(WS);
+
+    if (view_type::npos == beg)
+    {
+        return view_type();
+    }
+
+    return text.substr(beg, text.find_last_not_of(WS) + 1 - beg);
+}// end HttpHeaders::trim
+
+// --- private accessors --------------------------------------------------
+auto HttpHeaders::field(size_t idx) const
+    -> Field
+{
+    const Span&     span    = m_fields[idx];
+
+    return {
+        view_type(m_block.data() + span.nameBeg, span.nameLen),
+        view_type(m_block.data() + span.valueBeg, span.valueLen),
+    };
+}// end HttpHeaders::field
+
+auto HttpHeaders::find_last(view_type name) const
+    -> const Span*
+{
+    for (size_t i = m_fields.size(); i > 0; --i)
+    {
+        if (equals_ci(field(i - 1).name, name))
+        {
+            return &m_fields[i - 1];
+        }
+    }// end for i
+
+    return nullptr;
+}// end HttpHeaders::find_last
+
+// === class HttpHeaders::const_iterator Implementation ===================
+//
+// ========================================================================
+
+// --- private constructors -----------------------------------------------
+HttpHeaders::const_iterator::const_iterator(
+    const HttpHeaders *headers,
+    size_t idx
+)
+    : m_headers(headers), m_idx(idx)
+{
+    // do nothing
+}// end HttpHeaders::const_iterator::const_iterator
+
+// --- public accessors ---------------------------------------------------
+auto HttpHeaders::const_iterator::operator*(void) const
+    -> Field
+{
+    return m_headers->field(m_idx);
+}// end HttpHeaders::const_iterator::operator*
+
+auto HttpHeaders::const_iterator::operator==(const const_iterator& other) const
+    -> bool
+{
+    return (m_headers == other.m_headers) and (m_idx == other.m_idx);
+}// end HttpHeaders::const_iterator::operator==
+
+auto HttpHeaders::const_iterator::operator!=(const const_iterator& other) const
+    -> bool
+{
+    return not (*this == other);
+}// end HttpHeaders::const_iterator::operator!=
+
+// --- public mutators ----------------------------------------------------
+auto HttpHeaders::const_iterator::operator++(void)
+    -> const_iterator&
+{
+    ++m_idx;
+    return *this;
+}// end HttpHeaders::const_iterator::operator++
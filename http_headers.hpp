@@ -0,0 +1,133 @@
+#ifndef __HTTP_HEADERS_HPP__
+#define __HTTP_HEADERS_HPP__
+
+#include <initializer_list>
+#include <string_view>
+
+#include "deps.hpp"
+
+// === class HttpHeaders ==================================================
+//
+// Header fields of an HTTP response, kept as a flat table of (name, value)
+// spans into a single block of text. Adding a field appends its name
+// (lower-cased) and value (trimmed) to the block, and one entry to the
+// table; nothing else is allocated, and lookups hand out views into the
+// block rather than copies.
+//
+// Names are matched case-insensitively. Repeated fields are all kept, in
+// order; get() and friends see the last one. Parameters (i.e. the
+// "charset=utf-8" of "text/html; charset=utf-8") are only split out when
+// asked for.
+//
+// Views are valid until the headers are next changed or destroyed.
+// Removing fields leaves their text in the block, until clear().
+//
+// ========================================================================
+class HttpHeaders
+{
+    public:
+        // --- public member types ----------------------------------------
+        typedef     std::string_view            view_type;
+        struct      Field
+        {
+            view_type       name;
+            view_type       value;
+        };// end struct Field
+        class       const_iterator;
+
+        // --- public constructors ----------------------------------------
+        HttpHeaders(void);
+        HttpHeaders(std::initializer_list<std::pair<view_type,view_type>> fields);
+
+        // --- public accessors -------------------------------------------
+        auto size(void) const
+            -> size_t;
+        auto empty(void) const
+            -> bool;
+        auto begin(void) const
+            -> const_iterator;
+        auto end(void) const
+            -> const_iterator;
+        auto count(view_type name) const
+            -> size_t;
+        auto get(view_type name) const
+            -> view_type;
+        auto value(view_type name) const
+            -> view_type;
+        auto param(view_type name, view_type param) const
+            -> view_type;
+        auto content_type(void) const
+            -> view_type;
+        auto charset(void) const
+            -> view_type;
+        auto location(void) const
+            -> view_type;
+        auto content_length(size_t& length) const
+            -> bool;
+
+        // --- public mutators --------------------------------------------
+        void add(view_type name, view_type value);
+        auto add_line(view_type line)
+            -> bool;
+        void set(view_type name, view_type value);
+        auto erase(view_type name)
+            -> size_t;
+        void clear(void);
+
+        // --- public static functions ------------------------------------
+        static auto equals_ci(view_type a, view_type b)
+            -> bool;
+        static auto trim(view_type text)
+            -> view_type;
+    private:
+        // --- private member types ---------------------------------------
+        struct      Span
+        {
+            size_t          nameBeg;
+            size_t          nameLen;
+            size_t          valueBeg;
+            size_t          valueLen;
+        };// end struct Span
+
+        // --- private member variables -----------------------------------
+        string              m_block         = "";
+        std::vector<Span>   m_fields        = {};
+
+        // --- private accessors ------------------------------------------
+        auto field(size_t idx) const
+            -> Field;
+        auto find_last(view_type name) const
+            -> const Span*;
+};// end class HttpHeaders
+
+// === class HttpHeaders::const_iterator ==================================
+//
+// Walks the fields of an HttpHeaders in order, as (name, value) views.
+//
+// ========================================================================
+class HttpHeaders::const_iterator
+{
+    friend class HttpHeaders;
+
+    public:
+        // --- public accessors -------------------------------------------
+        auto operator*(void) const
+            -> Field;
+        auto operator==(const const_iterator& other) const
+            -> bool;
+        auto operator!=(const const_iterator& other) const
+            -> bool;
+
+        // --- public mutators --------------------------------------------
+        auto operator++(void)
+            -> const_iterator&;
+    private:
+        // --- private member variables -----------------------------------
+        const HttpHeaders   *m_headers      = nullptr;
+        size_t              m_idx           = 0;
+
+        // --- private constructors ---------------------------------------
+        const_iterator(const HttpHeaders *headers, size_t idx);
+};// end class HttpHeaders::const_iterator
+
+#endif
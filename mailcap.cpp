@@ -269,19 +269,9 @@ auto Mailcap::Entry::passes_test(void) const
 
     auto    sproc   = m_test.spawn();
 
-    sproc.stdin().close();
-
-    while (sproc.stdout())
-    {
-        sproc.stdout().ignore(INT_MAX);
-    }
-    sproc.stdout().close();
-
-    while (sproc.stderr())
-    {
-        sproc.stderr().ignore(INT_MAX);
-    }
-    sproc.stderr().close();
+    // discard output; drain stdout and stderr together, so a test that
+    // fills one pipe while we wait on the other can't hang
+    sproc.communicate(nullptr, 0);
 
     return sproc.wait() == 0;
 }// end Mailcap::Entry::passes_test
@@ -1,5 +1,6 @@
 #include <cstdio>
 #include <climits>
+#include <cstring>
 #include <map>
 #include <list>
 #include <unordered_set>
@@ -98,8 +99,13 @@ int main(const int argc, const char **argv, const char **envp)
     #define     CURL_COMMAND    \
     "curl " \
         "--include " \
+        "--no-buffer " \
         "--request \"${W3M_REQUEST_METHOD}\" " \
         "--data @- " \
+        "${W3M_IF_NONE_MATCH:+--header \"If-None-Match: ${W3M_IF_NONE_MATCH}\"} " \
+        "${W3M_IF_MODIFIED_SINCE:+--header \"If-Modified-Since: ${W3M_IF_MODIFIED_SINCE}\"} " \
+        "${W3M_RANGE:+--header \"Range: ${W3M_RANGE}\"} " \
+        "--header \"Accept-Encoding: ${W3M_ACCEPT_ENCODING:-gzip, deflate}\" " \
         "--user-agent \"${W3M_USER_AGENT}\" " \
         "\"${W3M_URL}\""
     App::Config     config      = {
@@ -121,11 +127,15 @@ int main(const int argc, const char **argv, const char **envp)
                 CURL_COMMAND
             },
         },
+        // uriCoprocesses
+        {},
         // initUrl
         "",
         // tempdir
         // TODO: actually set from ENV
         "/tmp",
+        // tempInMemory
+        false,
         // viewer
         {
             // attribs
@@ -154,6 +164,34 @@ int main(const int argc, const char **argv, const char **envp)
             "MAIN",                     // prefix
             "%a, %d %b %Y %T %z",       // timeFormat
         },
+        // cache
+        {
+            "",                         // dir
+            0x4000000,                  // maxSize
+        },
+        // documentCache
+        {
+            0x2000000,                  // maxSize
+            300,                        // lifetime
+        },
+        // prefetch
+        {
+            300,                        // dwellMs
+            0,                          // visibleLinks
+            2,                          // maxConcurrent
+            0x800000,                   // maxBytes
+            { "http", "https" },        // schemes
+            60,                         // lifetime
+        },
+        // scheduler
+        {
+            16,                         // maxConcurrent
+            6,                          // maxPerHost
+        },
+        // metrics
+        {
+            "",                         // filename
+        },
     };
 
     #undef  CURL_COMMAND
@@ -183,6 +221,56 @@ int main(const int argc, const char **argv, const char **envp)
         }
     }
 
+    // get cache directory; caching is disabled if set but empty
+    if (getenv("W3M_CACHE_DIR"))
+    {
+        config.cache.dir = getenv("W3M_CACHE_DIR");
+    }
+    else if (getenv("XDG_CACHE_HOME") and *getenv("XDG_CACHE_HOME"))
+    {
+        config.cache.dir = string(getenv("XDG_CACHE_HOME")) + "/w3m-reborn";
+    }
+    else if (getenv("HOME") and *getenv("HOME"))
+    {
+        config.cache.dir = string(getenv("HOME")) + "/.cache/w3m-reborn";
+    }
+
+    // get number of on-screen links to prefetch
+    if (getenv("W3M_PREFETCH_LINKS"))
+    {
+        sscanf(
+            getenv("W3M_PREFETCH_LINKS"),
+            " %zu",
+            &config.prefetch.visibleLinks
+        );
+    }
+
+    // keep handler input in memory, if enabled
+    if (getenv("W3M_TEMP_IN_MEMORY"))
+    {
+        config.tempInMemory = strcmp(getenv("W3M_TEMP_IN_MEMORY"), "0");
+    }
+
+    // get persistent http(s) handler, if any
+    if (getenv("W3M_HTTP_COPROCESS"))
+    {
+        config.uriCoprocesses["http"] = getenv("W3M_HTTP_COPROCESS");
+        config.uriCoprocesses["https"] = getenv("W3M_HTTP_COPROCESS");
+    }
+
+    // use the built-in http client, if requested
+    if (getenv("W3M_HTTP_NATIVE") and *getenv("W3M_HTTP_NATIVE"))
+    {
+        config.uriHandlers["http"] = HttpFetcher::NATIVE_HANDLER;
+        config.uriCoprocesses.erase("http");
+    }
+
+    // get file to append navigation timings to, if any
+    if (getenv("W3M_METRICS_FILE"))
+    {
+        config.metrics.filename = getenv("W3M_METRICS_FILE");
+    }
+
     // set up signal handler(s)
     signal(SIGINT, handle_signal_term);
     #ifdef SIGALRM
@@ -328,7 +416,7 @@ void    goto_url(
         Uri                         target              = targetUrl;
         Uri                         prevUri             = {};
         Uri                         fullUri;
-        const string                *contentType        = nullptr;
+        string                      contentType         = "";
         s_ptr<Document>             doc                 = nullptr;
         unordered_set<string>       visitedUris         = {};
 
@@ -352,28 +440,20 @@ void    goto_url(
             data = fetcher.fetch_url(status, headers, fullUri);
 
             prevUri = fullUri;
-            if (headers.count("location")
-                and (not headers.at("location").empty())
-            )
+            if (not headers.location().empty())
             {
-                target = headers.at("location").at(0);
+                target = string(headers.location());
             }
         } while (
             (status.code >= 300)
             and (status.code < 400)
-            and headers.count("location")
+            and (not headers.location().empty())
         );// end do while
 
-        if (
-            headers.count("content-type")
-            and (not headers.at("content-type").empty())
-        )
-        {
-            contentType = &headers.at("content-type").front();
-        }
+        contentType = headers.content_type();
 
         // create document, if applicable
-        if (not contentType)
+        if (contentType.empty())
         {
             tab.curr_page()->viewer().refresh(true);
             tab.curr_page()->viewer().disp_status(
@@ -381,7 +461,7 @@ void    goto_url(
             );
             goto finally;
         }
-        else if (*contentType == "text/plain")
+        else if (contentType == "text/plain")
         {
             doc.reset(new DocumentText(
                 cfg.document,
@@ -389,7 +469,7 @@ void    goto_url(
                 COLS
             ));
         }
-        else if (*contentType == "text/html")
+        else if (contentType == "text/html")
         {
             doc.reset(new DocumentHtml(
                 cfg.document,
@@ -404,7 +484,7 @@ void    goto_url(
         }
         else
         {
-            handle_data(mailcaps, cfg, *contentType, data);
+            handle_data(mailcaps, cfg, contentType, data);
         }
 finally:
         tab.curr_page()->viewer().refresh(true);
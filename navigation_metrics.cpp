@@ -0,0 +1,224 @@
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+#include "deps.hpp"
+
+#include "navigation_metrics.hpp"
+
+// === class NavigationMetrics Implementation =============================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+NavigationMetrics::NavigationMetrics(void)
+{
+    // do nothing
+}// end NavigationMetrics::NavigationMetrics
+
+NavigationMetrics::NavigationMetrics(const Config& cfg)
+{
+    m_cfg = cfg;
+}// end NavigationMetrics::NavigationMetrics
+
+// --- public accessors ---------------------------------------------------
+auto NavigationMetrics::config(void) const
+    -> const Config&
+{
+    return m_cfg;
+}// end NavigationMetrics::config
+
+// return: number of navigations recorded
+auto NavigationMetrics::count(void) const
+    -> size_t
+{
+    return m_count;
+}// end NavigationMetrics::count
+
+// return: the last navigation recorded, or nullptr if there is none
+auto NavigationMetrics::last(void) const
+    -> const Record*
+{
+    return m_count ? &m_last : nullptr;
+}// end NavigationMetrics::last
+
+// --- public mutators ----------------------------------------------------
+
+// Records a navigation, appending it to the metrics file, if any.
+//  return: false if the record couldn't be written to the file
+auto NavigationMetrics::add(const Record& record)
+    -> bool
+{
+    m_last = record;
+    ++m_count;
+
+    if (m_cfg.filename.empty())
+    {
+        return true;
+    }
+
+    std::ofstream   file(m_cfg.filename, std::ios::app);
+
+    file << to_json(record) << '\n';
+
+    return bool(file);
+}// end NavigationMetrics::add
+
+// --- public static functions --------------------------------------------
+
+// return: milliseconds from one point in time to a later one, or 0 if
+//  either wasn't reached (is the epoch) or they are out of order
+auto NavigationMetrics::elapsed_ms(
+    clock_type::time_point from,
+    clock_type::time_point to
+) -> double
+{
+    if (
+        (clock_type::time_point() == from)
+        or (clock_type::time_point() == to)
+        or (to < from)
+    )
+    {
+        return 0;
+    }
+
+    return to_ms(to - from);
+}// end NavigationMetrics::elapsed_ms
+
+auto NavigationMetrics::to_ms(clock_type::duration duration)
+    -> double
+{
+    return std::chrono::duration<double,std::milli>(duration).count();
+}// end NavigationMetrics::to_ms
+
+// Formats a record for the status line, i.e.:
+//
+//  200 network 51234B 812 nodes: spawn 2.1 ttfb 40.3 xfer 12.0 parse 8.2
+//  layout 5.1 paint 1.0 = 70.2ms
+//
+// Phases that took no time are left out.
+auto NavigationMetrics::format(const Record& record)
+    -> string
+{
+    const std::pair<const char*,double>     phases[]    = {
+        { "redirect", record.redirectMs },
+        { "queue", record.queueMs },
+        { "spawn", record.spawnMs },
+        { "ttfb", record.ttfbMs },
+        { "xfer", record.transferMs },
+        { "parse", record.parseMs },
+        { "layout", record.layoutMs },
+        { "paint", record.paintMs },
+    };
+    std::stringstream                       fmt;
+    char                                    buf[32];
+
+    fmt << record.status << " " << record.source << " "
+        << record.bytes << "B";
+    if (record.nodes)
+    {
+        fmt << " " << record.nodes << " nodes";
+    }
+    fmt << ":";
+
+    for (const auto& phase : phases)
+    {
+        if (phase.second > 0)
+        {
+            snprintf(buf, sizeof(buf), "%.1f", phase.second);
+            fmt << " " << phase.first << " " << buf;
+        }
+    }// end for phase
+
+    snprintf(buf, sizeof(buf), "%.1f", record.totalMs);
+    fmt << " = " << buf << "ms";
+
+    return fmt.str();
+}// end NavigationMetrics::format
+
+// return: a record as a single line of JSON; times are in milliseconds
+auto NavigationMetrics::to_json(const Record& record)
+    -> string
+{
+    const std::pair<const char*,double>     phases[]    = {
+        { "redirect", record.redirectMs },
+        { "queue", record.queueMs },
+        { "spawn", record.spawnMs },
+        { "ttfb", record.ttfbMs },
+        { "transfer", record.transferMs },
+        { "parse", record.parseMs },
+        { "layout", record.layoutMs },
+        { "paint", record.paintMs },
+        { "total", record.totalMs },
+    };
+    std::stringstream                       fmt;
+    char                                    buf[32];
+
+    fmt << "{\"time\":" << record.time
+        << ",\"url\":" << json_string(record.url)
+        << ",\"source\":" << json_string(record.source)
+        << ",\"status\":" << record.status
+        << ",\"redirects\":" << record.redirects
+        << ",\"bytes\":" << record.bytes
+        << ",\"wire_bytes\":" << record.wireBytes
+        << ",\"nodes\":" << record.nodes
+        << ",\"lines\":" << record.lines
+        << ",\"ms\":{";
+
+    for (size_t i = 0; i < sizeof(phases) / sizeof(*phases); ++i)
+    {
+        snprintf(buf, sizeof(buf), "%.3f", phases[i].second);
+        fmt << (i ? "," : "") << "\"" << phases[i].first << "\":" << buf;
+    }// end for i
+
+    fmt << "}}";
+
+    return fmt.str();
+}// end NavigationMetrics::to_json
+
+// --- private static functions -------------------------------------------
+
+// return: a string as a quoted JSON string, with special characters
+//  escaped
+auto NavigationMetrics::json_string(const string& str)
+    -> string
+{
+    string      out     = "\"";
+    char        buf[8];
+
+    for (const char ch : str)
+    {
+        switch (ch)
+        {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if ((unsigned char)(ch) < 0x20)
+                {
+                    snprintf(buf, sizeof(buf), "\\u%04x", ch);
+                    out += buf;
+                }
+                else
+                {
+                    out += ch;
+                }
+        }// end switch
+    }// end for ch
+
+    return out + "\"";
+}// end NavigationMetrics::json_string
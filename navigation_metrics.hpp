@@ -0,0 +1,102 @@
+#ifndef __NAVIGATION_METRICS_HPP__
+#define __NAVIGATION_METRICS_HPP__
+
+#include <chrono>
+#include <ctime>
+
+#include "deps.hpp"
+
+// === class NavigationMetrics ============================================
+//
+// Keeps a breakdown of where the time went in each navigation, so that a
+// slow page can be put down to its handler, the network, parsing, layout
+// or painting. Each phase is the time between two points on the
+// navigation's timeline:
+//
+//  redirect    navigation started, to the final hop being requested
+//  queue       final hop requested, to its transfer being started by the
+//              FetchScheduler
+//  spawn       transfer started, to its handler running (or its connection
+//              opened)
+//  ttfb        handler running, to the first byte of its response
+//  transfer    first byte, to the end of the response
+//  parse       building the DOM tree (html only)
+//  layout      laying the document out to the screen width
+//  paint       drawing the page on screen
+//  total       navigation started, to the page being shown
+//
+// Phases that a navigation skipped (i.e. one served from memory has no
+// transfer) are 0. The last record is kept for display; if a file is
+// configured, every record is also appended to it as one line of JSON.
+//
+// ========================================================================
+class NavigationMetrics
+{
+    public:
+        // --- public member types ----------------------------------------
+        typedef     std::chrono::steady_clock   clock_type;
+        struct      Config
+        {
+            string          filename;
+        };// end struct Config
+        struct      Record
+        {
+            time_t          time        = 0;
+            string          url         = "";
+            string          source      = "";
+            int             status      = 0;
+            size_t          redirects   = 0;
+            size_t          bytes       = 0;
+            size_t          wireBytes   = 0;
+            size_t          nodes       = 0;
+            size_t          lines       = 0;
+            double          redirectMs  = 0;
+            double          queueMs     = 0;
+            double          spawnMs     = 0;
+            double          ttfbMs      = 0;
+            double          transferMs  = 0;
+            double          parseMs     = 0;
+            double          layoutMs    = 0;
+            double          paintMs     = 0;
+            double          totalMs     = 0;
+        };// end struct Record
+
+        // --- public constructors ----------------------------------------
+        NavigationMetrics(void);
+        NavigationMetrics(const Config& cfg);
+
+        // --- public accessors -------------------------------------------
+        auto config(void) const
+            -> const Config&;
+        auto count(void) const
+            -> size_t;
+        auto last(void) const
+            -> const Record*;
+
+        // --- public mutators --------------------------------------------
+        auto add(const Record& record)
+            -> bool;
+
+        // --- public static functions ------------------------------------
+        static auto elapsed_ms(
+            clock_type::time_point from,
+            clock_type::time_point to
+        ) -> double;
+        static auto to_ms(clock_type::duration duration)
+            -> double;
+        static auto format(const Record& record)
+            -> string;
+        static auto to_json(const Record& record)
+            -> string;
+    private:
+        // --- private member variables -----------------------------------
+        Config          m_cfg           = {};
+        Record          m_last          = {};
+        size_t          m_count         = 0;
+
+        // --- private static functions -----------------------------------
+        static auto json_string(const string& str)
+            -> string;
+};// end class NavigationMetrics
+
+#endif
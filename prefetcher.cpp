@@ -0,0 +1,221 @@
+#include <ctime>
+#include <list>
+#include <set>
+
+#include <poll.h>
+
+#include "deps.hpp"
+#include "uri.hpp"
+#include "http_fetcher.hpp"
+#include "http_cache.hpp"
+#include "fetch_scheduler.hpp"
+
+#include "prefetcher.hpp"
+
+// === class Prefetcher Implementation ====================================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+Prefetcher::Prefetcher(void)
+{
+    // do nothing
+}// end Prefetcher::Prefetcher
+
+Prefetcher::Prefetcher(const Config& cfg)
+{
+    m_cfg = cfg;
+}// end Prefetcher::Prefetcher
+
+// --- public accessors ---------------------------------------------------
+auto Prefetcher::config(void) const
+    -> const Config&
+{
+    return m_cfg;
+}// end Prefetcher::config
+
+auto Prefetcher::stats(void) const
+    -> const Stats&
+{
+    return m_stats;
+}// end Prefetcher::stats
+
+auto Prefetcher::enabled(void) const
+    -> bool
+{
+    return m_cfg.maxConcurrent and m_cfg.maxBytes and m_cfg.lifetime
+        and (not m_cfg.schemes.empty());
+}// end Prefetcher::enabled
+
+// return: number of prefetches still in progress (or waiting to start)
+auto Prefetcher::running(void) const
+    -> size_t
+{
+    size_t      count   = 0;
+
+    for (const auto& entry : m_entries)
+    {
+        if (not entry.job->finished())
+        {
+            ++count;
+        }
+    }// end for entry
+
+    return count;
+}// end Prefetcher::running
+
+// return: true if a url is worth prefetching now: its scheme is allowed,
+//  it isn't already held, and the concurrency and size limits have room
+auto Prefetcher::accepts(const Uri& url) const
+    -> bool
+{
+    const string    key     = HttpCache::key(url);
+    size_t          bytes   = 0;
+
+    if ((not enabled()) or (not m_cfg.schemes.count(url.scheme)))
+    {
+        return false;
+    }
+
+    if (running() >= m_cfg.maxConcurrent)
+    {
+        return false;
+    }
+
+    for (const auto& entry : m_entries)
+    {
+        if (entry.key == key)
+        {
+            return false;
+        }
+        bytes += entry.job->bytes_received();
+    }// end for entry
+
+    return bytes < m_cfg.maxBytes;
+}// end Prefetcher::accepts
+
+// Adds the file descriptors of running prefetches to a poll set.
+void Prefetcher::get_pollfds(std::vector<struct pollfd>& fds) const
+{
+    for (const auto& entry : m_entries)
+    {
+        const auto&     transfer    = entry.job->transfer;
+
+        if ((not transfer) or transfer->finished())
+        {
+            continue;
+        }
+
+        fds.push_back({ transfer->fd(), POLLIN, 0 });
+        if (transfer->write_fd() >= 0)
+        {
+            fds.push_back({ transfer->write_fd(), POLLOUT, 0 });
+        }
+    }// end for entry
+}// end Prefetcher::get_pollfds
+
+// --- public mutators ----------------------------------------------------
+void Prefetcher::add(const Uri& url, const FetchScheduler::job_pointer& job)
+{
+    m_entries.push_back({
+        HttpCache::key(url),
+        job,
+        time(nullptr)
+    });
+    ++m_stats.started;
+}// end Prefetcher::add
+
+// Hands over the prefetch of a url being visited, if there is one.
+//  return: the (possibly still running or queued) job, or nullptr on a miss
+auto Prefetcher::take(const Uri& url)
+    -> FetchScheduler::job_pointer
+{
+    const string    key     = HttpCache::key(url);
+
+    for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+    {
+        if (iter->key == key)
+        {
+            const FetchScheduler::job_pointer   job     = iter->job;
+
+            m_entries.erase(iter);
+            ++m_stats.hits;
+            m_stats.bytes += job->bytes_received();
+
+            return job;
+        }
+    }// end for iter
+
+    ++m_stats.misses;
+    return nullptr;
+}// end Prefetcher::take
+
+// Reads pending output from running prefetches without blocking, then
+// drops expired prefetches and the largest ones over the size budget.
+void Prefetcher::update(time_t now)
+{
+    size_t      bytes       = 0;
+
+    for (auto iter = m_entries.begin(); iter != m_entries.end();)
+    {
+        auto    curr    = iter++;
+
+        if (curr->job->transfer)
+        {
+            curr->job->transfer->update();
+        }
+
+        if (curr->started + m_cfg.lifetime <= now)
+        {
+            drop(curr);
+            continue;
+        }
+
+        bytes += curr->job->bytes_received();
+    }// end for iter
+
+    while (bytes > m_cfg.maxBytes)
+    {
+        auto    largest     = std::max_element(
+                                m_entries.begin(),
+                                m_entries.end(),
+                                [](const Entry& a, const Entry& b)
+                                {
+                                    return a.job->bytes_received()
+                                        < b.job->bytes_received();
+                                }
+                            );
+
+        bytes -= largest->job->bytes_received();
+        drop(largest);
+    }// end while
+}// end Prefetcher::update
+
+void Prefetcher::clear(void)
+{
+    while (not m_entries.empty())
+    {
+        drop(m_entries.begin());
+    }// end while
+}// end Prefetcher::clear
+
+// --- private mutators ---------------------------------------------------
+
+// Discards an unused prefetch, aborting it if it is still running.
+void Prefetcher::drop(entry_container::iterator iter)
+{
+    if (iter->job->finished())
+    {
+        ++m_stats.wasted;
+    }
+    else
+    {
+        ++m_stats.aborted;
+        if (iter->job->transfer)
+        {
+            iter->job->transfer->cancel();
+        }
+    }
+
+    m_entries.erase(iter);
+}// end Prefetcher::drop
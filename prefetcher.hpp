@@ -0,0 +1,96 @@
+#ifndef __PREFETCHER_HPP__
+#define __PREFETCHER_HPP__
+
+#include <ctime>
+#include <list>
+#include <set>
+
+#include <poll.h>
+
+#include "deps.hpp"
+#include "uri.hpp"
+#include "http_fetcher.hpp"
+#include "fetch_scheduler.hpp"
+
+// === class Prefetcher ===================================================
+//
+// Holds speculative fetches of links the user is likely to follow (i.e.
+// the link under a resting cursor). Prefetches run in the background like
+// navigations, but at lower priority: they are submitted to the
+// FetchScheduler in the prefetch class, they are only driven once running
+// navigations have been serviced, a limited number are held at once, and
+// the largest are aborted once their combined size passes a budget.
+//
+// When a prefetched url is then visited, its job (finished, running or
+// still queued) is handed over to the navigation. Prefetches that aren't
+// used within their lifetime are dropped. Counters of hits, misses and
+// wasted prefetches are kept to help tune the policy.
+//
+// ========================================================================
+class Prefetcher
+{
+    public:
+        // --- public member types ----------------------------------------
+        typedef     std::set<string>            scheme_set;
+        struct      Config
+        {
+            int             dwellMs;
+            size_t          visibleLinks;
+            size_t          maxConcurrent;
+            size_t          maxBytes;
+            scheme_set      schemes;
+            time_t          lifetime;
+        };// end struct Config
+        struct      Stats
+        {
+            size_t          started;
+            size_t          hits;
+            size_t          misses;
+            size_t          wasted;
+            size_t          aborted;
+            size_t          bytes;
+        };// end struct Stats
+
+        // --- public constructors ----------------------------------------
+        Prefetcher(void);
+        Prefetcher(const Config& cfg);
+
+        // --- public accessors -------------------------------------------
+        auto config(void) const
+            -> const Config&;
+        auto stats(void) const
+            -> const Stats&;
+        auto enabled(void) const
+            -> bool;
+        auto running(void) const
+            -> size_t;
+        auto accepts(const Uri& url) const
+            -> bool;
+        void get_pollfds(std::vector<struct pollfd>& fds) const;
+
+        // --- public mutators --------------------------------------------
+        void add(const Uri& url, const FetchScheduler::job_pointer& job);
+        auto take(const Uri& url)
+            -> FetchScheduler::job_pointer;
+        void update(time_t now);
+        void clear(void);
+    private:
+        // --- private member types ---------------------------------------
+        struct  Entry
+        {
+            string                          key;
+            FetchScheduler::job_pointer     job;
+            time_t                          started;
+        };// end struct Entry
+        typedef std::list<Entry>        entry_container;
+
+        // --- private member variables -----------------------------------
+        Config              m_cfg           = {};
+        Stats               m_stats         = {};
+        entry_container     m_entries       = {};
+
+        // --- private mutators -------------------------------------------
+        void drop(entry_container::iterator iter);
+};// end class Prefetcher
+
+#endif
@@ -59,6 +59,20 @@ auto Tab::curr_page(void) const
     return &(*m_pageIter);
 }// end Tab::curr_page
 
+auto Tab::has_page(const Page *page) const
+    -> bool
+{
+    for (const auto& pg : m_pages)
+    {
+        if (&pg == page)
+        {
+            return true;
+        }
+    }// end for
+
+    return false;
+}// end Tab::has_page
+
 // --- public mutators --------------------------------------------
 auto Tab::curr_page(void)
     -> Page*
@@ -281,6 +295,14 @@ auto Tab::Page::title(void) const
     }
 }// end Tab::Page::title
 
+// return: true if the document is also held elsewhere (i.e. by another
+//  page, or the document cache)
+auto Tab::Page::shares_document(void) const
+    -> bool
+{
+    return m_documentPtr.use_count() > 1;
+}// end Tab::Page::shares_document
+
 // --- public mutators ----------------------------------------------------
 auto Tab::Page::document(void)
     -> Document&
@@ -288,6 +310,13 @@ auto Tab::Page::document(void)
     return *m_documentPtr.get();
 }// end Tab::Page::document
 
+// Replaces the page's document, keeping the viewer's position.
+void Tab::Page::set_document(const s_ptr<Document>& doc)
+{
+    m_documentPtr = doc;
+    m_viewer.set_document(m_documentPtr.get());
+}// end Tab::Page::set_document
+
 auto Tab::Page::viewer(void)
     -> Viewer&
 {
@@ -40,10 +40,13 @@ class Tab
                     -> const Uri&;
                 auto title(void) const
                     -> string;
+                auto shares_document(void) const
+                    -> bool;
 
                 // --- public mutators ------------------------------------
                 auto document(void)
                     -> Document&;
+                void set_document(const s_ptr<Document>& doc);
                 auto viewer(void)
                     -> Viewer&;
                 auto operator=(const type& orig)
@@ -81,6 +84,8 @@ class Tab
             -> const page_container&;
         auto curr_page(void) const
             -> const Page*;
+        auto has_page(const Page *page) const
+            -> bool;
 
         // --- public mutators --------------------------------------------
         auto curr_page(void)
@@ -0,0 +1,197 @@
+#include <cerrno>
+#include <utility>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#include "deps.hpp"
+
+#include "temp_file.hpp"
+
+// === class TempFile Implementation ======================================
+//
+// ========================================================================
+
+// --- public constructors ------------------------------------------------
+TempFile::TempFile(void)
+{
+    // do nothing
+}// end TempFile::TempFile
+
+// Creates (or truncates) a file on disk at <path>. Check is_open for
+// success.
+TempFile::TempFile(const string& path)
+{
+    m_fd = ::open(
+        path.c_str(),
+        O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+        0600
+    );
+
+    if (m_fd >= 0)
+    {
+        m_path = path;
+    }
+}// end TempFile::TempFile
+
+TempFile::TempFile(TempFile&& other)
+{
+    *this = std::move(other);
+}// end TempFile::TempFile
+
+TempFile::~TempFile(void)
+{
+    discard();
+}// end TempFile::~TempFile
+
+// --- public accessors ---------------------------------------------------
+auto TempFile::is_open(void) const
+    -> bool
+{
+    return m_fd >= 0;
+}// end TempFile::is_open
+
+auto TempFile::is_memory(void) const
+    -> bool
+{
+    return m_isMemory;
+}// end TempFile::is_memory
+
+// return: path by which a handler can open the file; for an in-memory
+//  file, only valid in processes that inherited it
+auto TempFile::path(void) const
+    -> const string&
+{
+    return m_path;
+}// end TempFile::path
+
+auto TempFile::fd(void) const
+    -> int
+{
+    return m_fd;
+}// end TempFile::fd
+
+// --- public mutators ----------------------------------------------------
+auto TempFile::operator=(TempFile&& other)
+    -> TempFile&
+{
+    if (this != &other)
+    {
+        discard();
+        m_fd = other.m_fd;
+        m_path = std::move(other.m_path);
+        m_isMemory = other.m_isMemory;
+        other.m_fd = -1;
+        other.m_path.clear();
+    }
+
+    return *this;
+}// end TempFile::operator=
+
+// Appends <len> bytes to the file.
+//
+// return: false if they could not all be written
+auto TempFile::write(const char *data, size_t len)
+    -> bool
+{
+    while (len)
+    {
+        const ssize_t   nWritten    = ::write(m_fd, data, len);
+
+        if (nWritten < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += nWritten;
+        len -= nWritten;
+    }// end while
+
+    return true;
+}// end TempFile::write
+
+// Marks the file complete: an in-memory file is sealed, so that a handler
+// sees it exactly as written.
+void TempFile::finish(void)
+{
+    #ifdef F_ADD_SEALS
+    if (m_isMemory and (m_fd >= 0))
+    {
+        fcntl(
+            m_fd,
+            F_ADD_SEALS,
+            F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL
+        );
+    }
+    #endif
+}// end TempFile::finish
+
+// Sets whether processes spawned from now on inherit the descriptor.
+void TempFile::set_inheritable(bool inheritable)
+{
+    if (m_fd < 0)
+    {
+        return;
+    }
+
+    fcntl(
+        m_fd,
+        F_SETFD,
+        inheritable
+            ? (fcntl(m_fd, F_GETFD) & ~FD_CLOEXEC)
+            : (fcntl(m_fd, F_GETFD) | FD_CLOEXEC)
+    );
+}// end TempFile::set_inheritable
+
+// Closes our descriptor. An in-memory file lives on for as long as a
+// process it was passed to holds it; a file on disk, until destruction.
+void TempFile::close(void)
+{
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}// end TempFile::close
+
+// --- public static functions --------------------------------------------
+
+// Creates an in-memory file, if the system supports them. Check is_open
+// for success.
+//
+// param name: name of the file, for debugging only (i.e. in /proc/PID/fd)
+auto TempFile::in_memory(const string& name)
+    -> TempFile
+{
+    TempFile        file;
+
+    #ifdef MFD_ALLOW_SEALING
+    file.m_fd = memfd_create(name.c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (file.m_fd >= 0)
+    {
+        file.m_isMemory = true;
+        file.m_path = "/proc/self/fd/" + std::to_string(file.m_fd);
+    }
+    #endif
+
+    return file;
+}// end TempFile::in_memory
+
+// --- private mutators ---------------------------------------------------
+
+// Closes the file, removing it if it is on disk.
+void TempFile::discard(void)
+{
+    close();
+
+    if ((not m_isMemory) and (not m_path.empty()))
+    {
+        ::unlink(m_path.c_str());
+    }
+    m_path.clear();
+    m_isMemory = false;
+}// end TempFile::discard
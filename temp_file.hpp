@@ -0,0 +1,64 @@
+#ifndef __TEMP_FILE_HPP__
+#define __TEMP_FILE_HPP__
+
+#include "deps.hpp"
+
+// === class TempFile =====================================================
+//
+// File holding the input of a mailcap handler, for as long as the handler
+// needs it.
+//
+// An in-memory file (see TempFile::in_memory) is an anonymous memfd, named
+// /proc/self/fd/N; a process spawned while it is inheritable opens it
+// through that path. Once complete, it is sealed against any further
+// change. Its memory is released once every process holding it (this
+// object included) has closed it, so closing it after spawning the
+// handler ties its lifetime to the handler's.
+//
+// Otherwise, it is a regular file, which is removed when the TempFile is
+// destroyed.
+//
+// ========================================================================
+class TempFile
+{
+    public:
+        // --- public constructors ----------------------------------------
+        TempFile(void);
+        TempFile(const string& path);
+        TempFile(TempFile&& other);
+        TempFile(const TempFile& other) = delete;
+        ~TempFile(void);
+
+        // --- public accessors -------------------------------------------
+        auto is_open(void) const
+            -> bool;
+        auto is_memory(void) const
+            -> bool;
+        auto path(void) const
+            -> const string&;
+        auto fd(void) const
+            -> int;
+
+        // --- public mutators --------------------------------------------
+        auto operator=(TempFile&& other)
+            -> TempFile&;
+        auto write(const char *data, size_t len)
+            -> bool;
+        void finish(void);
+        void set_inheritable(bool inheritable);
+        void close(void);
+
+        // --- public static functions ------------------------------------
+        static auto in_memory(const string& name)
+            -> TempFile;
+    private:
+        // --- private member variables -----------------------------------
+        int                 m_fd            = -1;
+        string              m_path          = "";
+        bool                m_isMemory      = false;
+
+        // --- private mutators -------------------------------------------
+        void discard(void);
+};// end class TempFile
+
+#endif
@@ -0,0 +1,124 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "../deps.hpp"
+#include "../uri.hpp"
+#include "../http_fetcher.hpp"
+
+// === main ===============================================================
+//
+// Fetches a large file through a handler, with and without a
+// content-length header, and saved straight to a file through a sink.
+// Prints the time taken and throughput of each.
+//
+// Usage: bench_body_read.out [body size in MiB (default: 256)]
+//  [rounds (default: 5)]
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    const size_t        nMiB        = (argc > 1) ? atol(argv[1]) : 256;
+    const size_t        nRounds     = (argc > 2) ? atol(argv[2]) : 5;
+    const string        src         = "/tmp/w3m_bench_body_read."
+                                        + to_string(getpid());
+    const string        dst         = src + ".out";
+    HttpFetcher         fetcher(
+                            "printf 'content-type: application/octet-stream\\n'; "
+                            "[ -n \"${LENGTH}\" ] && "
+                            "printf 'content-length: %s\\n' \"${LENGTH}\"; "
+                            "printf '\\n'; "
+                            "cat \"${FILE}\"",
+                            "W3M_URL"
+                        );
+    bool                ok          = true;
+
+    {
+        string          block(1 << 20, '\0');
+        ofstream        file(src, ios::binary);
+
+        for (size_t i = 0; i < block.size(); ++i)
+        {
+            block[i] = 'a' + (i % 26);
+        }// end for i
+        for (size_t i = 0; i < nMiB; ++i)
+        {
+            file << block;
+        }// end for i
+    }
+
+    cout << setw(16) << "mode" << setw(12) << "best ms" << setw(12)
+        << "MiB/s" << endl;
+
+    for (const string mode : { "no length", "content-length", "sink" })
+    {
+        double      bestMs      = 0;
+
+        for (size_t round = 0; round < nRounds; ++round)
+        {
+            const auto      start       = steady_clock::now();
+            auto            transfer    = fetcher.start_fetch(
+                                            Uri("file:///dev/null"),
+                                            {},
+                                            {
+                                                {
+                                                    "LENGTH",
+                                                    ("no length" == mode)
+                                                        ? ""
+                                                        : to_string(nMiB << 20)
+                                                },
+                                                { "FILE", src },
+                                            }
+                                        );
+            int             sink        = -1;
+            size_t          size        = 0;
+            double          ms;
+
+            if ("sink" == mode)
+            {
+                while (not transfer->headers_ready())
+                {
+                    transfer->update();
+                }// end while
+                sink = open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+                transfer->set_sink(sink);
+            }
+
+            transfer->wait();
+            size = transfer->body().size();
+
+            if (sink >= 0)
+            {
+                struct stat     st;
+
+                fstat(sink, &st);
+                size = st.st_size;
+                close(sink);
+            }
+
+            ms = duration<double, milli>(steady_clock::now() - start)
+                .count();
+            bestMs = round ? min(bestMs, ms) : ms;
+            ok = ok and (size == (nMiB << 20));
+        }// end for round
+
+        cout << setw(16) << mode << setw(12) << fixed << setprecision(1)
+            << bestMs << setw(12) << (nMiB / bestMs * 1e3) << endl;
+    }// end for mode
+
+    unlink(src.c_str());
+    unlink(dst.c_str());
+
+    cout << "sizes match: " << (ok ? "yes" : "no") << endl;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}// end int main
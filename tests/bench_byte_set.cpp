@@ -0,0 +1,166 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "../deps.hpp"
+#include "../byte_set.hpp"
+
+typedef ByteSet::Kernel         Kernel;
+
+// === make_prose =========================================================
+//
+// Returns <size> bytes of long text runs: paragraphs of words with a tag
+// only every few hundred bytes, as in an article.
+//
+// ========================================================================
+string make_prose(size_t size)
+{
+    static const char   *words[]    = {
+        "browser", "terminal", "network", "document", "render", "layout",
+        "cursor", "link", "table", "form", "input", "buffer", "handler",
+        "cache", "request", "response", "header", "stream", "page", "text",
+    };
+    string              out         = "";
+
+    srand(1);
+    while (out.size() < size)
+    {
+        out += "<p>";
+        for (size_t i = 0; i < 60; ++i)
+        {
+            out += words[rand() % 20];
+            out += (i % 12 == 11) ? ".\n" : " ";
+        }// end for i
+        out += "</p>\n";
+    }// end while
+
+    return out;
+}// end make_prose
+
+// === make_markup ========================================================
+//
+// Returns <size> bytes of markup-dense input: short elements with
+// attributes and entities, as in a table or a navigation bar.
+//
+// ========================================================================
+string make_markup(size_t size)
+{
+    std::ostringstream      out;
+
+    srand(2);
+    while (size_t(out.tellp()) < size)
+    {
+        out << "<tr class=r" << rand() % 2 << "><td><a href=\"/i/"
+            << rand() % 1000 << "\">" << rand() % 100
+            << "</a>&nbsp;</td><td><b>x</b>&amp;<i>y</i></td></tr>\n";
+    }// end while
+
+    return out.str();
+}// end make_markup
+
+// === scan ===============================================================
+//
+// return: the number of delimiters found in <data>, searching from just
+//  past each one to the next, as a tokenizer would
+//
+// ========================================================================
+size_t scan(const ByteSet& set, const string& data)
+{
+    const char      *curr       = data.data();
+    const char      *end        = curr + data.size();
+    size_t          count       = 0;
+
+    while ((curr = set.find_first(curr, end)) != end)
+    {
+        ++count;
+        ++curr;
+    }// end while
+
+    return count;
+}// end scan
+
+// === main ===============================================================
+//
+// Times ByteSet::find_first with each kernel the CPU supports, on long
+// text runs and on markup-dense input, for the delimiter sets the
+// tokenizer and entity decoding use.
+//
+// Usage: bench_byte_set.out [repetitions (default: 20)]
+//  [input MiB (default: 4)]
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    const size_t        reps        = (argc > 1) ? atol(argv[1]) : 20;
+    const size_t        size        = ((argc > 2) ? atol(argv[2]) : 4) << 20;
+    const struct
+    {
+        const char      *name;
+        string          data;
+    }                   inputs[]    = {
+        { "prose", make_prose(size) },
+        { "markup", make_markup(size) },
+    };
+    const struct
+    {
+        const char      *name;
+        const char      *bytes;
+    }                   sets[]      = {
+        { "tag name", " \t\r\n<>/" },
+        { "attribute", " \t\r\n<>=" },
+        { "entity", "&;" },
+    };
+    const Kernel        best        = ByteSet::kernel();
+
+    cout << "default kernel: " << ByteSet::kernel_name(best) << endl;
+    cout << setw(8) << "input"
+        << setw(11) << "set"
+        << setw(8) << "kernel"
+        << setw(10) << "found"
+        << setw(10) << "MB/s"
+        << endl;
+
+    for (const auto& input : inputs)
+    {
+        for (const auto& set : sets)
+        {
+            const ByteSet   byteSet(set.bytes);
+
+            for (const Kernel kernel : { Kernel::scalar, Kernel::sse2,
+                Kernel::avx2 })
+            {
+                size_t              found       = 0;
+                duration<double>    elapsed     = {};
+                const auto          start       = steady_clock::now();
+
+                if (not ByteSet::set_kernel(kernel))
+                {
+                    continue;
+                }
+
+                for (size_t i = 0; i < reps; ++i)
+                {
+                    found = scan(byteSet, input.data);
+                }// end for i
+                elapsed = steady_clock::now() - start;
+
+                cout << setw(8) << input.name
+                    << setw(11) << set.name
+                    << setw(8) << ByteSet::kernel_name(kernel)
+                    << setw(10) << found
+                    << setw(10) << fixed << setprecision(0)
+                        << (input.data.size() * reps / elapsed.count() / 1e6)
+                    << endl;
+            }// end for kernel
+        }// end for set
+    }// end for input
+
+    ByteSet::set_kernel(best);
+
+    return EXIT_SUCCESS;
+}// end int main
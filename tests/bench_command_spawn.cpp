@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#include <unistd.h>
+#include <wait.h>
+
+#include "../deps.hpp"
+#include "../command.hpp"
+
+// === time_spawns ========================================================
+//
+// Returns the mean time (in microseconds) taken to run <spawn> <nRuns>
+// times.
+//
+// ========================================================================
+template <class FUNC_T>
+double time_spawns(FUNC_T spawn, const int nRuns)
+{
+    using namespace std::chrono;
+
+    const auto      start       = steady_clock::now();
+
+    for (int i = 0; i < nRuns; ++i)
+    {
+        spawn();
+    }// end for i
+
+    return duration<double, std::micro>(steady_clock::now() - start).count()
+        / nRuns;
+}// end time_spawns
+
+// === main ===============================================================
+//
+// Measures the latency of spawning (and reaping) a trivial subprocess as
+// our resident memory grows, comparing Command::spawn against a plain
+// fork/execvp.
+//
+// Usage: bench_command_spawn.out [max resident MiB (default: 1024)]
+//          [runs per measurement (default: 200)]
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const size_t        maxMiB      = (argc > 1) ? atol(argv[1]) : 1024;
+    const int           nRuns       = (argc > 2) ? atoi(argv[2]) : 200;
+    const Command       cmd(vector<string>{ "true" }, true, true, false);
+    vector<u_ptr<char[]>>   blocks  = {};
+    size_t              residentMiB = 0;
+
+    cout << setw(14) << "resident MiB"
+        << setw(20) << "Command::spawn us"
+        << setw(20) << "fork/execvp us" << endl;
+
+    for (size_t target = 0; target <= maxMiB; target = target ? target * 4 : 16)
+    {
+        // grow (and touch, so it is actually resident) memory
+        while (residentMiB < target)
+        {
+            blocks.emplace_back(new char[1 << 20]);
+            memset(blocks.back().get(), 1, 1 << 20);
+            ++residentMiB;
+        }// end while
+
+        const double    spawnUs     = time_spawns([&cmd](void)
+        {
+            auto    sproc   = cmd.spawn();
+
+            sproc.stdin().close();
+            sproc.stdout().close();
+            sproc.wait();
+        }, nRuns);
+
+        const double    forkUs      = time_spawns([](void)
+        {
+            static char     prog[]      = "true";
+            char            *args[]     = { prog, nullptr };
+            const pid_t     pid         = fork();
+
+            if (0 == pid)
+            {
+                execvp(args[0], args);
+                _exit(127);
+            }
+            waitpid(pid, nullptr, 0);
+        }, nRuns);
+
+        cout << setw(14) << residentMiB
+            << setw(20) << fixed << setprecision(1) << spawnUs
+            << setw(20) << forkUs << endl;
+    }// end for target
+
+    return EXIT_SUCCESS;
+}// end int main
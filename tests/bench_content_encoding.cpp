@@ -0,0 +1,187 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <unistd.h>
+#include <zlib.h>
+
+#include "../deps.hpp"
+#include "../uri.hpp"
+#include "../http_fetcher.hpp"
+#include "../byte_buffer.hpp"
+#include "../document_html.hpp"
+
+// === make_page ==========================================================
+//
+// Returns the source of a page of <nParas> paragraphs, with some variety
+// of text, as on a typical article or listing page.
+//
+// ========================================================================
+string make_page(size_t seed, size_t nParas)
+{
+    static const char   *words[]    = {
+        "browser", "terminal", "network", "document", "render", "layout",
+        "cursor", "link", "table", "form", "input", "buffer", "handler",
+        "cache", "request", "response", "header", "stream", "page", "text",
+    };
+    std::ostringstream      html;
+
+    srand(seed);
+    html << "<html><head><title>Page " << seed << "</title></head><body>";
+    for (size_t i = 0; i < nParas; ++i)
+    {
+        html << "<p class=\"para\">";
+        for (size_t j = 0; j < 40; ++j)
+        {
+            html << words[rand() % 20] << ' ';
+        }// end for j
+        html << "<a href=\"/item/" << rand() % 100000 << "\">item "
+            << i << "</a></p>\n";
+    }// end for i
+    html << "</body></html>";
+
+    return html.str();
+}// end make_page
+
+// === gzip ===============================================================
+//
+// Returns <text>, gzip-compressed at zlib's default level.
+//
+// ========================================================================
+std::vector<char> gzip(const string& text)
+{
+    std::vector<char>   out(compressBound(text.size()) + 32);
+    z_stream            stream  = {};
+
+    deflateInit2(
+        &stream,
+        Z_DEFAULT_COMPRESSION,
+        Z_DEFLATED,
+        15 + 16,
+        8,
+        Z_DEFAULT_STRATEGY
+    );
+    stream.next_in = (Bytef*)(text.data());
+    stream.avail_in = text.size();
+    stream.next_out = (Bytef*)(out.data());
+    stream.avail_out = out.size();
+    deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return out;
+}// end gzip
+
+// === main ===============================================================
+//
+// Loads a local corpus of pages through an HttpFetcher handler, as sent
+// uncompressed and gzip-compressed, and lays each out as a document.
+// Prints the bytes transferred, the local load time (fetch, decode, parse
+// and layout), and an estimate of the load time over a link of the given
+// bandwidth (transfer time at that rate, plus the local time).
+//
+// Usage: bench_content_encoding.out [pages (default: 50)]
+//  [link Mbit/s (default: 20)]
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    const size_t            nPages      = (argc > 1) ? atol(argv[1]) : 50;
+    const double            mbits       = (argc > 2) ? atof(argv[2]) : 20;
+    const string            dir         = "/tmp/w3m_bench_content_encoding."
+                                            + to_string(getpid());
+    const Document::Config  cfg         = { { 40, 0, SIZE_MAX } };
+    HttpFetcher             fetcher(
+                                "printf 'content-type: text/html\\n'; "
+                                "[ -n \"${ENCODING}\" ] && "
+                                "printf 'content-encoding: %s\\n' "
+                                    "\"${ENCODING}\"; "
+                                "printf '\\n'; "
+                                "cat \"${FILE}\"",
+                                "W3M_URL"
+                            );
+    size_t                  sourceSize  = 0;
+
+    if (system(("mkdir -p " + dir).c_str()))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // build corpus: pages of 20-400 paragraphs (~6 KiB to ~130 KiB)
+    for (size_t i = 0; i < nPages; ++i)
+    {
+        const string            page        = make_page(i, 20 + (i * 37) % 380);
+        const auto              packed      = gzip(page);
+        ofstream                plain(dir + "/" + to_string(i) + ".html");
+        ofstream                compressed(dir + "/" + to_string(i) + ".gz");
+
+        plain << page;
+        compressed.write(packed.data(), packed.size());
+        sourceSize += page.size();
+    }// end for i
+
+    cout << "corpus: " << nPages << " pages, " << sourceSize << " bytes"
+        << endl;
+    cout << setw(10) << "encoding"
+        << setw(14) << "transferred"
+        << setw(10) << "ratio"
+        << setw(12) << "local ms"
+        << setw(20) << ("est. ms @ " + to_string((int)(mbits)) + "Mbit/s")
+        << endl;
+
+    for (const string encoding : { "", "gzip" })
+    {
+        size_t          transferred     = 0;
+        size_t          nNodes          = 0;
+        const auto      start           = steady_clock::now();
+        double          localMs;
+        double          linkMs;
+
+        for (size_t i = 0; i < nPages; ++i)
+        {
+            const string    file    = dir + "/" + to_string(i)
+                                        + (encoding.empty() ? ".html" : ".gz");
+            auto            transfer    = fetcher.start_fetch(
+                                            Uri("file:///dev/null"),
+                                            {},
+                                            {
+                                                { "ENCODING", encoding },
+                                                { "FILE", file },
+                                            }
+                                        );
+
+            transfer->wait();
+            transferred += transfer->bytes_received();
+            nNodes += DocumentHtml(
+                cfg,
+                ByteBuffer(transfer->release_body()),
+                80
+            ).buffer().size();
+        }// end for i
+
+        localMs = duration<double, milli>(steady_clock::now() - start)
+            .count();
+        linkMs = transferred * 8 / (mbits * 1e6) * 1e3 + localMs;
+
+        cout << setw(10) << (encoding.empty() ? "identity" : encoding)
+            << setw(14) << transferred
+            << setw(10) << fixed << setprecision(2)
+                << ((double)(sourceSize) / transferred)
+            << setw(12) << setprecision(1) << localMs
+            << setw(20) << linkMs
+            << "  (" << nNodes << " lines)" << endl;
+    }// end for encoding
+
+    if (system(("rm -rf " + dir).c_str()))
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}// end int main
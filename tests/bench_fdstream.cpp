@@ -0,0 +1,192 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "../deps.hpp"
+#include "../fdstream.hpp"
+
+// === class legacy_streambuf =============================================
+//
+// The previous fdstream_streambuf input implementation, kept for
+// comparison: grows its buffer by 256 bytes on every read and never
+// discards consumed data.
+//
+// ========================================================================
+class   legacy_streambuf : public std::streambuf
+{
+    public:
+        legacy_streambuf(const int fd)
+            : m_fd(fd)
+        {
+            // do nothing
+        }
+    protected:
+        const int           m_fd            = -1;
+        std::vector<char>   m_buffer        = {};
+
+        const size_t        C_BUFFER_INCREMENT   = 256;
+
+        virtual int underflow(void)
+            override
+        {
+            const size_t        oldBufSize      = m_buffer.size();
+            ssize_t             nRead;
+
+            m_buffer.resize(oldBufSize + C_BUFFER_INCREMENT);
+            nRead = ::read(m_fd, &m_buffer.at(oldBufSize), C_BUFFER_INCREMENT);
+            m_buffer.resize(oldBufSize + std::max<ssize_t>(nRead, 0));
+
+            if (m_buffer.size() == oldBufSize)
+            {
+                return traits_type::eof();
+            }
+
+            setg(
+                &m_buffer.front(),
+                &m_buffer.at(oldBufSize),
+                &m_buffer.back() + 1
+            );
+
+            return traits_type::to_int_type(m_buffer.at(oldBufSize));
+        }
+};// end class legacy_streambuf
+
+// === open_stream ========================================================
+//
+// Returns the read end of a pipe, fed <len> bytes of 80-column lines by a
+// child process.
+//
+// ========================================================================
+int open_stream(size_t len)
+{
+    int         fds[2];
+
+    if (pipe(fds))
+    {
+        perror("pipe");
+        exit(EXIT_FAILURE);
+    }
+
+    if (0 == fork())
+    {
+        std::vector<char>   block(0x10000, 'x');
+
+        close(fds[0]);
+        for (size_t i = 79; i < block.size(); i += 80)
+        {
+            block[i] = '\n';
+        }// end for i
+        while (len)
+        {
+            const ssize_t   nWritten    = write(
+                                            fds[1],
+                                            block.data(),
+                                            std::min(len, block.size())
+                                        );
+
+            if (nWritten <= 0)
+            {
+                _exit(EXIT_FAILURE);
+            }
+            len -= nWritten;
+        }// end while
+        _exit(EXIT_SUCCESS);
+    }
+
+    close(fds[1]);
+    return fds[0];
+}// end open_stream
+
+// === run ================================================================
+//
+// Reads <len> bytes from a pipe through <STREAMBUF_T>, either line by line
+// or in 64 KiB blocks, in a child process; prints the throughput, then the
+// child's peak resident memory.
+//
+// ========================================================================
+template <class STREAMBUF_T>
+void run(const string& name, const string& mode, size_t len)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    struct rusage       usage       = {};
+    int                 status;
+    pid_t               pid;
+
+    cout << setw(10) << name << setw(10) << mode << flush;
+
+    if (0 == (pid = fork()))
+    {
+        const int           fd          = open_stream(len);
+        STREAMBUF_T         buf(fd);
+        std::istream        stream(&buf);
+        const auto          start       = steady_clock::now();
+        size_t              nRead       = 0;
+        double              secs;
+
+        if ("lines" == mode)
+        {
+            string      line;
+
+            while (getline(stream, line))
+            {
+                nRead += line.size() + (stream.eof() ? 0 : 1);
+            }// end while
+        }
+        else
+        {
+            vector<char>    block(0x10000);
+
+            while (stream.read(block.data(), block.size()) or stream.gcount())
+            {
+                nRead += stream.gcount();
+            }// end while
+        }
+
+        secs = duration<double>(steady_clock::now() - start).count();
+        cout << setw(14) << fixed << setprecision(1)
+            << (nRead / secs / (1 << 20)) << flush;
+        close(fd);
+        wait(nullptr);
+        _exit(nRead == len ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    wait4(pid, &status, 0, &usage);
+    cout << setw(16) << (usage.ru_maxrss / 1024)
+        << (WEXITSTATUS(status) ? "  (short read)" : "") << endl;
+}// end run
+
+// === main ===============================================================
+//
+// Measures the throughput and memory use of reading a local pipe through
+// fdstream_streambuf, compared with the previous implementation.
+//
+// Usage: bench_fdstream.out [stream MiB (default: 256)]
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const size_t        len         = ((argc > 1) ? atol(argv[1]) : 256) << 20;
+
+    cout << setw(10) << "impl"
+        << setw(10) << "mode"
+        << setw(14) << "MiB/s"
+        << setw(16) << "peak RSS MiB" << endl;
+
+    for (const string mode : { "lines", "blocks" })
+    {
+        run<legacy_streambuf>("legacy", mode, len);
+        run<fdstream_streambuf>("fdstream", mode, len);
+    }// end for mode
+
+    return EXIT_SUCCESS;
+}// end int main
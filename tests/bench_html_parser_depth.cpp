@@ -0,0 +1,142 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "../deps.hpp"
+#include "../html_parser_basic.hpp"
+#include "../dom_tree.hpp"
+
+// === make_nested ========================================================
+//
+// Returns the source of a page of <nBlocks> blocks, each nested <depth>
+// elements deep; if not <closed>, no element is ever closed, as in
+// generated forum html that opens a <div> or <font> per post.
+//
+// ========================================================================
+string make_nested(size_t nBlocks, size_t depth, bool closed)
+{
+    static const char   *tags[]     = { "div", "font", "span", "blockquote" };
+    std::ostringstream  html;
+
+    html << "<html><body>";
+    for (size_t i = 0; i < nBlocks; ++i)
+    {
+        for (size_t j = 0; j < depth; ++j)
+        {
+            html << '<' << tags[j % 4] << " class=\"c" << j % 7 << "\">"
+                << "post " << i << " level " << j << ' ';
+        }// end for j
+        if (closed)
+        {
+            for (size_t j = depth; j > 0; --j)
+            {
+                html << "</" << tags[(j - 1) % 4] << '>';
+            }// end for j
+        }
+        html << '\n';
+    }// end for i
+    html << "</body></html>";
+
+    return html.str();
+}// end make_nested
+
+// === tree_depth =========================================================
+//
+// ========================================================================
+size_t tree_depth(const DomTree::node& nd)
+{
+    size_t      depth       = 0;
+
+    if (nd.is_text())
+    {
+        return 0;
+    }
+    for (auto iter = nd.cbegin(); iter != nd.cend(); ++iter)
+    {
+        depth = std::max(depth, tree_depth(*iter));
+    }// end for iter
+
+    return depth + 1;
+}// end tree_depth
+
+// === main ===============================================================
+//
+// Parses pages of increasingly deep nesting, closed and unclosed, with
+// HtmlParserBasic, and prints the parse throughput, the number of nodes
+// and the depth of the resulting tree.
+//
+// Usage: bench_html_parser_depth.out [repetitions (default: 10)]
+//  [max depth (default: HtmlParserBasic::DEFAULT_MAX_DEPTH)]
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    const size_t        reps        = (argc > 1) ? atol(argv[1]) : 10;
+    HtmlParserBasic     parser;
+    const struct
+    {
+        const char  *name;
+        size_t      nBlocks;
+        size_t      depth;
+        bool        closed;
+    }                   corpora[]   = {
+        { "flat", 4000, 1, true },
+        { "nested 50", 200, 50, true },
+        { "nested 400", 25, 400, true },
+        { "unclosed 400", 1, 400, false },
+        { "unclosed 10000", 1, 10000, false },
+        { "unclosed 100000", 1, 100000, false },
+    };
+
+    if (argc > 2)
+    {
+        parser.set_max_depth(atol(argv[2]));
+    }
+
+    cout << setw(18) << "corpus"
+        << setw(12) << "bytes"
+        << setw(10) << "MB/s"
+        << setw(10) << "nodes"
+        << setw(8) << "depth"
+        << endl;
+
+    for (const auto& corpus : corpora)
+    {
+        const string    page        = make_nested(
+                                        corpus.nBlocks,
+                                        corpus.depth,
+                                        corpus.closed
+                                    );
+        size_t          nNodes      = 0;
+        size_t          depth       = 0;
+        duration<double>    elapsed     = {};
+
+        for (size_t i = 0; i < reps; ++i)
+        {
+            DomTree             dom;
+            istringstream       ins(page);
+            const auto          start   = steady_clock::now();
+
+            dom.reset_root("window");
+            parser.parse_html(*dom.root(), ins);
+            elapsed += steady_clock::now() - start;
+            nNodes = dom.size();
+            depth = tree_depth(*dom.root());
+        }// end for i
+
+        cout << setw(18) << corpus.name
+            << setw(12) << page.size()
+            << setw(10) << fixed << setprecision(1)
+                << (page.size() * reps / elapsed.count() / 1e6)
+            << setw(10) << nNodes
+            << setw(8) << depth
+            << endl;
+    }// end for corpus
+
+    return EXIT_SUCCESS;
+}// end int main
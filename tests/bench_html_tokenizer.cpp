@@ -0,0 +1,139 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "../deps.hpp"
+#include "../byte_buffer.hpp"
+#include "../html_tokenizer.hpp"
+#include "../html_parser_basic.hpp"
+#include "../dom_tree.hpp"
+
+// === make_page ==========================================================
+//
+// Returns the source of a page of <nRows> rows of typical markup: a
+// listing with links, attributes, inline formatting, entities and the odd
+// comment or script.
+//
+// ========================================================================
+string make_page(size_t seed, size_t nRows)
+{
+    static const char   *words[]    = {
+        "browser", "terminal", "network", "document", "render", "layout",
+        "cursor", "link", "table", "form", "input", "buffer", "handler",
+        "cache", "request", "response", "header", "stream", "page", "text",
+    };
+    std::ostringstream      html;
+
+    srand(seed);
+    html << "<!DOCTYPE html>\n<html><head><title>Page " << seed
+        << "</title><style>td { padding: 1px; }</style></head>\n<body>"
+        << "<table class=\"listing\" width=\"100%\">\n";
+    for (size_t i = 0; i < nRows; ++i)
+    {
+        html << "<tr class=\"row" << i % 2 << "\"><td align=right>" << i
+            << ".</td><td><a href=\"/item/" << rand() % 100000
+            << "?ref=list&amp;p=" << i << "\" id=\"i" << i << "\">";
+        for (size_t j = 0; j < 8; ++j)
+        {
+            html << words[rand() % 20] << ' ';
+        }// end for j
+        html << "</a> <span class=meta>by <b>" << words[rand() % 20]
+            << "</b> &mdash; " << rand() % 500 << " points</span><br>";
+        for (size_t j = 0; j < 24; ++j)
+        {
+            html << words[rand() % 20] << ' ';
+        }// end for j
+        html << "</td></tr>\n";
+        if (i % 50 == 0)
+        {
+            html << "<!-- page break " << i << " -->\n"
+                << "<script>var n = " << i << "; if (n < 10) {}</script>\n";
+        }
+    }// end for i
+    html << "</table></body></html>";
+
+    return html.str();
+}// end make_page
+
+// === main ===============================================================
+//
+// Parses a corpus of pages into DomTrees, both from a stream (as a
+// ByteBuffer::Reader) and in place (with an HtmlTokenizer), and prints the
+// throughput of each, and of tokenizing alone.
+//
+// Usage: bench_html_tokenizer.out [repetitions (default: 20)]
+//  [rows per page (default: 2000)]
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    const size_t        reps        = (argc > 1) ? atol(argv[1]) : 20;
+    const size_t        nRows       = (argc > 2) ? atol(argv[2]) : 2000;
+    const ByteBuffer    page(make_page(1, nRows));
+    HtmlParserBasic     parser;
+    duration<double>    elapsed[3]  = {};
+    size_t              nNodes[2]   = {};
+    size_t              nTokens     = 0;
+
+    for (size_t i = 0; i < reps; ++i)
+    {
+        {
+            DomTree                 dom;
+            ByteBuffer::Reader      ins(page);
+            const auto              start       = steady_clock::now();
+
+            dom.reset_root("window");
+            parser.parse_html(*dom.root(), ins);
+            elapsed[0] += steady_clock::now() - start;
+            nNodes[0] = dom.size();
+        }
+        {
+            DomTree                 dom;
+            const auto              start       = steady_clock::now();
+
+            dom.reset_root("window");
+            parser.parse_html(*dom.root(), page.begin(), page.end());
+            elapsed[1] += steady_clock::now() - start;
+            nNodes[1] = dom.size();
+        }
+        {
+            HtmlTokenizer           tokenizer(page.begin(), page.end());
+            HtmlTokenizer::Token    token;
+            const auto              start       = steady_clock::now();
+
+            nTokens = 0;
+            while (tokenizer.next(token))
+            {
+                ++nTokens;
+            }// end while
+            elapsed[2] += steady_clock::now() - start;
+        }
+    }// end for i
+
+    cout << "page: " << page.size() << " bytes, " << nTokens << " tokens"
+        << endl;
+    cout << setw(12) << "method"
+        << setw(10) << "MB/s"
+        << setw(10) << "nodes"
+        << setw(10) << "speedup"
+        << endl;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const char      *names[]    = { "stream", "in place", "tokenize" };
+
+        cout << setw(12) << names[i]
+            << setw(10) << fixed << setprecision(1)
+                << (page.size() * reps / elapsed[i].count() / 1e6)
+            << setw(10) << ((i < 2) ? nNodes[i] : nTokens)
+            << setw(10) << setprecision(2)
+                << (elapsed[0].count() / elapsed[i].count())
+            << endl;
+    }// end for i
+
+    return EXIT_SUCCESS;
+}// end int main
@@ -0,0 +1,53 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+
+#include "../deps.hpp"
+#include "../command.hpp"
+#include "../uri.hpp"
+#include "../http_fetcher.hpp"
+
+// === main ===============================================================
+//
+// Pushes a large request body through an echo handler, which starts
+// writing its response before it has read all of its input. With
+// half-duplex pipe handling this deadlocks once both pipes fill up.
+//
+// Usage: bench_http_fetcher.out [body size in MiB (default: 100)]
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    const size_t                nMiB        = (argc > 1) ? atol(argv[1]) : 100;
+    HttpFetcher                 fetcher(
+                                    "printf 'content-type: text/plain\\n\\n'; cat",
+                                    "W3M_URL"
+                                );
+    HttpFetcher::Status         status;
+    HttpFetcher::header_type    headers;
+    HttpFetcher::data_container input(nMiB << 20);
+    HttpFetcher::data_container body;
+
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = 'a' + (i % 26);
+    }// end for i
+
+    const auto      start       = steady_clock::now();
+
+    body = fetcher.fetch_url(status, headers, Uri("file:///dev/stdin"), input);
+
+    const auto      elapsed     = duration<double>(steady_clock::now() - start);
+
+    cout << "body sent:     " << input.size() << " bytes" << endl;
+    cout << "body received: " << body.size() << " bytes" << endl;
+    cout << "matches:       " << (body == input ? "yes" : "no") << endl;
+    cout << "elapsed:       " << elapsed.count() << " s" << endl;
+    cout << "throughput:    " << (nMiB / elapsed.count()) << " MiB/s" << endl;
+
+    return (body == input) ? EXIT_SUCCESS : EXIT_FAILURE;
+}// end int main
@@ -0,0 +1,221 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+
+#include "../deps.hpp"
+#include "../fdstream.hpp"
+#include "../document_html.hpp"
+
+// === class legacy_streambuf =============================================
+//
+// The previous fdstream_streambuf output implementation, kept for
+// comparison: one write(2) per character put, and one per string.
+//
+// ========================================================================
+class   legacy_streambuf : public std::streambuf
+{
+    public:
+        legacy_streambuf(const int fd)
+            : m_fd(fd)
+        {
+            // do nothing
+        }
+    protected:
+        const int           m_fd            = -1;
+
+        virtual int overflow(int c = EOF)
+            override
+        {
+            if (c != EOF)
+            {
+                char        ch      = c;
+
+                ::write(m_fd, &ch, 1);
+            }
+            return c;
+        }
+        virtual std::streamsize xsputn(const char *s, std::streamsize n)
+            override
+        {
+            return ::write(m_fd, s, n);
+        }
+};// end class legacy_streambuf
+
+// === open_cat ===========================================================
+//
+// Returns the write end of a pipe into `cat > /dev/null`.
+//
+// ========================================================================
+int open_cat(pid_t& pid)
+{
+    int         fds[2];
+
+    if (pipe(fds))
+    {
+        perror("pipe");
+        exit(EXIT_FAILURE);
+    }
+
+    if (0 == (pid = fork()))
+    {
+        dup2(fds[0], STDIN_FILENO);
+        dup2(open("/dev/null", O_WRONLY), STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        execlp("cat", "cat", nullptr);
+        _exit(EXIT_FAILURE);
+    }
+
+    close(fds[0]);
+    return fds[1];
+}// end open_cat
+
+// === run ================================================================
+//
+// Pipes a page's text to cat through <STREAMBUF_T>, either all at once,
+// line by line (as `out << line << '\n'`), or as one gathered write of
+// all lines; prints the throughput.
+//
+// ========================================================================
+template <class STREAMBUF_T>
+void run(
+    const string& name,
+    const string& mode,
+    const string& text,
+    const std::vector<string>& lines
+)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    pid_t           pid;
+    const int       fd          = open_cat(pid);
+    const auto      start       = steady_clock::now();
+    double          secs;
+
+    {
+        STREAMBUF_T     buf(fd);
+        ostream         out(&buf);
+
+        if ("whole" == mode)
+        {
+            out << text;
+        }
+        else if ("lines" == mode)
+        {
+            for (const auto& line : lines)
+            {
+                out << line << '\n';
+            }// end for line
+        }
+        out.flush();
+    }
+    close(fd);
+    waitpid(pid, nullptr, 0);
+
+    secs = duration<double>(steady_clock::now() - start).count();
+    cout << setw(10) << name << setw(10) << mode
+        << setw(14) << fixed << setprecision(1)
+        << (text.size() / secs / (1 << 20)) << endl;
+}// end run
+
+// === run_writev =========================================================
+//
+// As run, handing all lines (and their newlines) to ofdstream::writev at
+// once.
+//
+// ========================================================================
+void run_writev(const string& text, const std::vector<string>& lines)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    static const char           newline     = '\n';
+    pid_t                       pid;
+    steady_clock::time_point    start;
+    vector<struct iovec>        chunks      = {};
+    double                      secs;
+
+    for (const auto& line : lines)
+    {
+        chunks.push_back({ (void*)(line.data()), line.size() });
+        chunks.push_back({ (void*)(&newline), 1 });
+    }// end for line
+
+    start = steady_clock::now();
+
+    {
+        ofdstream       out(open_cat(pid));
+
+        out.writev(chunks.data(), chunks.size());
+        out.close();
+    }
+    waitpid(pid, nullptr, 0);
+
+    secs = duration<double>(steady_clock::now() - start).count();
+    cout << setw(10) << "fdstream" << setw(10) << "writev"
+        << setw(14) << fixed << setprecision(1)
+        << (text.size() / secs / (1 << 20)) << endl;
+}// end run_writev
+
+// === main ===============================================================
+//
+// Measures piping the text of a large page to cat, as exec_shell and
+// mailcap handlers do, through fdstream_streambuf and through the
+// previous implementation.
+//
+// Usage: bench_ofdstream.out [paragraphs (default: 20000)]
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const size_t            nParas      = (argc > 1) ? atol(argv[1]) : 20000;
+    const Document::Config  cfg         = { { 40, 0, SIZE_MAX } };
+    std::stringstream       html;
+    string                  text;
+    vector<string>          lines       = {};
+
+    html << "<html><body>";
+    for (size_t i = 0; i < nParas; ++i)
+    {
+        html << "<p>Paragraph " << i << ": the quick brown fox jumps over "
+            "the lazy dog, <a href=\"/" << i << "\">again</a> and again.</p>";
+    }// end for i
+    html << "</body></html>";
+
+    text = DocumentHtml(cfg, html, 80).buffer_string();
+    {
+        std::istringstream      ins(text);
+        string                  line;
+
+        while (getline(ins, line))
+        {
+            lines.push_back(line);
+        }// end while
+    }
+
+    cout << "page text: " << text.size() << " bytes, " << lines.size()
+        << " lines" << endl;
+    cout << setw(10) << "impl"
+        << setw(10) << "mode"
+        << setw(14) << "MiB/s" << endl;
+
+    for (const string mode : { "whole", "lines" })
+    {
+        run<legacy_streambuf>("legacy", mode, text, lines);
+        run<fdstream_streambuf>("fdstream", mode, text, lines);
+    }// end for mode
+    run_writev(text, lines);
+
+    return EXIT_SUCCESS;
+}// end int main
@@ -0,0 +1,88 @@
+#!/bin/bash
+
+# Stand-in persistent uri handler, for testing HttpFetcher's coprocess mode
+# (see http_fetcher.hpp for the framing protocol).
+#
+# Serves file:// urls from the local filesystem; anything else is fetched
+# with curl. Every response carries the handler's pid and a running count
+# of the requests it has served, so that reuse can be observed.
+
+export LC_ALL=C
+
+count=0
+
+# write_response <file>: send the contents of <file> as a framed response
+write_response()
+{
+    local size=$(wc -c < "$1")
+
+    if [[ ${size} -gt 0 ]]; then
+        printf '%d\n' "${size}"
+        cat "$1"
+    fi
+    printf '0\n'
+}
+
+tmp=$(mktemp)
+trap 'rm -f "${tmp}"' EXIT
+
+while IFS=' ' read -r magic body_len; do
+    if [[ "${magic}" != "W3M-REQUEST" ]]; then
+        echo "coprocess_handler: bad request header: ${magic}" >&2
+        exit 1
+    fi
+
+    declare -A vars=()
+
+    while IFS= read -r line && [[ -n "${line}" ]]; do
+        vars[${line%%=*}]="${line#*=}"
+    done
+
+    body=""
+    if [[ ${body_len} -gt 0 ]]; then
+        IFS= read -r -N "${body_len}" body
+    fi
+
+    (( ++count ))
+    url="${vars[W3M_URL]}"
+    method="${vars[W3M_REQUEST_METHOD]:-GET}"
+
+    case "${url}" in
+        file://*)
+            path="${url#file://}"
+            {
+                if [[ -r "${path}" ]]; then
+                    printf 'HTTP/1.1 200 OK\r\n'
+                    case "${path}" in
+                        *.html|*.htm)
+                            printf 'content-type: text/html\r\n'
+                            ;;
+                        *)
+                            printf 'content-type: text/plain\r\n'
+                            ;;
+                    esac
+                else
+                    printf 'HTTP/1.1 404 Not Found\r\n'
+                    printf 'content-type: text/plain\r\n'
+                fi
+                printf 'x-w3m-coprocess-pid: %d\r\n' $$
+                printf 'x-w3m-coprocess-requests: %d\r\n' ${count}
+                printf '\r\n'
+                [[ -r "${path}" ]] && cat "${path}"
+            } > "${tmp}"
+            ;;
+        *)
+            printf '%s' "${body}" | curl \
+                --silent \
+                --include \
+                --request "${method}" \
+                ${vars[W3M_IF_NONE_MATCH]:+--header "If-None-Match: ${vars[W3M_IF_NONE_MATCH]}"} \
+                ${vars[W3M_IF_MODIFIED_SINCE]:+--header "If-Modified-Since: ${vars[W3M_IF_MODIFIED_SINCE]}"} \
+                --data-binary @- \
+                --user-agent "${W3M_USER_AGENT}" \
+                "${url}" > "${tmp}"
+            ;;
+    esac
+
+    write_response "${tmp}"
+done
@@ -0,0 +1,88 @@
+#include <iostream>
+
+#include "../deps.hpp"
+#include "../byte_buffer.hpp"
+#include "../document_text.hpp"
+#include "../document_html.hpp"
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const Document::Config  cfg         = { { 40, 0, SIZE_MAX } };
+    const string            text        = "first line\nsecond line\nthird";
+
+    cout << ">== Start Sharing ==<" << endl;
+    {
+        ByteBuffer::container   data(text.cbegin(), text.cend());
+        const char              *storage    = data.data();
+        ByteBuffer              buffer(std::move(data));
+        ByteBuffer              copy        = buffer;
+
+        cout << "\tsize: " << buffer.size()
+            << "; adopted storage: " << (buffer.data() == storage)
+            << "; copy shares storage: " << (copy.data() == storage)
+            << "; contents: \"" << copy.str() << '"' << endl;
+        cout << "\tempty buffer: size " << ByteBuffer().size()
+            << "; empty " << ByteBuffer().empty() << endl;
+    }
+    cout << ">== End Sharing ==<" << endl;
+
+    cout << ">== Start Reader ==<" << endl;
+    {
+        const ByteBuffer        buffer(text);
+        ByteBuffer::Reader      reader(buffer);
+        string                  line;
+        int                     ch;
+
+        while (getline(reader, line))
+        {
+            cout << "\tline: \"" << line << '"' << endl;
+        }// end while
+
+        // putting back the character read succeeds; anything else fails
+        reader.clear();
+        reader.unget();
+        ch = reader.get();
+        cout << "\tunget: " << (char)(ch);
+        reader.putback('#');
+        cout << "; putback other fails: " << reader.fail() << endl;
+
+        // the reader keeps the buffer alive
+        {
+            s_ptr<ByteBuffer::Reader>   orphan  = nullptr;
+
+            {
+                const ByteBuffer    temp(string("temporary"));
+
+                orphan.reset(new ByteBuffer::Reader(temp));
+            }
+            getline(*orphan, line);
+            cout << "\torphaned reader: \"" << line << '"' << endl;
+        }
+    }
+    cout << ">== End Reader ==<" << endl;
+
+    cout << ">== Start Documents ==<" << endl;
+    {
+        const ByteBuffer    buffer(text);
+        const ByteBuffer    html(
+                                string("<html><head><title>Shared</title>")
+                                + "</head><body><p>Hello</p></body></html>"
+                            );
+        DocumentText        textDoc(cfg, buffer, 80);
+        DocumentHtml        htmlDoc(cfg, html, 80);
+
+        cout << "\ttext lines: " << textDoc.buffer().size() << endl;
+        textDoc.redraw(5);
+        cout << "\ttext lines at 5 columns: " << textDoc.buffer().size()
+            << endl;
+        cout << "\thtml title: " << htmlDoc.title() << endl;
+    }
+    cout << ">== End Documents ==<" << endl;
+
+    return EXIT_SUCCESS;
+}// end int main
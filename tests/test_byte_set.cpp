@@ -0,0 +1,101 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "../deps.hpp"
+#include "../byte_set.hpp"
+
+typedef ByteSet::Kernel         Kernel;
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const Kernel    kernels[]   = {
+        Kernel::scalar,
+        Kernel::sse2,
+        Kernel::avx2,
+    };
+    const char      *sets[]     = {
+        "<",
+        "&;",
+        " \t\r\n<>/",
+        "abcdefghijklmnop",
+        "abcdefghijklmnopq",
+        "",
+    };
+    const Kernel    best        = ByteSet::kernel();
+    string          data        = "";
+
+    srand(7);
+    for (size_t i = 0; i < 4096; ++i)
+    {
+        // mostly bytes outside every set, including high (signed) bytes
+        data += (rand() % 64) ? char('r' + rand() % 8) : char(rand() % 256);
+    }// end for i
+
+    cout << ">== Start Sets ==<" << endl;
+    for (size_t i = 0; i < sizeof(sets) / sizeof(*sets); ++i)
+    {
+        const ByteSet   set(sets[i]);
+
+        cout << "\tset " << i << ": size=" << set.size()
+            << "; contains '<'=" << set.contains('<')
+            << "; contains 'a'=" << set.contains('a') << endl;
+    }// end for i
+    cout << ">== End Sets ==<" << endl;
+
+    // every kernel finds the same byte as the scalar one, from every start
+    // and end offset (covering all alignments and tails)
+    cout << ">== Start Kernels ==<" << endl;
+    for (const Kernel kernel : kernels)
+    {
+        size_t      mismatches      = 0;
+
+        if (not ByteSet::set_kernel(kernel))
+        {
+            cout << '\t' << ByteSet::kernel_name(kernel) << ": unsupported"
+                << endl;
+            continue;
+        }
+
+        for (const char *bytes : sets)
+        {
+            const ByteSet   set(bytes);
+
+            for (size_t beg = 0; beg < 70; ++beg)
+            {
+                for (size_t len = 0; len < 200; ++len)
+                {
+                    const char  *begin      = data.data() + beg;
+                    const char  *end        = begin + len;
+                    const char  *expected   = begin;
+
+                    while (expected != end and not set.contains(*expected))
+                    {
+                        ++expected;
+                    }// end while
+
+                    mismatches += (set.find_first(begin, end) != expected);
+                }// end for len
+            }// end for beg
+        }// end for bytes
+
+        cout << '\t' << ByteSet::kernel_name(kernel) << ": mismatches="
+            << mismatches << endl;
+    }// end for kernel
+    ByteSet::set_kernel(best);
+    cout << ">== End Kernels ==<" << endl;
+
+    cout << ">== Start Default Kernel ==<" << endl;
+    cout << "\tbest supported: " << ByteSet::supported(best) << endl;
+    cout << "\twidest: " << (
+            (best == Kernel::avx2)
+            or (not ByteSet::supported(Kernel::avx2))
+        ) << endl;
+    cout << ">== End Default Kernel ==<" << endl;
+
+    return EXIT_SUCCESS;
+}// end int main
@@ -81,5 +81,28 @@ int main(const int argc, const char **argv)
         cout << "Process exited with status " << cmd.spawn().wait() << endl;
     }
 
+    // test full-duplex communication (input larger than the pipe buffers)
+    {
+        const string        cmdName     = "cat; echo done >&2";
+        auto                sproc       = Command(cmdName, true, true, true)
+                                            .spawn();
+        string              input(0x100000, 'x');
+        vector<char>        out         = {};
+        vector<char>        err         = {};
+
+        cout << "Testing command \"" << cmdName << "\" (communicate)..."
+            << endl;
+
+        sproc.communicate(input.data(), input.size(), &out, &err);
+
+        cout << "\tsent " << input.size() << " bytes, received "
+            << out.size() << " bytes on stdout" << endl;
+        cout << "\tstdout matches input: "
+            << (string(out.cbegin(), out.cend()) == input ? "yes" : "no")
+            << endl;
+        cout << "\tstderr: " << string(err.cbegin(), err.cend());
+        cout << "Process exited with status " << sproc.wait() << endl;
+    }
+
     return EXIT_SUCCESS;
 }// end main
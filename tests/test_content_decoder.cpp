@@ -0,0 +1,241 @@
+#include <ctime>
+#include <fstream>
+#include <iostream>
+
+#include <unistd.h>
+#include <zlib.h>
+
+#include "../deps.hpp"
+#include "../uri.hpp"
+#include "../http_fetcher.hpp"
+#include "../http_cache.hpp"
+#include "../content_decoder.hpp"
+
+// === compress ===========================================================
+//
+// Compresses <text> in the format selected by <windowBits>, as for
+// deflateInit2: 15 for zlib, -15 for raw deflate, 15 + 16 for gzip.
+//
+// ========================================================================
+std::vector<char> compress(const string& text, int windowBits)
+{
+    std::vector<char>   out(compressBound(text.size()) + 32);
+    z_stream            stream  = {};
+
+    deflateInit2(
+        &stream,
+        Z_BEST_COMPRESSION,
+        Z_DEFLATED,
+        windowBits,
+        8,
+        Z_DEFAULT_STRATEGY
+    );
+    stream.next_in = (Bytef*)(text.data());
+    stream.avail_in = text.size();
+    stream.next_out = (Bytef*)(out.data());
+    stream.avail_out = out.size();
+    deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return out;
+}// end compress
+
+// === decode =============================================================
+//
+// Decodes <data>, fed to a decoder <step> bytes at a time; prints whether
+// the result matches <text>.
+//
+// ========================================================================
+void decode(
+    const string& name,
+    ContentDecoder::Coding coding,
+    const std::vector<char>& data,
+    size_t step,
+    const string& text
+)
+{
+    using namespace std;
+
+    ContentDecoder      decoder(coding);
+    vector<char>        out     = {};
+    bool                ok      = true;
+
+    for (size_t i = 0; i < data.size(); i += step)
+    {
+        ok = decoder.decode(
+            data.data() + i,
+            min(step, data.size() - i),
+            out
+        ) and ok;
+    }// end for i
+
+    cout << '\t' << name << " (" << step << "-byte pieces): "
+        << data.size() << " -> " << out.size() << " bytes; ok " << ok
+        << "; matches " << (string(out.cbegin(), out.cend()) == text)
+        << endl;
+}// end decode
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    typedef ContentDecoder::Coding      Coding;
+
+    string          text        = "";
+
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        text += "<p>line " + to_string(i) + ": the quick brown fox</p>\n";
+    }// end for i
+
+    cout << ">== Start Decode ==<" << endl;
+    {
+        const auto      gzip        = compress(text, 15 + 16);
+        const auto      zlib        = compress(text, 15);
+        const auto      raw         = compress(text, -15);
+
+        for (size_t step : { (size_t)(1), (size_t)(4096), gzip.size() })
+        {
+            decode("gzip", Coding::gzip, gzip, step, text);
+        }// end for step
+        decode("deflate (zlib)", Coding::deflate, zlib, 1, text);
+        decode("deflate (zlib)", Coding::deflate, zlib, zlib.size(), text);
+        decode("deflate (raw)", Coding::deflate, raw, 1, text);
+        decode("deflate (raw)", Coding::deflate, raw, raw.size(), text);
+
+        // concatenated gzip members
+        {
+            auto        twice       = gzip;
+
+            twice.insert(twice.end(), gzip.cbegin(), gzip.cend());
+            decode("gzip x 2", Coding::gzip, twice, 1000, text + text);
+        }
+
+        // corrupt data
+        {
+            auto        corrupt     = gzip;
+
+            corrupt[corrupt.size() / 2] ^= 0x55;
+            decode("corrupt gzip", Coding::gzip, corrupt, 4096, text);
+        }
+    }
+    cout << ">== End Decode ==<" << endl;
+
+    cout << ">== Start Parse ==<" << endl;
+    for (const string value : { "gzip", " GZIP ", "x-gzip", "deflate",
+        "identity", "", "br", "gzip, br" })
+    {
+        cout << "\t\"" << value << "\": "
+            << (int)(ContentDecoder::parse_coding(value)) << endl;
+    }// end for value
+    cout << ">== End Parse ==<" << endl;
+
+    cout << ">== Start Transfer ==<" << endl;
+    {
+        const string    fname       = "/tmp/w3m_test_content_decoder."
+                                        + to_string(getpid());
+        HttpFetcher     fetcher(
+                            "printf 'content-type: text/html\\n"
+                            "cache-control: max-age=60\\n"
+                            "content-length: %s\\n"
+                            "content-encoding: %s\\n\\n' "
+                            "\"$(wc -c < \"${FILE}\")\" \"${ENCODING}\"; "
+                            "cat \"${FILE}\"",
+                            "W3M_URL"
+                        );
+
+        {
+            const auto      gzip        = compress(text, 15 + 16);
+            ofstream        file(fname);
+
+            file.write(gzip.data(), gzip.size());
+        }
+
+        for (const string encoding : { "gzip", "br" })
+        {
+            auto        transfer    = fetcher.start_fetch(
+                                        Uri("file:///dev/null"),
+                                        {},
+                                        {
+                                            { "ENCODING", encoding },
+                                            { "FILE", fname },
+                                        }
+                                    );
+
+            transfer->wait();
+            cout << '\t' << encoding << ": received "
+                << (transfer->bytes_received() > 0)
+                << "; body " << transfer->body().size()
+                << " bytes; decoded "
+                << (string(
+                        transfer->body().cbegin(),
+                        transfer->body().cend()
+                    ) == text)
+                << "; content-encoding kept "
+                << transfer->headers().count("content-encoding")
+                << "; content-length kept "
+                << transfer->headers().count("content-length") << endl;
+        }// end for encoding
+
+        unlink(fname.c_str());
+    }
+    cout << ">== End Transfer ==<" << endl;
+
+    // a decoded response can be stored in the cache: its headers don't
+    // give the encoded length, which would make it look truncated
+    cout << ">== Start Cache ==<" << endl;
+    {
+        const string    fname       = "/tmp/w3m_test_content_decoder."
+                                        + to_string(getpid());
+        const string    dir         = fname + ".cache";
+        const Uri       url         = "http://example.com/gzip";
+        HttpCache       cache({ dir, 1 << 20 });
+        HttpFetcher     fetcher(
+                            "printf 'HTTP/1.1 200 OK\\n"
+                            "content-type: text/html\\n"
+                            "cache-control: max-age=60\\n"
+                            "content-length: %s\\n"
+                            "content-encoding: gzip\\n\\n' "
+                            "\"$(wc -c < \"${FILE}\")\"; "
+                            "cat \"${FILE}\"",
+                            "W3M_URL"
+                        );
+        HttpCache::Entry    entry;
+
+        {
+            const auto      gzip        = compress(text, 15 + 16);
+            ofstream        file(fname);
+
+            file.write(gzip.data(), gzip.size());
+        }
+
+        auto            transfer    = fetcher.start_fetch(
+                                        url,
+                                        {},
+                                        { { "FILE", fname } }
+                                    );
+
+        transfer->wait();
+        cout << "\tstored: " << cache.store(
+                url,
+                transfer->status(),
+                transfer->headers(),
+                transfer->body()
+            ) << endl;
+        cout << "\tfound: " << cache.lookup(url, entry)
+            << "; fresh: " << HttpCache::is_fresh(entry, time(nullptr))
+            << "; decoded: "
+            << (string(entry.body.cbegin(), entry.body.cend()) == text)
+            << endl;
+
+        unlink(fname.c_str());
+        system(("rm -rf '" + dir + "'").c_str());
+    }
+    cout << ">== End Cache ==<" << endl;
+
+    return EXIT_SUCCESS;
+}// end int main
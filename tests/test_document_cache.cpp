@@ -0,0 +1,122 @@
+#include <ctime>
+#include <iostream>
+
+#include "../deps.hpp"
+#include "../uri.hpp"
+#include "../http_fetcher.hpp"
+#include "../document_text.hpp"
+#include "../document_cache.hpp"
+
+// === doc_text ===========================================================
+//
+// Returns the text of a document's buffer.
+//
+// ========================================================================
+string doc_text(const Document& doc)
+{
+    string      out     = "";
+
+    for (const auto& line : doc.buffer())
+    {
+        for (const auto& node : line)
+        {
+            out.append(node.text().cbegin(), node.text().cend());
+        }// end for node
+    }// end for line
+
+    return out;
+}// end doc_text
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const Document::Config  docCfg  = {};
+    const time_t            now     = time(nullptr);
+    DocumentCache           cache({ 300, 60 });
+
+    // budget is 300 bytes; each document weighs 100
+    for (int i = 0; i < 4; ++i)
+    {
+        const string        text    = "page " + to_string(i) + "\n";
+        s_ptr<Document>     doc(new DocumentText(docCfg, text, 80));
+
+        cache.insert("http://example.com/" + to_string(i), 80, doc, 100, {});
+
+        // keep page 0 recently used
+        cache.find("http://example.com/0", 80, now);
+    }// end for i
+
+    cout << "cached: " << cache.count() << " documents, " << cache.size()
+        << " bytes" << endl;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        const auto      doc     = cache.find(
+                                    "http://EXAMPLE.com/" + to_string(i)
+                                        + "#frag",
+                                    80,
+                                    now
+                                );
+
+        cout << "\tpage " << i << ": "
+            << (doc ? doc_text(*doc) : "(evicted)") << endl;
+    }// end for i
+
+    cout << "different width: "
+        << (cache.find("http://example.com/3", 40, now) ? "hit" : "miss")
+        << endl;
+    cout << "after lifetime: "
+        << (cache.find("http://example.com/3", 80, now + 120) ? "hit" : "miss")
+        << endl;
+
+    {
+        const auto      doc     = cache.find("http://example.com/1", 80, now);
+
+        cache.erase(doc.get());
+        cout << "after erase: "
+            << (cache.find("http://example.com/1", 80, now) ? "hit" : "miss")
+            << "; " << cache.count() << " documents" << endl;
+    }
+
+    // freshness given by the response is kept, not extended to the
+    // cache's lifetime; responses that mustn't be reused aren't cached
+    cout << "freshness:" << endl;
+    for (
+        const auto& test : vector<pair<string,HttpFetcher::header_type>>{
+            { "max-age=3600", { { "cache-control", "max-age=3600" } } },
+            { "max-age=10", { { "cache-control", "max-age=10" } } },
+            { "max-age=0", { { "cache-control", "max-age=0" } } },
+            { "no-cache", { { "cache-control", "no-cache" } } },
+            { "no-store", { { "cache-control", "no-store" } } },
+            { "past expires",
+                { { "expires", "Sun, 06 Nov 1994 08:49:37 GMT" } } },
+        }
+    )
+    {
+        const string        url     = "http://example.com/" + test.first;
+        s_ptr<Document>     doc(new DocumentText(docCfg, "x\n", 80));
+        DocumentCache       fresh({ 300, 60 });
+
+        fresh.insert(url, 80, doc, 100, test.second);
+        cout << "\t" << test.first << ": "
+            << (fresh.find(url, 80, now) ? "hit" : "miss") << "; after 30s: "
+            << (fresh.find(url, 80, now + 30) ? "hit" : "miss")
+            << "; after 120s: "
+            << (fresh.find(url, 80, now + 120) ? "hit" : "miss") << endl;
+    }// end for test
+
+    // a copy shares nothing that editing could change
+    {
+        s_ptr<Document>     doc(new DocumentText(docCfg, "copied\n", 80));
+        const auto          copy    = doc->clone(40);
+
+        cout << "clone: " << (copy != doc) << "; " << doc_text(*copy)
+            << endl;
+    }
+
+    return EXIT_SUCCESS;
+}// end int main
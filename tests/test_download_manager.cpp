@@ -0,0 +1,236 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <unistd.h>
+
+#include "../deps.hpp"
+#include "../uri.hpp"
+#include "../http_fetcher.hpp"
+#include "../fetch_scheduler.hpp"
+#include "../download_manager.hpp"
+
+// === read_file ==========================================================
+//
+// ========================================================================
+string read_file(const string& path)
+{
+    std::ifstream       file(path, std::ios::binary);
+    std::stringstream   contents;
+
+    contents << file.rdbuf();
+
+    return contents.str();
+}// end read_file
+
+// === run_until ==========================================================
+//
+// Drives downloads until a condition holds, or the download is no longer
+// in progress.
+//
+// ========================================================================
+template <class PRED_T>
+void run_until(
+    DownloadManager& downloads,
+    FetchScheduler& scheduler,
+    size_t id,
+    PRED_T pred
+)
+{
+    while (downloads.find(id)->active() and (not pred(*downloads.find(id))))
+    {
+        scheduler.update();
+        downloads.update(scheduler);
+        usleep(1000);
+    }// end while
+}// end run_until
+
+// === print_download =====================================================
+//
+// ========================================================================
+void print_download(
+    const DownloadManager& downloads,
+    size_t id,
+    const string& expected
+)
+{
+    const auto      *dl     = downloads.find(id);
+
+    std::cout << "\t[" << id << "] "
+        << DownloadManager::state_name(dl->state)
+        << "; bytes=" << dl->bytes
+        << "; total=" << dl->total
+        << "; resumable=" << dl->resumable
+        << "; error=" << dl->error
+        << "; matches=" << (read_file(dl->path) == expected)
+        << std::endl;
+}// end print_download
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const string    src         = "/tmp/w3m-test-download-manager.src";
+    const string    dst         = "/tmp/w3m-test-download-manager.dst";
+    const size_t    half        = 0x10000;
+    string          contents    = "";
+
+    // the handler sends the first half, then stalls, unless asked for a
+    // range; "/moved" redirects to the file, "/missing" isn't found
+    const string    handler     =
+        "path=\"${W3M_URL#file://}\"; "
+        "case \"${path}\" in "
+        "*/moved) printf 'HTTP/1.1 302 Found\\nlocation: %s\\n\\n' "
+            "\"${path%/moved}\"; exit;; "
+        "*/missing) printf 'HTTP/1.1 404 Not Found\\n\\n'; exit;; "
+        "esac; "
+        "size=$(stat -c %s \"${path}\"); "
+        "if [ -n \"${RANGES}\" ] && [ -n \"${W3M_RANGE}\" ]; then "
+            "start=${W3M_RANGE#bytes=}; start=${start%-}; "
+            "printf 'HTTP/1.1 206 Partial Content\\n'; "
+            "printf 'content-range: bytes %d-%d/%d\\n' "
+                "${start} $((size - 1)) ${size}; "
+            "printf 'content-length: %d\\n\\n' $((size - start)); "
+            "tail -c +$((start + 1)) \"${path}\"; "
+        "else "
+            "printf 'HTTP/1.1 200 OK\\n'; "
+            "[ -n \"${RANGES}\" ] && printf 'accept-ranges: bytes\\n'; "
+            "printf 'content-length: %d\\n\\n' ${size}; "
+            "head -c " + to_string(half) + " \"${path}\"; "
+            "[ -z \"${STALL}\" ] || sleep 5; "
+            "tail -c +" + to_string(half + 1) + " \"${path}\"; "
+        "fi";
+    HttpFetcher     ranged(handler, "W3M_URL", { { "RANGES", "1" } });
+    HttpFetcher     stalling(
+                        handler,
+                        "W3M_URL",
+                        { { "RANGES", "1" }, { "STALL", "1" } }
+                    );
+    HttpFetcher     plain(handler, "W3M_URL", { { "STALL", "1" } });
+    FetchScheduler  scheduler({ 4, 4 });
+    DownloadManager downloads;
+
+    for (size_t i = 0; i < 3 * half; ++i)
+    {
+        contents += 'a' + (i % 26);
+    }// end for i
+    ofstream(src, ios::binary) << contents;
+
+    cout << ">== Start Complete ==<" << endl;
+    {
+        const size_t    id  = downloads.add(
+                                scheduler,
+                                ranged,
+                                "file://" + src,
+                                dst
+                            );
+
+        run_until(downloads, scheduler, id, [](const auto&) { return false; });
+        print_download(downloads, id, contents);
+    }
+    cout << ">== End Complete ==<" << endl;
+
+    // a paused download picks up where it left off
+    cout << ">== Start Pause/Resume ==<" << endl;
+    {
+        const size_t    id  = downloads.add(
+                                scheduler,
+                                stalling,
+                                "file://" + src,
+                                dst
+                            );
+
+        run_until(
+            downloads, scheduler, id,
+            [half](const auto& dl) { return dl.bytes >= half; }
+        );
+        cout << "\tpaused: " << downloads.pause(id) << endl;
+        print_download(downloads, id, contents.substr(0, half));
+        cout << "\tresumed: " << downloads.resume(scheduler, id) << endl;
+        run_until(downloads, scheduler, id, [](const auto&) { return false; });
+        print_download(downloads, id, contents);
+        cout << "\tresume when done: " << downloads.resume(scheduler, id)
+            << endl;
+    }
+    cout << ">== End Pause/Resume ==<" << endl;
+
+    // without range support, a resumed download starts over
+    cout << ">== Start Restart ==<" << endl;
+    {
+        const size_t    id  = downloads.add(
+                                scheduler,
+                                plain,
+                                "file://" + src,
+                                dst
+                            );
+
+        run_until(
+            downloads, scheduler, id,
+            [half](const auto& dl) { return dl.bytes >= half; }
+        );
+        downloads.pause(id);
+        print_download(downloads, id, contents.substr(0, half));
+        downloads.resume(scheduler, id);
+        cout << "\trestarted from: " << downloads.find(id)->bytes << endl;
+        run_until(
+            downloads, scheduler, id,
+            [half](const auto& dl) { return dl.bytes >= half; }
+        );
+        print_download(downloads, id, contents.substr(0, half));
+        downloads.remove(id);
+        cout << "\tremoved: " << (not downloads.find(id)) << endl;
+    }
+    cout << ">== End Restart ==<" << endl;
+
+    cout << ">== Start Redirect/Failure ==<" << endl;
+    {
+        const size_t    moved   = downloads.add(
+                                    scheduler,
+                                    ranged,
+                                    "file://" + src + "/moved",
+                                    dst
+                                );
+        // what is already at the destination outlives a failed request
+        ofstream(dst + ".missing", ios::binary) << "kept";
+
+        const size_t    missing = downloads.add(
+                                    scheduler,
+                                    plain,
+                                    "file://" + src + "/missing",
+                                    dst + ".missing"
+                                );
+
+        cout << "\trunning: " << downloads.running() << endl;
+        for (const size_t id : { moved, missing })
+        {
+            run_until(
+                downloads, scheduler, id,
+                [](const auto&) { return false; }
+            );
+        }// end for id
+        print_download(downloads, moved, contents);
+        print_download(downloads, missing, "kept");
+        cout << "\turl: " << downloads.find(moved)->url.str() << endl;
+        cout << "\trunning: " << downloads.running() << endl;
+    }
+    cout << ">== End Redirect/Failure ==<" << endl;
+
+    cout << ">== Start List ==<" << endl;
+    cout << downloads.format_list(DownloadManager::clock_type::now());
+    for (const double size : { 0.0, 1023.0, 1536.0, 5.0 * (1 << 30) })
+    {
+        cout << '\t' << size << ": " << DownloadManager::format_size(size)
+            << endl;
+    }// end for size
+    cout << ">== End List ==<" << endl;
+
+    remove(src.c_str());
+    remove(dst.c_str());
+    remove((dst + ".missing").c_str());
+
+    return EXIT_SUCCESS;
+}// end int main
@@ -0,0 +1,231 @@
+#include <iostream>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+
+#include "../deps.hpp"
+#include "../fdstream.hpp"
+
+// === char_at ============================================================
+//
+// Returns the character at a given offset of the test stream: lines of 99
+// letters, each followed by a newline.
+//
+// ========================================================================
+char char_at(size_t pos)
+{
+    return (99 == pos % 100) ? '\n' : ('a' + pos % 26);
+}// end char_at
+
+// === open_stream ========================================================
+//
+// Returns the read end of a pipe, fed <len> bytes of the test stream by a
+// child process.
+//
+// ========================================================================
+int open_stream(size_t len)
+{
+    int         fds[2];
+
+    if (pipe(fds))
+    {
+        perror("pipe");
+        exit(EXIT_FAILURE);
+    }
+
+    if (0 == fork())
+    {
+        std::vector<char>   data(len);
+
+        close(fds[0]);
+        for (size_t i = 0; i < len; ++i)
+        {
+            data[i] = char_at(i);
+        }// end for i
+        for (size_t nSent = 0; nSent < len;)
+        {
+            const ssize_t   nWritten    = write(
+                                            fds[1],
+                                            data.data() + nSent,
+                                            len - nSent
+                                        );
+
+            if (nWritten <= 0)
+            {
+                _exit(EXIT_FAILURE);
+            }
+            nSent += nWritten;
+        }// end for nSent
+        _exit(EXIT_SUCCESS);
+    }
+
+    close(fds[1]);
+    return fds[0];
+}// end open_stream
+
+// === open_sink ==========================================================
+//
+// Returns the write end of a pipe, read by a child process that checks
+// that what it receives is the test stream, then reports how much of it
+// arrived.
+//
+// ========================================================================
+int open_sink(void)
+{
+    int         fds[2];
+
+    if (pipe(fds))
+    {
+        perror("pipe");
+        exit(EXIT_FAILURE);
+    }
+
+    if (0 == fork())
+    {
+        char        buf[0x1000];
+        size_t      pos         = 0;
+        bool        match       = true;
+        ssize_t     nRead;
+
+        close(fds[1]);
+        while ((nRead = read(fds[0], buf, sizeof(buf))) > 0)
+        {
+            for (ssize_t i = 0; i < nRead; ++i)
+            {
+                match = match and (buf[i] == char_at(pos++));
+            }// end for i
+        }// end while
+
+        std::cout << "\treceived: " << pos << " bytes; contents match: "
+            << (match ? "yes" : "no") << std::endl;
+        _exit(EXIT_SUCCESS);
+    }
+
+    close(fds[0]);
+    return fds[1];
+}// end open_sink
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const size_t    len     = 1000000;
+
+    cout << ">== Start Getline ==<" << endl;
+    {
+        ifdstream       stream(open_stream(len));
+        string          line;
+        size_t          nLines  = 0;
+        size_t          pos     = 0;
+        bool            match   = true;
+
+        while (getline(stream, line))
+        {
+            for (char ch : line)
+            {
+                match = match and (ch == char_at(pos++));
+            }// end for ch
+            ++pos;
+            ++nLines;
+        }// end for line
+
+        cout << "\tlines: " << nLines << "; bytes: " << pos
+            << "; contents match: " << (match ? "yes" : "no") << endl;
+        stream.close();
+        wait(nullptr);
+    }
+    cout << ">== End Getline ==<" << endl;
+
+    cout << ">== Start Putback ==<" << endl;
+    {
+        ifdstream       stream(open_stream(len));
+        vector<char>    buf(0x10000 - 0x10);
+        size_t          pos     = 0;
+        int             ch;
+
+        // consume exactly one buffer's worth, then force a refill
+        stream.read(buf.data(), buf.size());
+        pos += stream.gcount();
+        ch = stream.get();
+        ++pos;
+        cout << "\tacross refill: got " << (ch == char_at(pos - 1))
+            << "; unget " << (stream.unget() and stream.unget() ? 1 : 0);
+        pos -= 2;
+        ch = stream.get();
+        cout << "; next " << (ch == char_at(pos++)) << endl;
+
+        // put back a different character
+        stream.putback('#');
+        cout << "\tputback other: " << (char)(stream.get()) << endl;
+
+        // large reads bypass the buffer, but still allow putback
+        buf.resize(300000);
+        stream.read(buf.data(), buf.size());
+        pos += stream.gcount();
+        cout << "\tafter large read: " << stream.gcount() << " bytes";
+        stream.unget();
+        cout << "; unget " << (stream.get() == char_at(pos - 1)) << endl;
+
+        // putback still works at end of stream
+        stream.ignore(len);
+        stream.clear();
+        stream.unget();
+        cout << "\tat end: unget " << (stream.get() == char_at(len - 1))
+            << "; then eof " << (stream.get() == EOF) << endl;
+        stream.close();
+        wait(nullptr);
+    }
+    cout << ">== End Putback ==<" << endl;
+
+    cout << ">== Start Output ==<" << endl;
+    {
+        ofdstream       stream(open_sink());
+        size_t          pos     = 0;
+        string          data    = "";
+
+        for (size_t i = 0; i < len; ++i)
+        {
+            data.push_back(char_at(i));
+        }// end for i
+
+        // single characters and small writes are buffered
+        while (pos < 1000)
+        {
+            stream.put(data.at(pos++));
+        }// end while
+        stream << data.substr(pos, 1000);
+        pos += 1000;
+
+        // large writes go out at once, after what was buffered
+        stream.write(data.data() + pos, 200000);
+        pos += 200000;
+
+        // gathered chunks
+        {
+            struct iovec    chunks[3];
+
+            for (auto& chunk : chunks)
+            {
+                chunk = { &data.at(pos), 5000 };
+                pos += 5000;
+            }// end for chunk
+            stream.writev(chunks, 3);
+        }
+
+        // a non-blocking descriptor fills up, but nothing is lost
+        fcntl(stream.fd(), F_SETFL, fcntl(stream.fd(), F_GETFL) | O_NONBLOCK);
+        stream.write(data.data() + pos, len - pos);
+
+        cout << "\tstream good: " << (stream.good() ? "yes" : "no") << endl;
+        stream.close();
+        wait(nullptr);
+    }
+    cout << ">== End Output ==<" << endl;
+
+    return EXIT_SUCCESS;
+}// end int main
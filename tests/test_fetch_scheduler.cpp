@@ -0,0 +1,202 @@
+#include <chrono>
+#include <iostream>
+#include <map>
+
+#include "../deps.hpp"
+#include "../uri.hpp"
+#include "../http_fetcher.hpp"
+#include "../fetch_scheduler.hpp"
+
+typedef FetchScheduler::Priority            Priority;
+typedef std::map<string,FetchScheduler::job_pointer>
+                                            job_map;
+
+// === run_rounds =========================================================
+//
+// Starts as many jobs as the scheduler allows, waits for all of them to
+// finish, and repeats until no jobs are left; prints the jobs started in
+// each round.
+//
+// ========================================================================
+void run_rounds(FetchScheduler& scheduler, job_map& jobs)
+{
+    using namespace std;
+
+    int     round   = 0;
+
+    while (scheduler.queued())
+    {
+        scheduler.update();
+
+        cout << "\tround " << ++round << ":";
+        for (auto& kv : jobs)
+        {
+            auto&       job     = kv.second;
+
+            if (job and job->started())
+            {
+                cout << ' ' << kv.first;
+                job->transfer->wait();
+                job = nullptr;
+            }
+        }// end for kv
+        cout << endl;
+    }// end while
+}// end run_rounds
+
+// === block ==============================================================
+//
+// Fills a scheduler's slots (one per host) so that jobs submitted next are
+// queued rather than started.
+//
+// ========================================================================
+auto block(FetchScheduler& scheduler, const HttpFetcher& fetcher, int count)
+    -> std::vector<FetchScheduler::job_pointer>
+{
+    std::vector<FetchScheduler::job_pointer>    blockers    = {};
+
+    for (int i = 0; i < count; ++i)
+    {
+        blockers.push_back(scheduler.submit(
+            Priority::navigation,
+            fetcher,
+            "http://blocker" + std::to_string(i) + "/"
+        ));
+    }// end for i
+
+    return blockers;
+}// end block
+
+// === unblock ============================================================
+//
+// ========================================================================
+void unblock(const std::vector<FetchScheduler::job_pointer>& blockers)
+{
+    for (const auto& job : blockers)
+    {
+        job->transfer->wait();
+    }// end for job
+}// end unblock
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    HttpFetcher     fetcher(
+                        "printf 'content-type: text/plain\\n\\n'; "
+                            "echo \"${W3M_URL}\"",
+                        "W3M_URL"
+                    );
+    HttpFetcher     slowFetcher(
+                        "sleep 0.2; printf 'content-type: text/plain\\n\\n'",
+                        "W3M_URL"
+                    );
+
+    cout << ">== Start Fairness ==<" << endl;
+    {
+        // limits: 3 overall, 2 per host
+        FetchScheduler      scheduler({ 3, 2 });
+        const auto          blockers    = block(scheduler, fetcher, 3);
+        job_map             jobs        = {};
+
+        for (const auto& req : vector<pair<string,Priority>>{
+            { "a/1 (prefetch)", Priority::prefetch },
+            { "a/2 (prefetch)", Priority::prefetch },
+            { "a/3", Priority::backgroundTab },
+            { "a/4", Priority::backgroundTab },
+            { "a/5", Priority::backgroundTab },
+            { "a/6", Priority::backgroundTab },
+            { "b/1", Priority::backgroundTab },
+            { "b/2", Priority::backgroundTab },
+            { "c/1 (navigation)", Priority::navigation },
+        })
+        {
+            jobs[req.first] = scheduler.submit(
+                req.second,
+                fetcher,
+                "http://" + req.first.substr(0, req.first.find(' '))
+            );
+        }// end for req
+
+        cout << "\tqueued: " << scheduler.queued() << endl;
+        unblock(blockers);
+        run_rounds(scheduler, jobs);
+    }
+    cout << ">== End Fairness ==<" << endl;
+
+    cout << ">== Start Priority ==<" << endl;
+    {
+        FetchScheduler      scheduler({ 1, 1 });
+        const auto          blockers    = block(scheduler, fetcher, 1);
+        job_map             jobs        = {};
+
+        jobs["a/prefetch"] = scheduler.submit(
+            Priority::prefetch, fetcher, "http://a/prefetch"
+        );
+        jobs["b/image"] = scheduler.submit(
+            Priority::image, fetcher, "http://b/image"
+        );
+        jobs["c/tab"] = scheduler.submit(
+            Priority::backgroundTab, fetcher, "http://c/tab"
+        );
+        jobs["d/dropped"] = scheduler.submit(
+            Priority::navigation, fetcher, "http://d/dropped"
+        );
+
+        // an abandoned job is never started; a promoted one goes first
+        jobs.erase("d/dropped");
+        scheduler.promote(jobs["b/image"], Priority::navigation);
+
+        unblock(blockers);
+        run_rounds(scheduler, jobs);
+    }
+    cout << ">== End Priority ==<" << endl;
+
+    cout << ">== Start Concurrency ==<" << endl;
+    {
+        FetchScheduler                      scheduler({ 16, 6 });
+        std::vector<FetchScheduler::job_pointer>
+                                            jobs        = {};
+        const auto                          start       = steady_clock::now();
+        size_t                              elapsed;
+
+        // 20 tabs over 4 hosts, each fetch taking 200ms
+        for (int i = 0; i < 20; ++i)
+        {
+            jobs.push_back(scheduler.submit(
+                Priority::backgroundTab,
+                slowFetcher,
+                "http://host" + to_string(i % 4) + "/" + to_string(i)
+            ));
+        }// end for i
+
+        cout << "\trunning: " << scheduler.running()
+            << "; queued: " << scheduler.queued() << endl;
+
+        while (scheduler.running() or scheduler.queued())
+        {
+            for (auto& job : jobs)
+            {
+                if (job->transfer)
+                {
+                    job->transfer->update();
+                }
+            }// end for job
+            scheduler.update();
+        }// end while
+
+        elapsed = duration_cast<milliseconds>(steady_clock::now() - start)
+            .count();
+        // one after another, they would take 4000ms
+        cout << "\tfetched side by side: "
+            << (elapsed < 2000 ? "yes" : "no") << endl;
+        cerr << "\telapsed: " << elapsed << "ms" << endl;
+    }
+    cout << ">== End Concurrency ==<" << endl;
+
+    return EXIT_SUCCESS;
+}// end int main
@@ -0,0 +1,102 @@
+#include <iostream>
+
+#include "../deps.hpp"
+#include "../html_atom.hpp"
+#include "../html_attributes.hpp"
+#include "../dom_tree.hpp"
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    size_t          mismatches      = 0;
+
+    cout << ">== Start Intern ==<" << endl;
+    for (
+        const char *name : {
+            "a", "html", "class", "http-equiv", "template", "h6", "wbr",
+            "HTML", "text", "", "frobnicate",
+        }
+    )
+    {
+        const HtmlAtom      atom    = html_atom::intern(name);
+
+        cout << "\t\"" << name << "\": " << size_t(atom) << " -> \""
+            << html_atom::name(atom) << "\"" << endl;
+    }// end for name
+    cout << "\tkeywords: "
+        << (html_atom::intern("class") == HtmlAtom::class_) << ' '
+        << (html_atom::intern("for") == HtmlAtom::for_) << ' '
+        << (html_atom::intern("http-equiv") == HtmlAtom::http_equiv) << endl;
+
+    // every atom is interned from its own name
+    for (size_t i = 1; i < html_atom::COUNT; ++i)
+    {
+        const HtmlAtom      atom    = HtmlAtom(i);
+
+        mismatches += (html_atom::intern(html_atom::name(atom)) != atom);
+    }// end for i
+    cout << "\tround trip mismatches: " << mismatches << endl;
+    cout << ">== End Intern ==<" << endl;
+
+    cout << ">== Start Attributes ==<" << endl;
+    {
+        HtmlAttributes      attrs;
+
+        attrs["title"] = "t";
+        attrs[HtmlAtom::href] = "/x";
+        attrs["data-x"] = "d";
+        attrs["ID"] = "upper";
+        attrs[HtmlAtom::class_] = "c";
+        attrs["href"] = "/y";
+
+        for (const auto& attr : attrs)
+        {
+            cout << "\t" << attr.name << "=\"" << attr.value << "\" (atom "
+                << (attr.atom != HtmlAtom::none) << ")" << endl;
+        }// end for attr
+        cout << "\tsize: " << attrs.size()
+            << "; href: " << attrs.at(HtmlAtom::href)
+            << "; class by name: " << attrs.at("class")
+            << "; data-x: " << attrs.at("data-x")
+            << "; id: " << attrs.count(HtmlAtom::id)
+            << "; ID: " << attrs.count("ID")
+            << "; src: " << (nullptr == attrs.find(HtmlAtom::src)) << endl;
+
+        cout << "\terased: " << attrs.erase(HtmlAtom::href)
+            << attrs.erase("data-x") << attrs.erase("data-x")
+            << "; size: " << attrs.size() << endl;
+
+        try
+        {
+            attrs.at(HtmlAtom::src);
+            cout << "\tfound src" << endl;
+        }
+        catch (const std::out_of_range& e)
+        {
+            cout << "\tERROR: " << e.what() << endl;
+        }
+    }
+    cout << ">== End Attributes ==<" << endl;
+
+    cout << ">== Start Nodes ==<" << endl;
+    {
+        DomTree         dom;
+        DomTree::node&  root    = *dom.reset_root("window");
+        DomTree::node&  body    = root.emplace_child_back("body");
+        DomTree::node&  text    = body.emplace_child_back("text", "x");
+        DomTree         copy    = dom;
+
+        cout << "\troot: " << size_t(root.atom())
+            << "; body: " << (body.atom() == HtmlAtom::body)
+            << "; text: " << size_t(text.atom())
+            << "; copied: "
+            << (copy.root()->child_front().atom() == HtmlAtom::body) << endl;
+    }
+    cout << ">== End Nodes ==<" << endl;
+
+    return mismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+}// end int main
@@ -6,12 +6,13 @@
 //
 // Reads an html document from stdin, parses it into a DomTree using
 // HtmlParserBasic::parse_html, then displays the resulting DOM tree.
+// An optional argument sets the parser's maximum depth.
 //
 // This program should be considered a single unit test, to be called from
 // a testing script.
 //
 // ========================================================================
-int main(void)
+int main(const int argc, const char **argv)
 {
     using namespace std;
 
@@ -19,6 +20,10 @@ int main(void)
     HtmlParserBasic     parser;
     DomTree             dom;
 
+    if (argc > 1)
+    {
+        parser.set_max_depth(atol(argv[1]));
+    }
     dom.reset_root("window");
 
     try
@@ -39,4 +44,4 @@ int main(void)
     cout << dom << endl;
 
     return ret;
-}// end main(void)
+}// end main
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "../deps.hpp"
+#include "../html_push_parser.hpp"
+#include "../html_parser_basic.hpp"
+#include "../dom_tree.hpp"
+
+// === dom_string =========================================================
+//
+// ========================================================================
+auto dom_string(const DomTree& dom)
+    -> string
+{
+    std::ostringstream      out;
+
+    out << dom;
+
+    return out.str();
+}// end dom_string
+
+// === parse_chunked ======================================================
+//
+// Parses <html> into <dom>, fed <chunkSize> bytes at a time.
+//
+// ========================================================================
+void parse_chunked(DomTree& dom, const string& html, size_t chunkSize)
+{
+    HtmlPushParser      parser(*dom.root());
+
+    for (size_t i = 0; i < html.size(); i += chunkSize)
+    {
+        const size_t    len     = std::min(chunkSize, html.size() - i);
+        // copied, so that the parser can't keep pointers into the document
+        const string    chunk   = html.substr(i, len);
+
+        parser.feed(chunk.data(), chunk.size());
+    }// end for i
+    parser.finish();
+}// end parse_chunked
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const string        documents[]     = {
+        "<!DOCTYPE html><html><head><title>T</title></head>"
+            "<body><p class=\"a\">one &amp; two</p>\n<br/><hr>"
+            "<a href='/x' target=_blank>link</a></body></html>",
+        "<div id=outer><ul><li>a<li>b</ul><!-- a <b> comment -->"
+            "<img src=\"i.png\" alt=\"\"></div>stray",
+        "<html><BODY Class=X>"
+            "<script>if (a < b) { x = '</scrip'; }</script>"
+            "<style>p > a { }</style><P>text</p></body></html>",
+        "<table><tr><td>1</td><td>2</td></tr></table></span><b><i>x</b>y",
+        "<form action=/go method = post><input type=text name=q value=>"
+            "<input type=checkbox checked / ></form>",
+        "<p>unterminated <a href=\"x",
+        "<div>x</div><!-- never closed",
+        "<p><script>never closed",
+    };
+    const size_t        chunkSizes[]    = { 1, 2, 3, 7, 64 };
+    HtmlParserBasic     basic;
+
+    // however a document is split, the same tree is built as from the
+    // whole document
+    cout << ">== Start Chunked ==<" << endl;
+    for (const auto& html : documents)
+    {
+        DomTree     whole;
+        string      expected    = "";
+
+        whole.reset_root("window");
+        basic.parse_html(
+            *whole.root(),
+            html.data(),
+            html.data() + html.size()
+        );
+        expected = dom_string(whole);
+
+        cout << "\tnodes: " << whole.size() << "; same:";
+        for (const size_t chunkSize : chunkSizes)
+        {
+            DomTree         chunked;
+
+            chunked.reset_root("window");
+            parse_chunked(chunked, html, chunkSize);
+            cout << ' ' << (dom_string(chunked) == expected);
+        }// end for chunkSize
+        cout << endl;
+    }// end for html
+    cout << ">== End Chunked ==<" << endl;
+
+    // tokens much longer than the chunks they arrive in
+    cout << ">== Start Long Tokens ==<" << endl;
+    {
+        const string    filler(20000, 'x');
+        const string    longDocuments[] = {
+            "<p>" + filler + " > </p>",
+            "<script>" + filler + " a </b> b </scrip </scripts"
+                + " c</script ><p>y</p>",
+            "<!--" + filler + " -> > -- -->" + "<p>y</p>",
+            "<a title=\"" + filler + " > \" href=x>y</a>",
+            "<style>" + filler + "</STYLE",
+        };
+
+        for (const auto& html : longDocuments)
+        {
+            DomTree     whole;
+            string      expected    = "";
+
+            whole.reset_root("window");
+            basic.parse_html(
+                *whole.root(),
+                html.data(),
+                html.data() + html.size()
+            );
+            expected = dom_string(whole);
+
+            cout << "	nodes: " << whole.size() << "; same:";
+            for (const size_t chunkSize : { 1, 16, 4096 })
+            {
+                DomTree         chunked;
+
+                chunked.reset_root("window");
+                parse_chunked(chunked, html, chunkSize);
+                cout << ' ' << (dom_string(chunked) == expected);
+            }// end for chunkSize
+            cout << endl;
+        }// end for html
+    }
+    cout << ">== End Long Tokens ==<" << endl;
+
+    cout << ">== Start Close Order ==<" << endl;
+    {
+        const string    html    = "<html><body><p>a<b>b<br>c</p>"
+                                    "<script>x</script><div><i>d</body>";
+        DomTree         dom;
+        HtmlPushParser  parser(
+            *dom.reset_root("window"),
+            HtmlParserBasic::DEFAULT_MAX_DEPTH,
+            [](const DomTree::node& nd) {
+                cout << "\tclosed <" << nd.identifier() << "> ("
+                    << nd.size() << " nodes)" << endl;
+            }
+        );
+
+        parser.feed(html.data(), html.size());
+        cout << "\t-- finish" << endl;
+        parser.finish();
+    }
+    cout << ">== End Close Order ==<" << endl;
+
+    cout << ">== Start Pending ==<" << endl;
+    {
+        DomTree         dom;
+        HtmlPushParser  parser(*dom.reset_root("window"));
+
+        for (
+            const string chunk : {
+                "<p>one", " two</p><a hr", "ef=x>y</a", "><!-- c", " -->",
+            }
+        )
+        {
+            parser.feed(chunk.data(), chunk.size());
+            cout << "\tfed: " << parser.bytes_fed() << "; pending: "
+                << parser.bytes_pending() << "; nodes: " << dom.size()
+                << endl;
+        }// end for chunk
+        parser.finish();
+        cout << "\tfinished: " << parser.finished() << "; pending: "
+            << parser.bytes_pending() << "; nodes: " << dom.size() << endl;
+
+        try
+        {
+            parser.feed("x", 1);
+            cout << "\tfed after finish" << endl;
+        }
+        catch (const std::logic_error& e)
+        {
+            cout << "\tERROR: " << e.what() << endl;
+        }
+    }
+    cout << ">== End Pending ==<" << endl;
+
+    return EXIT_SUCCESS;
+}// end int main
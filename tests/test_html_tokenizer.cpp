@@ -0,0 +1,171 @@
+#include <iostream>
+#include <sstream>
+
+#include "../deps.hpp"
+#include "../html_tokenizer.hpp"
+#include "../html_parser_basic.hpp"
+#include "../dom_tree.hpp"
+
+typedef HtmlTokenizer::Kind         Kind;
+
+// === kind_name ==========================================================
+//
+// ========================================================================
+auto kind_name(Kind kind)
+    -> const char*
+{
+    switch (kind)
+    {
+        case Kind::eof:
+            return "eof";
+        case Kind::text:
+            return "text";
+        case Kind::start:
+            return "start";
+        case Kind::end:
+            return "end";
+        case Kind::solo:
+            return "solo";
+        case Kind::comment:
+            return "comment";
+        case Kind::version:
+            return "version";
+    }// end switch
+
+    return "?";
+}// end kind_name
+
+// === print_tokens =======================================================
+//
+// ========================================================================
+void print_tokens(const string& html)
+{
+    using namespace std;
+
+    HtmlTokenizer           tokenizer(html.data(), html.data() + html.size());
+    HtmlTokenizer::Token    token;
+
+    while (tokenizer.next(token))
+    {
+        cout << "\t" << kind_name(token.kind);
+        if (not token.name.empty())
+        {
+            cout << " <" << token.name << ">";
+        }
+        for (const auto& attr : token.attributes)
+        {
+            cout << " [" << attr.name << "=" << attr.value << "]";
+        }// end for attr
+        if (not token.text.empty())
+        {
+            cout << " \"" << token.text << "\"";
+        }
+        if (token.name == "script")
+        {
+            HtmlTokenizer::view_type    literal;
+
+            tokenizer.read_literal(token.name, literal);
+            cout << " literal \"" << literal << "\"";
+        }
+        cout << endl;
+    }// end while
+    cout << "\tat end: " << tokenizer.at_end() << "; position: "
+        << tokenizer.position() << endl;
+}// end print_tokens
+
+// === dom_string =========================================================
+//
+// ========================================================================
+auto dom_string(const DomTree& dom)
+    -> string
+{
+    std::ostringstream      out;
+
+    out << dom;
+
+    return out.str();
+}// end dom_string
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const string        documents[]     = {
+        "<!DOCTYPE html><html><head><title>T</title></head>"
+            "<body><p class=\"a\">one &amp; two</p>\n<br/><hr>"
+            "<a href='/x' target=_blank>link</a></body></html>",
+        "<div id=outer><ul><li>a<li>b</ul><!-- comment -->"
+            "<img src=\"i.png\" alt=\"\"></div>stray",
+        "<html><BODY Class=X>"
+            "<script>if (a < b) { x = 1; }</script>"
+            "<style>p > a { }</style><P>text</p></body></html>",
+        "<table><tr><td>1</td><td>2</td></tr></table></span><b><i>x</b>y",
+        "<form action=/go method = post><input type=text name=q value=>"
+            "<input type=checkbox checked / ></form>",
+    };
+    HtmlParserBasic     parser;
+
+    cout << ">== Start Tokens ==<" << endl;
+    print_tokens(
+        "<!DOCTYPE html>text <a HREF=\"/x\" b='y' c=z d>link</A>"
+            "<br/><!-- a > b -->< p ><?php x ?>"
+            "<script type=text/javascript>a<b && c</scripts></SCRIPT>after"
+    );
+    cout << ">== End Tokens ==<" << endl;
+
+    // parsing in place builds the same tree as parsing from a stream
+    cout << ">== Start Stream Equivalence ==<" << endl;
+    for (const auto& html : documents)
+    {
+        DomTree         fromStream;
+        DomTree         inPlace;
+        istringstream   ins(html);
+
+        fromStream.reset_root("window");
+        inPlace.reset_root("window");
+        parser.parse_html(*fromStream.root(), ins);
+        parser.parse_html(
+            *inPlace.root(),
+            html.data(),
+            html.data() + html.size()
+        );
+
+        cout << "\tnodes: " << inPlace.size() << "; same: "
+            << (dom_string(fromStream) == dom_string(inPlace)) << endl;
+    }// end for html
+    cout << ">== End Stream Equivalence ==<" << endl;
+
+    cout << ">== Start Malformed ==<" << endl;
+    for (
+        const string html : {
+            "<a <b href=x>ok</a>",
+            "<p>unterminated <a href=\"x",
+            "<div>x</div><!-- never closed",
+            "<p>< >",
+        }
+    )
+    {
+        DomTree         dom;
+
+        dom.reset_root("window");
+        try
+        {
+            parser.parse_html(
+                *dom.root(),
+                html.data(),
+                html.data() + html.size()
+            );
+            cout << "\tnodes: " << dom.size() << endl;
+        }
+        catch (const HtmlParser::except_invalid_token& e)
+        {
+            cout << "\tERROR: " << e << endl;
+        }
+    }// end for html
+    cout << ">== End Malformed ==<" << endl;
+
+    return EXIT_SUCCESS;
+}// end int main
@@ -0,0 +1,154 @@
+#include <cstdio>
+#include <cstdlib>
+#include <clocale>
+#include <ctime>
+#include <iostream>
+
+#include <unistd.h>
+
+#include "../deps.hpp"
+#include "../uri.hpp"
+#include "../http_fetcher.hpp"
+#include "../http_cache.hpp"
+
+// === print_lookup =======================================================
+//
+// Looks up a url and prints what was found.
+//
+// ========================================================================
+void print_lookup(HttpCache& cache, const Uri& url, time_t now)
+{
+    using namespace std;
+
+    HttpCache::Entry        entry;
+
+    cout << '\t' << url.str() << ": ";
+    if (not cache.lookup(url, entry))
+    {
+        cout << "miss" << endl;
+        return;
+    }
+
+    cout << "code=" << entry.status.code
+        << "; fresh=" << (HttpCache::is_fresh(entry, now) ? "yes" : "no");
+    for (const auto& kv : HttpCache::revalidation_env(entry))
+    {
+        cout << "; " << kv.first << "=" << kv.second;
+    }// end for kv
+    cout << "; body=" << string(entry.body.cbegin(), entry.body.cend())
+        << endl;
+}// end print_lookup
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const string                dir     = "/tmp/w3m-test-http-cache-"
+                                            + to_string(getpid());
+    HttpCache                   cache({ dir, 0x200 });
+    const HttpFetcher::Status   ok      = { "HTTP/1.1", 200, "OK" };
+    const time_t                now     = time(nullptr);
+    const string                text    = "<p>cached</p>";
+    const HttpFetcher::data_container   body(text.cbegin(), text.cend());
+
+    cout << ">== Start Store ==<" << endl;
+    for (const auto& test : vector<pair<string,HttpFetcher::header_type>>{
+        { "http://Example.COM/max-age#frag",
+            { { "cache-control", "public, max-age=3600" } } },
+        { "http://example.com/no-cache",
+            { { "cache-control", "no-cache" }, { "etag", "\"v1\"" } } },
+        { "http://example.com/expired",
+            {
+                { "expires", "Sun, 06 Nov 1994 08:49:37 GMT" },
+                { "last-modified", "Sat, 05 Nov 1994 08:49:37 GMT" },
+            } },
+        { "http://example.com/no-store",
+            { { "cache-control", "no-store, max-age=60" } } },
+        { "http://example.com/no-validators", {} },
+        { "http://example.com/truncated",
+            {
+                { "cache-control", "max-age=60" },
+                { "content-length", "100" },
+            } },
+    })
+    {
+        cout << '\t' << test.first << ": "
+            << (cache.store(test.first, ok, test.second, body)
+                ? "stored" : "not stored") << endl;
+    }// end for test
+    cout << ">== End Store ==<" << endl;
+
+    cout << ">== Start Lookup ==<" << endl;
+    for (const string url : {
+        "http://example.com/max-age",
+        "http://example.com/no-cache",
+        "http://example.com/expired",
+        "http://example.com/no-store",
+    })
+    {
+        print_lookup(cache, url, now);
+    }// end for url
+    cout << ">== End Lookup ==<" << endl;
+
+    // a "304 Not Modified" with new freshness information
+    cout << ">== Start Refresh ==<" << endl;
+    {
+        const Uri           url     = "http://example.com/expired";
+        HttpCache::Entry    entry;
+
+        cache.lookup(url, entry);
+        cache.refresh(url, entry, {
+            { "cache-control", "max-age=60" },
+            { "content-length", "0" },
+        });
+        print_lookup(cache, url, now);
+    }
+    cout << ">== End Refresh ==<" << endl;
+
+    // budget is 0x200 bytes; storing more entries evicts the least recently
+    // used ones
+    cout << ">== Start Eviction ==<" << endl;
+    for (int i = 0; i < 4; ++i)
+    {
+        const string    url     = "http://example.com/page" + to_string(i);
+
+        cache.store(url, ok, { { "cache-control", "max-age=60" } }, body);
+    }// end for i
+    for (int i = 0; i < 4; ++i)
+    {
+        print_lookup(cache, "http://example.com/page" + to_string(i), now);
+    }// end for i
+    cout << ">== End Eviction ==<" << endl;
+
+    // freshness from Expires, whatever the locale (names are English)
+    cout << ">== Start Dates ==<" << endl;
+    setlocale(LC_ALL, "");
+    for (const string expires : {
+        "Sun, 06 Nov 1994 09:49:37 GMT",
+        "Sun,  6 Nov 1994 08:50:37 GMT",
+        "Sun, 06 Nov 1994 08:49:37 GMT",
+        "Son, 06 Nov 1994 09:49:37 GMT",
+        "Sun, 06 Noc 1994 09:49:37 GMT",
+        "Sun, 06 Nov 1994 09:49:37",
+        "garbage",
+    })
+    {
+        HttpCache::Entry    entry;
+
+        entry.storedAt = now;
+        entry.headers = {
+            { "date", "Sun, 06 Nov 1994 08:49:37 GMT" },
+            { "expires", expires },
+        };
+        cout << '\t' << expires << ": "
+            << HttpCache::freshness_lifetime(entry) << endl;
+    }// end for expires
+    cout << ">== End Dates ==<" << endl;
+
+    system(("rm -rf '" + dir + "'").c_str());
+
+    return EXIT_SUCCESS;
+}// end int main
@@ -1,10 +1,155 @@
+#include <cstdio>
+#include <fstream>
 #include <map>
 
+#include <poll.h>
+#include <unistd.h>
+#include <signal.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
 #include "../deps.hpp"
 #include "../command.hpp"
 #include "../uri.hpp"
 #include "../http_fetcher.hpp"
 
+// === serve_http =========================================================
+//
+// Minimal loopback HTTP/1.1 server for the native fetcher; serves one
+// connection at a time, keeping each open until the client closes it.
+// Every response reports which connection (and request on it) it was
+// served on.
+//
+//  /length     body delimited by Content-Length
+//  /chunked    chunked body, with a chunk extension and a trailer
+//  /echo       echoes the request method and body
+//  /close      body delimited by closing the connection
+//
+// ========================================================================
+void serve_http(const int listenSock)
+{
+    using namespace std;
+
+    int     nConnections    = 0;
+
+    while (true)
+    {
+        const int   sock        = accept(listenSock, nullptr, nullptr);
+        string      buf         = "";
+        int         nRequests   = 0;
+        bool        open        = true;
+
+        if (sock < 0)
+        {
+            _exit(EXIT_FAILURE);
+        }
+        ++nConnections;
+
+        while (open)
+        {
+            char            data[0x1000];
+            size_t          headEnd;
+            size_t          bodyLen     = 0;
+            const char      *lenHeader;
+
+            // read request head and body
+            while ((headEnd = buf.find("\r\n\r\n")) == string::npos)
+            {
+                const ssize_t   nRead   = read(sock, data, sizeof(data));
+
+                if (nRead <= 0)
+                {
+                    break;
+                }
+                buf.append(data, nRead);
+            }// end while
+            if (string::npos == headEnd)
+            {
+                break;
+            }
+            headEnd += 4;
+
+            if ((lenHeader = strstr(buf.c_str(), "Content-Length: ")))
+            {
+                bodyLen = atol(lenHeader + 16);
+            }
+            while (buf.size() < headEnd + bodyLen)
+            {
+                const ssize_t   nRead   = read(sock, data, sizeof(data));
+
+                if (nRead <= 0)
+                {
+                    break;
+                }
+                buf.append(data, nRead);
+            }// end while
+
+            const string    method  = buf.substr(0, buf.find(' '));
+            const string    path    = buf.substr(
+                                        method.size() + 1,
+                                        buf.find(' ', method.size() + 1)
+                                            - method.size() - 1
+                                    );
+            const string    reqBody = buf.substr(headEnd, bodyLen);
+            const string    tag     = "x-connection: "
+                                        + to_string(nConnections)
+                                        + "\r\nx-request: "
+                                        + to_string(++nRequests) + "\r\n";
+            string          out     = "";
+
+            buf.erase(0, headEnd + bodyLen);
+
+            if ("/length" == path)
+            {
+                out = "HTTP/1.1 200 OK\r\n" + tag
+                    + "Content-Length: 24\r\n\r\n";
+                if ("HEAD" != method)
+                {
+                    out += "<p>length-delimited</p>";
+                    out += "\n";
+                }
+            }
+            else if ("/chunked" == path)
+            {
+                out = "HTTP/1.1 100 Continue\r\n\r\n"
+                    "HTTP/1.1 200 OK\r\n" + tag
+                    + "Transfer-Encoding: chunked\r\n\r\n"
+                    "6;ext=1\r\n<p>chu\r\n"
+                    "e\r\nnked body</p>\n\r\n"
+                    "0\r\nx-trailer: yes\r\n\r\n";
+            }
+            else if ("/echo" == path)
+            {
+                const string    text    = method + " " + reqBody;
+
+                out = "HTTP/1.1 200 OK\r\n" + tag
+                    + "Content-Length: " + to_string(text.size())
+                    + "\r\n\r\n" + text;
+            }
+            else if ("/close" == path)
+            {
+                out = "HTTP/1.1 200 OK\r\n" + tag
+                    + "Connection: close\r\n\r\n<p>closed</p>";
+                open = false;
+            }
+            else
+            {
+                out = "HTTP/1.1 404 Not Found\r\n" + tag
+                    + "Content-Length: 0\r\n\r\n";
+            }
+
+            if (write(sock, out.data(), out.size()) < 0)
+            {
+                break;
+            }
+        }// end while
+
+        close(sock);
+    }// end while
+}// end serve_http
+
 // === main ===============================================================
 //
 // ========================================================================
@@ -28,26 +173,162 @@ int main(const int argc, const char **argv)
     cout << endl;
 
     cout << ">== Start HTTP Headers ==<" << endl;
-    for (const auto& kv : headers)
+    for (const auto field : headers)
     {
-        const auto&     key     = kv.first;
-        const auto&     values  = kv.second;
-
-        cout << '\t' << key << "=";
-
-        for (const auto& val : values)
-        {
-            cout << val << "|";
-        }// end for val
-
-        cout << endl;
-    }// end for kv
+        cout << '\t' << field.name << "=" << field.value << endl;
+    }// end for field
 
     cout << ">== End HTTP Headers ==<" << endl;
     cout << endl;
     cout << ">== Start HTTP Body ==<" << endl;
     cout << string(body.cbegin(), body.cend()) << endl;
     cout << ">== End HTTP Body ==<" << endl;
+    cout << endl;
+
+    // persistent handler: requests should be served by the same process
+    {
+        const string    fname   = "/tmp/w3m-test-http-fetcher.html";
+        HttpFetcher     coproc(
+                            "./tests/coprocess_handler.sh",
+                            "W3M_URL",
+                            {},
+                            HttpFetcher::Mode::coprocess
+                        );
+
+        ofstream(fname) << "<p>Hello from coprocess_handler.sh</p>" << endl;
+
+        cout << ">== Start Coprocess Requests ==<" << endl;
+        for (int i = 0; i < 3; ++i)
+        {
+            body = coproc.fetch_url(status, headers, Uri("file://" + fname));
+
+            cout << "\tCode: " << status.code;
+            for (const string key : {
+                "content-type",
+                "x-w3m-coprocess-pid",
+                "x-w3m-coprocess-requests"
+            })
+            {
+                cout << "; " << key << "="
+                    << headers.get(key);
+            }// end for key
+            cout << "; body=" << string(body.cbegin(), body.cend());
+        }// end for i
+        cout << ">== End Coprocess Requests ==<" << endl;
+
+        remove(fname.c_str());
+    }
+
+    // native client against a loopback server: connections should be kept
+    // alive between requests, unless the server closes them
+    {
+        const int           listenSock  = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in  addr        = {};
+        socklen_t           addrLen     = sizeof(addr);
+        pid_t               server;
+
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listenSock, (struct sockaddr*)&addr, sizeof(addr));
+        listen(listenSock, 4);
+        getsockname(listenSock, (struct sockaddr*)&addr, &addrLen);
+
+        if (0 == (server = fork()))
+        {
+            serve_http(listenSock);
+            _exit(EXIT_SUCCESS);
+        }
+        close(listenSock);
+
+        const string        base        = "http://127.0.0.1:"
+                                            + to_string(ntohs(addr.sin_port));
+        HttpFetcher         native(HttpFetcher::NATIVE_HANDLER, "W3M_URL");
+        const string        post        = "a=1&b=2";
+        const struct
+        {
+            string      path;
+            string      method;
+            string      input;
+        }                   requests[]  = {
+                                { "/length", "GET", "" },
+                                { "/chunked", "GET", "" },
+                                { "/echo", "POST", post },
+                                { "/length", "HEAD", "" },
+                                { "/close", "GET", "" },
+                                { "/length", "GET", "" },
+                                { "/missing", "GET", "" },
+                            };
+
+        cout << ">== Start Native Requests ==<" << endl;
+        // a host whose first address (i.e. ::1) is refused is reached on
+        // the next; the server closes the connection, as it only serves
+        // one at a time
+        body = native.fetch_url(
+            status,
+            headers,
+            Uri(
+                "http://localhost:" + to_string(ntohs(addr.sin_port))
+                + "/close"
+            ),
+            {},
+            { { "W3M_REQUEST_METHOD", "GET" } }
+        );
+        cout << "\tGET localhost/close: Code: " << status.code
+            << "; body=" << string(body.cbegin(), body.cend()) << endl;
+
+        for (const auto& req : requests)
+        {
+            body = native.fetch_url(
+                status,
+                headers,
+                Uri(base + req.path),
+                HttpFetcher::data_container(req.input.cbegin(), req.input.cend()),
+                { { "W3M_REQUEST_METHOD", req.method } }
+            );
+
+            cout << '\t' << req.method << ' ' << req.path
+                << ": Code: " << status.code;
+            for (const string key : { "x-connection", "x-request" })
+            {
+                cout << "; " << key << "="
+                    << headers.get(key);
+            }// end for key
+            cout << "; body=" << string(body.cbegin(), body.cend()) << endl;
+        }// end for req
+        cout << ">== End Native Requests ==<" << endl;
+
+        kill(server, SIGTERM);
+        waitpid(server, nullptr, 0);
+    }
+
+    // a handler that writes as fast as it's read is read a bounded amount
+    // at a time, rather than in one update()
+    {
+        HttpFetcher     fast(
+                            "printf 'HTTP/1.1 200 OK\\n\\n'; "
+                            "head -c 4194304 /dev/zero",
+                            "W3M_URL"
+                        );
+        auto            transfer    = fast.start_fetch(Uri("file:///zero"));
+        size_t          nUpdates    = 0;
+        size_t          maxRead     = 0;
+
+        cout << ">== Start Bounded Updates ==<" << endl;
+        while (not transfer->finished())
+        {
+            struct pollfd   pfd     = { transfer->fd(), POLLIN, 0 };
+            const size_t    before  = transfer->bytes_received();
+
+            poll(&pfd, 1, -1);
+            transfer->update();
+            maxRead = std::max(maxRead, transfer->bytes_received() - before);
+            ++nUpdates;
+        }// end while
+        cout << "\tbody: " << transfer->body().size()
+            << "; several updates: " << (nUpdates > 1)
+            << "; at most 512 KiB each: " << (maxRead <= 0x80000) << endl;
+        cout << ">== End Bounded Updates ==<" << endl;
+    }
 
     return EXIT_SUCCESS;
 }// end int main
@@ -0,0 +1,65 @@
+#include <iostream>
+
+#include "../deps.hpp"
+#include "../http_headers.hpp"
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    HttpHeaders     headers;
+    size_t          length      = 0;
+
+    for (const string line : {
+        "Content-Type: text/html; charset=\"UTF-8\"; q=\"a;b\"\r",
+        "Content-Length:  1234 ",
+        "Location: /next?a=1",
+        "Set-Cookie: a=1",
+        "set-cookie: b=2",
+        "no colon here",
+        ": no name",
+    })
+    {
+        cout << "\tadd \"" << line << "\": " << headers.add_line(line)
+            << endl;
+    }// end for line
+
+    cout << ">== Start Fields ==<" << endl;
+    for (const auto field : headers)
+    {
+        cout << '\t' << field.name << "=" << field.value << '|' << endl;
+    }// end for field
+    cout << ">== End Fields ==<" << endl;
+
+    cout << ">== Start Lookup ==<" << endl;
+    cout << "\tcontent type: " << headers.content_type() << endl;
+    cout << "\tcharset: " << headers.charset() << endl;
+    cout << "\tquoted param: " << headers.param("CONTENT-TYPE", "q") << endl;
+    cout << "\tmissing param: \"" << headers.param("content-type", "x")
+        << '"' << endl;
+    cout << "\tlocation: " << headers.location() << endl;
+    cout << "\tcontent length: " << headers.content_length(length)
+        << ' ' << length << endl;
+    cout << "\tset-cookie count: " << headers.count("Set-Cookie")
+        << "; last: " << headers.get("SET-COOKIE") << endl;
+    cout << "\tmissing: \"" << headers.get("etag") << '"' << endl;
+    cout << ">== End Lookup ==<" << endl;
+
+    cout << ">== Start Update ==<" << endl;
+    headers.set("set-cookie", "c=3");
+    cout << "\tset-cookie after set: " << headers.count("set-cookie")
+        << ' ' << headers.get("set-cookie") << endl;
+    cout << "\terased: " << headers.erase("content-length")
+        << "; content length: " << headers.content_length(length) << endl;
+    headers.add("Content-Length", "12x");
+    cout << "\tinvalid content length: " << headers.content_length(length)
+        << endl;
+    headers.clear();
+    cout << "\tcleared: " << headers.empty() << endl;
+    cout << ">== End Update ==<" << endl;
+
+    return EXIT_SUCCESS;
+}// end int main
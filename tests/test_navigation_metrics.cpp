@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "../deps.hpp"
+#include "../uri.hpp"
+#include "../http_fetcher.hpp"
+#include "../navigation_metrics.hpp"
+
+typedef NavigationMetrics::clock_type       clock_type;
+
+// === count_lines ========================================================
+//
+// ========================================================================
+auto count_lines(const string& path)
+    -> size_t
+{
+    std::ifstream   file(path);
+    string          line    = "";
+    size_t          count   = 0;
+
+    while (std::getline(file, line))
+    {
+        ++count;
+    }// end while
+
+    return count;
+}// end count_lines
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const string                    path        =
+                                        "/tmp/w3m-test-navigation-metrics";
+    NavigationMetrics::Record       rec         = {};
+
+    rec.time = 1700000000;
+    rec.url = "http://example.com/a \"quoted\"\tpath\\";
+    rec.source = "network";
+    rec.status = 200;
+    rec.redirects = 1;
+    rec.bytes = 51234;
+    rec.wireBytes = 12000;
+    rec.nodes = 812;
+    rec.lines = 90;
+    rec.spawnMs = 2.125;
+    rec.ttfbMs = 40.25;
+    rec.transferMs = 12;
+    rec.parseMs = 8.5;
+    rec.layoutMs = 5;
+    rec.paintMs = 1;
+    rec.totalMs = 70.5;
+
+    cout << ">== Start Format ==<" << endl;
+    cout << '\t' << NavigationMetrics::format(rec) << endl;
+    cout << '\t' << NavigationMetrics::to_json(rec) << endl;
+    cout << ">== End Format ==<" << endl;
+
+    cout << ">== Start Add ==<" << endl;
+    {
+        NavigationMetrics       metrics({ path });
+        NavigationMetrics       unwritten;
+        NavigationMetrics       unwritable({ "/nonexistent/dir/metrics" });
+
+        remove(path.c_str());
+        cout << "\tlast before add: " << (not metrics.last()) << endl;
+        for (int i = 0; i < 3; ++i)
+        {
+            rec.status = 200 + i;
+            metrics.add(rec);
+        }// end for i
+        cout << "\tcount: " << metrics.count() << endl;
+        cout << "\tlast status: " << metrics.last()->status << endl;
+        cout << "\tlines in file: " << count_lines(path) << endl;
+        cout << "\tno file: " << unwritten.add(rec) << endl;
+        cout << "\tunwritable file: " << unwritable.add(rec) << endl;
+        remove(path.c_str());
+    }
+    cout << ">== End Add ==<" << endl;
+
+    cout << ">== Start Elapsed ==<" << endl;
+    {
+        const auto      start   = clock_type::now();
+        const auto      end     = start + std::chrono::microseconds(2500);
+
+        cout << "\tin order: " << NavigationMetrics::elapsed_ms(start, end)
+            << endl;
+        cout << "\tout of order: "
+            << NavigationMetrics::elapsed_ms(end, start) << endl;
+        cout << "\tunset: "
+            << NavigationMetrics::elapsed_ms(start, clock_type::time_point())
+            << endl;
+    }
+    cout << ">== End Elapsed ==<" << endl;
+
+    // each point on a transfer's timeline is reached, in order
+    cout << ">== Start Transfer Timing ==<" << endl;
+    {
+        HttpFetcher     fetcher(
+                            "printf 'HTTP/1.1 200 OK\\n\\n'; sleep 0.05; "
+                                "printf 'hello'",
+                            "W3M_URL"
+                        );
+        auto            transfer    = fetcher.start_fetch(
+                                        Uri("http://example.com")
+                                    );
+
+        transfer->wait();
+
+        const auto&     timing      = transfer->timing();
+        const clock_type::time_point    points[]    = {
+            timing.started,
+            timing.spawned,
+            timing.firstByte,
+            timing.headersReady,
+            timing.finished,
+        };
+        bool            ordered     = true;
+
+        for (size_t i = 0; i < sizeof(points) / sizeof(*points); ++i)
+        {
+            ordered = ordered and (clock_type::time_point() != points[i])
+                and ((not i) or (points[i - 1] <= points[i]));
+        }// end for i
+
+        cout << "\tordered: " << ordered << endl;
+        cout << "\ttransfer >= 50ms: "
+            << (NavigationMetrics::elapsed_ms(timing.headersReady,
+                    timing.finished) >= 50)
+            << endl;
+    }
+    cout << ">== End Transfer Timing ==<" << endl;
+
+    return EXIT_SUCCESS;
+}// end int main
@@ -0,0 +1,106 @@
+#include <ctime>
+#include <iostream>
+
+#include "../deps.hpp"
+#include "../uri.hpp"
+#include "../http_fetcher.hpp"
+#include "../fetch_scheduler.hpp"
+#include "../prefetcher.hpp"
+
+// === print_stats ========================================================
+//
+// ========================================================================
+void print_stats(const Prefetcher& prefetcher)
+{
+    const auto&     stats   = prefetcher.stats();
+
+    std::cout << "\tstarted=" << stats.started
+        << "; hits=" << stats.hits
+        << "; misses=" << stats.misses
+        << "; wasted=" << stats.wasted
+        << "; aborted=" << stats.aborted
+        << "; bytes=" << stats.bytes << std::endl;
+}// end print_stats
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    HttpFetcher     fetcher(
+                        "printf 'content-type: text/plain\\n\\n'; "
+                            "echo \"${W3M_URL}\"",
+                        "W3M_URL"
+                    );
+    FetchScheduler  scheduler({ 4, 4 });
+    Prefetcher      prefetcher({ 300, 0, 2, 0x1000, { "http" }, 60 });
+    const time_t    now         = time(nullptr);
+
+    cout << ">== Start Accepts ==<" << endl;
+    for (const string url : {
+        "http://example.com/a",
+        "http://example.com/b",
+        "http://example.com/c",
+        "http://example.com/a",
+        "ftp://example.com/d",
+    })
+    {
+        const bool      accepted    = prefetcher.accepts(url);
+
+        cout << '\t' << url << ": " << (accepted ? "accepted" : "refused")
+            << endl;
+        if (accepted)
+        {
+            prefetcher.add(
+                url,
+                scheduler.submit(
+                    FetchScheduler::Priority::prefetch,
+                    fetcher,
+                    url
+                )
+            );
+        }
+    }// end for url
+    cout << ">== End Accepts ==<" << endl;
+
+    // let the prefetches complete
+    while (prefetcher.running())
+    {
+        scheduler.update();
+        prefetcher.update(now);
+    }// end while
+
+    cout << ">== Start Take ==<" << endl;
+    for (const string url : {
+        "http://example.com/a#frag",
+        "http://example.com/a",
+        "http://example.com/c",
+    })
+    {
+        const auto      job         = prefetcher.take(url);
+
+        cout << '\t' << url << ": ";
+        if (job)
+        {
+            const auto&     body        = job->transfer->body();
+
+            cout << string(body.cbegin(), body.cend());
+        }
+        else
+        {
+            cout << "miss" << endl;
+        }
+    }// end for url
+    print_stats(prefetcher);
+    cout << ">== End Take ==<" << endl;
+
+    // unused prefetches expire
+    cout << ">== Start Expiry ==<" << endl;
+    prefetcher.update(now + 120);
+    print_stats(prefetcher);
+    cout << ">== End Expiry ==<" << endl;
+
+    return EXIT_SUCCESS;
+}// end int main
@@ -0,0 +1,85 @@
+#include <iostream>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "../deps.hpp"
+#include "../command.hpp"
+#include "../temp_file.hpp"
+
+// === main ===============================================================
+//
+// ========================================================================
+int main(const int argc, const char **argv)
+{
+    using namespace std;
+
+    const string    text    = "contents of the temp file\n";
+
+    cout << ">== Start Memory ==<" << endl;
+    {
+        TempFile        file        = TempFile::in_memory("test_temp_file");
+
+        if (not file.is_open())
+        {
+            cout << "\tin-memory files not supported" << endl;
+        }
+        else
+        {
+            const int       fd          = file.fd();
+            string          output;
+
+            cout << "\tpath is fd: "
+                << (file.path() == "/proc/self/fd/" + to_string(fd))
+                << endl;
+            file.write(text.data(), text.size());
+            file.finish();
+            cout << "\twrite after seal fails: "
+                << (not file.write("x", 1)) << endl;
+
+            // a spawned process reads it through its path
+            file.set_inheritable(true);
+            {
+                auto    sproc   = Command("cat " + file.path())
+                                    .set_stdout_piped(true)
+                                    .spawn();
+
+                file.set_inheritable(false);
+                file.close();
+                getline(sproc.stdout(), output);
+                sproc.wait();
+            }
+            cout << "\thandler read: \"" << output << '"' << endl;
+            cout << "\tclosed: " << (not file.is_open())
+                << "; descriptor released: " << (fcntl(fd, F_GETFD) < 0)
+                << endl;
+        }
+    }
+    cout << ">== End Memory ==<" << endl;
+
+    cout << ">== Start Disk ==<" << endl;
+    {
+        const string    path    = "/tmp/w3m_test_temp_file."
+                                    + to_string(getpid());
+        struct stat     st;
+
+        {
+            TempFile        file(path);
+            TempFile        moved;
+
+            file.write(text.data(), text.size());
+            file.close();
+            moved = std::move(file);
+            cout << "\tsize: "
+                << ((0 == stat(path.c_str(), &st)) ? st.st_size : -1)
+                << "; moved path kept: " << (moved.path() == path)
+                << endl;
+        }
+        cout << "\tremoved on destruction: "
+            << (0 != stat(path.c_str(), &st)) << endl;
+    }
+    cout << ">== End Disk ==<" << endl;
+
+    return EXIT_SUCCESS;
+}// end int main
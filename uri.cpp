@@ -148,7 +148,7 @@ auto Uri::str(void) const
         out += host;
         if (not port.empty())
         {
-            out += port;
+            out += ":" + port;
         }
     }
 
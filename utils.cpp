@@ -8,6 +8,7 @@
 #include <locale>
 #include <codecvt>
 
+#include "byte_set.hpp"
 #include "utils.hpp"
 
 namespace utils
@@ -48,9 +49,9 @@ std::string         read_token_until(
     using namespace std;
 
     string      output                  = "";
-    set<char>   avoidSet(avoid.cbegin(), avoid.cend());
+    ByteSet     avoidSet(avoid.c_str());
 
-    while (ins.peek() != EOF and not avoidSet.count(ins.peek()))
+    while (ins.peek() != EOF and not avoidSet.contains(ins.peek()))
     {
         output += ins.get();
     }// end while (ins && !avoidSet[ins.peek()])
@@ -56,6 +56,43 @@ auto    Viewer::buffer_size(void) const
     return m_doc->buffer().size();
 }// end Viewer::buffer_size
 
+// return: urls of the first (up to) maxCount distinct links on screen, top
+//  to bottom
+auto    Viewer::visible_urls(size_t maxCount) const
+    -> std::vector<string>
+{
+    std::vector<string>     urls        = {};
+    const auto&             buf         = m_doc->buffer();
+    const size_t            end         = std::min(
+                                            buf.size(),
+                                            m_currLine + LINES - 1
+                                        );
+
+    for (size_t i = m_currLine; (i < end) and (urls.size() < maxCount); ++i)
+    {
+        for (const auto& node : buf[i])
+        {
+            if (not node.link_ref())
+            {
+                continue;
+            }
+
+            const string&   url     = m_doc->links().at(node.link_ref())
+                                        .get_url();
+
+            if (
+                (urls.size() < maxCount)
+                and (std::find(urls.cbegin(), urls.cend(), url) == urls.cend())
+            )
+            {
+                urls.push_back(url);
+            }
+        }// end for node
+    }// end for i
+
+    return urls;
+}// end Viewer::visible_urls
+
 auto    Viewer::curr_form_input(void) const
     -> const Document::FormInput*
 {
@@ -145,6 +182,41 @@ void    Viewer::set_start_point(size_t lnum, size_t cnum)
     set_start_col(cnum);
 }// end Viewer::set_start_point
 
+// Swaps in a new document (i.e. a more complete rendering of the same page)
+// while keeping the scroll and cursor position, as far as the new document
+// allows.
+void    Viewer::set_document(Document *doc)
+{
+    size_t      nLines;
+
+    m_doc = doc;
+
+    if (not m_doc)
+    {
+        return;
+    }
+
+    nLines = m_doc->buffer().size();
+
+    if (m_currCursLine >= nLines)
+    {
+        m_currCursLine = nLines ? nLines - 1 : 0;
+    }
+    if (m_currLine > m_currCursLine)
+    {
+        m_currLine = m_currCursLine;
+    }
+
+    m_bufLineIter = m_doc->buffer().begin();
+    if (nLines)
+    {
+        m_bufNodeIter = m_bufLineIter->begin();
+    }
+    m_isSinglePage = (nLines < size_t(LINES));
+
+    redraw();
+}// end Viewer::set_document
+
 void    Viewer::refresh(bool retouch)
 {
     size_t                  colDiff         = m_currCol;
@@ -461,7 +533,13 @@ void    Viewer::disp_status(const string& str)
     }
 
     refresh();
-    m_statusWin = subwin(stdscr, 1, COLS, LINES - 1, 0);
+
+    // status may be redrawn repeatedly (i.e. fetch progress); reuse the
+    // existing window rather than leaking a new one on every call
+    if (not m_statusWin)
+    {
+        m_statusWin = subwin(stdscr, 1, COLS, LINES - 1, 0);
+    }
     mvwaddnstr(m_statusWin, 0, 0, status.c_str(), COLS);
     wrefresh(m_statusWin);
 }// end disp_status
@@ -64,6 +64,8 @@ class   Viewer
             -> const Document::FormInput*;
         auto    curr_form(void) const
             -> const Document::Form*;
+        auto    visible_urls(size_t maxCount) const
+            -> std::vector<string>;
 
         // --- public mutators --------------------------------------------
         auto    operator=(const Viewer& other)
@@ -73,6 +75,7 @@ class   Viewer
         void    set_start_line(size_t lnum);
         void    set_start_col(size_t cnum);
         void    set_start_point(size_t lnum, size_t cnum);
+        void    set_document(Document *doc);
         void    refresh(bool retouch = false);
         void    redraw(void);
         auto    goto_section(const string& id)